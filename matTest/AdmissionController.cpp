@@ -0,0 +1,120 @@
+#include "AdmissionController.h"
+#include <chrono>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+AdmissionController::AdmissionController(unsigned long long budget_bytes) :
+	budget_bytes(budget_bytes), used_bytes(0), running(0), next_ticket(0) {
+	for (int i = 0; i < PRIORITY_CLASSES; i++) {
+		AdmissionStats empty = { 0, 0, 0, 0 };
+		this->class_stats[i] = empty;
+	}
+}
+
+bool AdmissionController::may_start(JobPriority priority, unsigned long long ticket, unsigned long long bytes) const {
+	// first of its class, and no waiting class of higher priority
+	if (this->waiting[priority].front() != ticket) {
+		return false;
+	}
+	for (int i = 0; i < priority; i++) {
+		if (!this->waiting[i].empty()) {
+			return false;
+		}
+	}
+	return this->running == 0 || this->used_bytes + bytes <= this->budget_bytes;
+}
+
+float AdmissionController::admit(JobPriority priority, unsigned long long bytes) {
+	typedef chrono::steady_clock steady_clock;
+	typedef chrono::duration<float, milli> mil;
+	steady_clock::time_point asked = steady_clock::now();
+	unique_lock<mutex> lock(this->admission_mutex);
+	unsigned long long ticket = this->next_ticket++;
+	this->waiting[priority].push_back(ticket);
+	this->class_stats[priority].waiting++;
+	while (!may_start(priority, ticket, bytes)) {
+		this->admission_changed.wait(lock);
+	}
+	this->waiting[priority].pop_front();
+	this->used_bytes += bytes;
+	this->running++;
+	float wait_ms = mil(steady_clock::now() - asked).count();
+	AdmissionStats& stats = this->class_stats[priority];
+	stats.waiting--;
+	stats.admitted++;
+	stats.wait_ms_total += wait_ms;
+	stats.wait_ms_max = max(stats.wait_ms_max, wait_ms);
+	lock.unlock();
+	// the next of this class or of a lower class may fit as well
+	this->admission_changed.notify_all();
+	return wait_ms;
+}
+
+void AdmissionController::release(unsigned long long bytes) {
+	{
+		lock_guard<mutex> lock(this->admission_mutex);
+		this->used_bytes -= min(bytes, this->used_bytes);
+		this->running--;
+	}
+	this->admission_changed.notify_all();
+}
+
+void AdmissionController::set_budget(unsigned long long budget_bytes) {
+	{
+		lock_guard<mutex> lock(this->admission_mutex);
+		this->budget_bytes = budget_bytes;
+	}
+	this->admission_changed.notify_all();
+}
+
+unsigned long long AdmissionController::budget() const {
+	lock_guard<mutex> lock(this->admission_mutex);
+	return this->budget_bytes;
+}
+
+unsigned long long AdmissionController::in_use() const {
+	lock_guard<mutex> lock(this->admission_mutex);
+	return this->used_bytes;
+}
+
+AdmissionStats AdmissionController::stats(JobPriority priority) const {
+	lock_guard<mutex> lock(this->admission_mutex);
+	return this->class_stats[priority];
+}
+
+unsigned long long AdmissionController::physical_memory() {
+#ifdef _WIN32
+	MEMORYSTATUSEX status;
+	status.dwLength = sizeof(status);
+	return GlobalMemoryStatusEx(&status) ? status.ullTotalPhys : 0;
+#else
+	long pages = sysconf(_SC_PHYS_PAGES);
+	long page_size = sysconf(_SC_PAGE_SIZE);
+	return pages > 0 && page_size > 0 ? (unsigned long long)pages * page_size : 0;
+#endif
+}
+
+AdmissionTicket::AdmissionTicket(AdmissionController& controller, JobPriority priority, unsigned long long bytes) :
+	controller(controller), bytes(bytes), wait_ms(0) {
+	this->wait_ms = controller.admit(priority, bytes);
+}
+
+AdmissionTicket::~AdmissionTicket() {
+	this->controller.release(this->bytes);
+}
+
+float AdmissionTicket::waited_ms() const {
+	return this->wait_ms;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// class of a conversion, interactive conversions are admitted before any batch conversion waiting
+enum JobPriority {
+	PRIORITY_INTERACTIVE,
+	PRIORITY_BATCH,
+	PRIORITY_CLASSES
+};
+
+// admissions of one priority class so far
+struct AdmissionStats {
+	size_t admitted;
+	// jobs of the class waiting for memory right now
+	size_t waiting;
+	// time from asking to being admitted
+	float wait_ms_total;
+	float wait_ms_max;
+};
+
+#pragma once
+class AdmissionController
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function creates an admission control for jobs running at the same time
+	*
+	* Input:
+	*		budget_bytes		unsigned long long	estimated memory all admitted jobs together may use
+	*
+	* Jobs of a class are admitted in the order they asked. A job larger than the whole budget is admitted once nothing else runs, so
+	* it runs alone instead of never.
+	*
+	*************************************************************************************************************************************************************************/
+	AdmissionController(unsigned long long);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function waits until a job fits into the budget
+	*
+	* Input:
+	*		priority			JobPriority			class of the job
+	*		bytes				unsigned long long	estimated memory of the job, given back with release
+	* Output:
+	*		res					float				time waited in ms
+	*
+	*************************************************************************************************************************************************************************/
+	float admit(JobPriority, unsigned long long);
+	void release(unsigned long long);
+
+	// takes effect for the jobs waiting as well
+	void set_budget(unsigned long long);
+	unsigned long long budget() const;
+	unsigned long long in_use() const;
+	AdmissionStats stats(JobPriority) const;
+
+	// installed memory of the machine, 0 if unknown
+	static unsigned long long physical_memory();
+
+private:
+	AdmissionController(const AdmissionController&);
+	AdmissionController& operator=(const AdmissionController&);
+
+	bool may_start(JobPriority, unsigned long long, unsigned long long) const;
+
+	mutable mutex admission_mutex;
+	condition_variable admission_changed;
+	unsigned long long budget_bytes;
+	unsigned long long used_bytes;
+	size_t running;
+	unsigned long long next_ticket;
+	// tickets of the jobs waiting per class, in the order they asked
+	deque<unsigned long long> waiting[PRIORITY_CLASSES];
+	AdmissionStats class_stats[PRIORITY_CLASSES];
+};
+
+#pragma once
+// admission held for the lifetime of the ticket
+class AdmissionTicket
+{
+
+public:
+	AdmissionTicket(AdmissionController&, JobPriority, unsigned long long);
+	~AdmissionTicket();
+
+	float waited_ms() const;
+
+private:
+	AdmissionTicket(const AdmissionTicket&);
+	AdmissionTicket& operator=(const AdmissionTicket&);
+
+	AdmissionController& controller;
+	unsigned long long bytes;
+	float wait_ms;
+};
@@ -0,0 +1,500 @@
+#include "ArrowFileWriter.h"
+#include "ConversionLog.h"
+#include <memory>
+#include <algorithm>
+#include <cstring>
+#include <codecvt>
+#include <locale>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+// "ARROW1" and padding to 8 bytes
+static const char ARROW_MAGIC[8] = { 'A', 'R', 'R', 'O', 'W', '1', 0, 0 };
+// MetadataVersion V5
+static const short ARROW_METADATA_VERSION = 4;
+
+// ids of the flatbuffer union members used here (Schema.fbs, Message.fbs)
+static const unsigned char TYPE_INT = 2;
+static const unsigned char TYPE_FLOATING_POINT = 3;
+static const unsigned char TYPE_UTF8 = 5;
+static const unsigned char HEADER_SCHEMA = 1;
+static const unsigned char HEADER_DICTIONARY_BATCH = 2;
+static const unsigned char HEADER_RECORD_BATCH = 3;
+static const short PRECISION_DOUBLE = 2;
+
+static string to_utf8(const wstring& text) {
+	try {
+		return wstring_convert<codecvt_utf8<wchar_t>>().to_bytes(text);
+	}
+	catch (const range_error&) {
+		return string(text.begin(), text.end());
+	}
+}
+
+/*************************************************************************************************************************************************************************
+* Flatbuffer object built in memory, the metadata of Arrow messages
+*
+* The buffer is laid out parent first, children behind their parent, so all offsets point forward like flatbuffers requires.
+* Tables get all their fields written (no defaults left out), which every reader takes.
+*************************************************************************************************************************************************************************/
+struct FlatObject;
+typedef shared_ptr<FlatObject> FlatRef;
+
+struct FlatField {
+	bool present;
+	// inline bytes of a scalar, or a child object written behind the table
+	string scalar;
+	size_t align;
+	FlatRef child;
+
+	FlatField() : present(false), align(1) {}
+};
+
+struct FlatObject {
+	enum Kind { TABLE, RAW_VECTOR, OBJECT_VECTOR, STRING } kind;
+	vector<FlatField> fields;
+	// RAW_VECTOR: elements (scalars or structs), STRING: text
+	string bytes;
+	size_t count;
+	size_t align;
+	vector<FlatRef> children;
+
+	explicit FlatObject(Kind kind) : kind(kind), count(0), align(1) {}
+};
+
+static FlatRef flat_table() {
+	return make_shared<FlatObject>(FlatObject::TABLE);
+}
+
+template <class T>
+static void flat_scalar(const FlatRef& table, size_t id, T value) {
+	if (table->fields.size() <= id) {
+		table->fields.resize(id + 1);
+	}
+	table->fields[id].present = true;
+	table->fields[id].scalar.assign((const char*)&value, sizeof(T));
+	table->fields[id].align = sizeof(T);
+}
+
+static void flat_child(const FlatRef& table, size_t id, const FlatRef& child) {
+	if (table->fields.size() <= id) {
+		table->fields.resize(id + 1);
+	}
+	table->fields[id].present = true;
+	table->fields[id].align = 4;
+	table->fields[id].child = child;
+}
+
+static FlatRef flat_string(const string& text) {
+	FlatRef object = make_shared<FlatObject>(FlatObject::STRING);
+	object->bytes = text;
+	return object;
+}
+
+// vector of scalars or structs, bytes holds count elements of the given alignment
+static FlatRef flat_raw_vector(const string& bytes, size_t count, size_t align) {
+	FlatRef object = make_shared<FlatObject>(FlatObject::RAW_VECTOR);
+	object->bytes = bytes;
+	object->count = count;
+	object->align = align;
+	return object;
+}
+
+static FlatRef flat_vector(const vector<FlatRef>& children) {
+	FlatRef object = make_shared<FlatObject>(FlatObject::OBJECT_VECTOR);
+	object->children = children;
+	return object;
+}
+
+template <class T>
+static void put_value(string& buffer, size_t position, T value) {
+	memcpy(&buffer[position], &value, sizeof(T));
+}
+
+static void pad_to(string& buffer, size_t align) {
+	while (buffer.size() % align != 0) {
+		buffer += '\0';
+	}
+}
+
+// writes the object and its children to the end of buffer, returns its position
+static size_t flat_write(const FlatObject& object, string& buffer) {
+	if (object.kind == FlatObject::STRING) {
+		pad_to(buffer, 4);
+		size_t position = buffer.size();
+		buffer.append(4, '\0');
+		put_value(buffer, position, (unsigned int)object.bytes.size());
+		buffer += object.bytes;
+		buffer += '\0';
+		return position;
+	}
+	if (object.kind == FlatObject::RAW_VECTOR) {
+		// the length comes right before the elements, which are aligned
+		while (buffer.size() % 4 != 0 || (buffer.size() + 4) % object.align != 0) {
+			buffer += '\0';
+		}
+		size_t position = buffer.size();
+		buffer.append(4, '\0');
+		put_value(buffer, position, (unsigned int)object.count);
+		buffer += object.bytes;
+		return position;
+	}
+	if (object.kind == FlatObject::OBJECT_VECTOR) {
+		pad_to(buffer, 4);
+		size_t position = buffer.size();
+		buffer.append(4 + 4 * object.children.size(), '\0');
+		put_value(buffer, position, (unsigned int)object.children.size());
+		for (size_t i = 0; i < object.children.size(); i++) {
+			size_t slot = position + 4 + 4 * i;
+			size_t child = flat_write(*object.children[i], buffer);
+			put_value(buffer, slot, (unsigned int)(child - slot));
+		}
+		return position;
+	}
+
+	// table: vtable, then the table starting with the offset to its vtable, larger fields first
+	vector<size_t> order;
+	for (size_t id = 0; id < object.fields.size(); id++) {
+		if (object.fields[id].present) {
+			order.push_back(id);
+		}
+	}
+	stable_sort(order.begin(), order.end(), [&object](size_t a, size_t b) {
+		return object.fields[a].align > object.fields[b].align;
+	});
+	vector<unsigned short> field_offsets(object.fields.size(), 0);
+	size_t table_size = 4;
+	for (size_t id : order) {
+		size_t size = object.fields[id].child ? 4 : object.fields[id].scalar.size();
+		table_size = (table_size + object.fields[id].align - 1) / object.fields[id].align * object.fields[id].align;
+		field_offsets[id] = (unsigned short)table_size;
+		table_size += size;
+	}
+	pad_to(buffer, 2);
+	size_t vtable = buffer.size();
+	buffer.append(4 + 2 * object.fields.size(), '\0');
+	put_value(buffer, vtable, (unsigned short)(4 + 2 * object.fields.size()));
+	put_value(buffer, vtable + 2, (unsigned short)table_size);
+	for (size_t id = 0; id < object.fields.size(); id++) {
+		put_value(buffer, vtable + 4 + 2 * id, field_offsets[id]);
+	}
+	pad_to(buffer, 8);
+	size_t table = buffer.size();
+	buffer.append(table_size, '\0');
+	// the vtable is before the table, its offset is subtracted from the table position
+	put_value(buffer, table, (int)(table - vtable));
+	for (size_t id : order) {
+		if (!object.fields[id].child) {
+			memcpy(&buffer[table + field_offsets[id]], object.fields[id].scalar.data(), object.fields[id].scalar.size());
+		}
+	}
+	for (size_t id : order) {
+		if (object.fields[id].child) {
+			size_t slot = table + field_offsets[id];
+			size_t child = flat_write(*object.fields[id].child, buffer);
+			put_value(buffer, slot, (unsigned int)(child - slot));
+		}
+	}
+	return table;
+}
+
+// flatbuffer with root, padded to 8 bytes
+static string flat_finish(const FlatRef& root) {
+	string buffer(4, '\0');
+	size_t table = flat_write(*root, buffer);
+	put_value(buffer, 0, (unsigned int)table);
+	pad_to(buffer, 8);
+	return buffer;
+}
+
+static FlatRef int_type(int bit_width) {
+	FlatRef type = flat_table();
+	flat_scalar(type, 0, bit_width);
+	flat_scalar(type, 1, (unsigned char)1);
+	return type;
+}
+
+static FlatRef schema_table(const vector<ArrowColumn>& columns) {
+	vector<FlatRef> fields;
+	for (size_t i = 0; i < columns.size(); i++) {
+		FlatRef field = flat_table();
+		flat_child(field, 0, flat_string(columns[i].name));
+		flat_scalar(field, 1, (unsigned char)1);
+		if (columns[i].type == ARROW_INT64) {
+			flat_scalar(field, 2, TYPE_INT);
+			flat_child(field, 3, int_type(64));
+		}
+		else if (columns[i].type == ARROW_FLOAT64) {
+			FlatRef type = flat_table();
+			flat_scalar(type, 0, PRECISION_DOUBLE);
+			flat_scalar(field, 2, TYPE_FLOATING_POINT);
+			flat_child(field, 3, type);
+		}
+		else {
+			// values are utf8, the column holds int32 indices into dictionary i
+			flat_scalar(field, 2, TYPE_UTF8);
+			flat_child(field, 3, flat_table());
+			FlatRef dictionary = flat_table();
+			flat_scalar(dictionary, 0, (long long)i);
+			flat_child(dictionary, 1, int_type(32));
+			flat_scalar(dictionary, 2, (unsigned char)0);
+			flat_scalar(dictionary, 3, (short)0);
+			flat_child(field, 4, dictionary);
+		}
+		// readers expect the children vector even if it is empty
+		flat_child(field, 5, flat_vector(vector<FlatRef>()));
+		fields.push_back(field);
+	}
+	FlatRef schema = flat_table();
+	flat_scalar(schema, 0, (short)0);
+	flat_child(schema, 1, flat_vector(fields));
+	return schema;
+}
+
+static FlatRef message_table(unsigned char header_type, const FlatRef& header, unsigned long long body_length) {
+	FlatRef message = flat_table();
+	flat_scalar(message, 0, ARROW_METADATA_VERSION);
+	flat_scalar(message, 1, header_type);
+	flat_child(message, 2, header);
+	flat_scalar(message, 3, (long long)body_length);
+	return message;
+}
+
+// body of a record batch: buffers one after another, each padded to 8 bytes, and their nodes and buffer entries
+struct BatchBody {
+	string body;
+	string nodes;
+	size_t node_count;
+	string buffers;
+	size_t buffer_count;
+
+	BatchBody() : node_count(0), buffer_count(0) {}
+
+	void add_node(size_t length, size_t null_count) {
+		long long values[2] = { (long long)length, (long long)null_count };
+		this->nodes.append((const char*)values, sizeof(values));
+		this->node_count++;
+	}
+
+	void add_buffer(const char *data, size_t length) {
+		long long values[2] = { (long long)this->body.size(), (long long)length };
+		this->buffers.append((const char*)values, sizeof(values));
+		this->buffer_count++;
+		this->body.append(data, length);
+		pad_to(this->body, 8);
+	}
+
+	FlatRef record_batch(size_t length) const {
+		FlatRef batch = flat_table();
+		flat_scalar(batch, 0, (long long)length);
+		flat_child(batch, 1, flat_raw_vector(this->nodes, this->node_count, 8));
+		flat_child(batch, 2, flat_raw_vector(this->buffers, this->buffer_count, 8));
+		return batch;
+	}
+};
+
+// validity bitmap, least significant bit first, empty if there are no nulls
+static string validity_bitmap(const ArrowColumn& column) {
+	if (column.null_count == 0) {
+		return string();
+	}
+	string bitmap((column.valid.size() + 7) / 8, '\0');
+	for (size_t i = 0; i < column.valid.size(); i++) {
+		if (column.valid[i]) {
+			bitmap[i / 8] |= (char)(1 << (i % 8));
+		}
+	}
+	return bitmap;
+}
+
+ArrowFileWriter::ArrowFileWriter(const wstring& arrow_file) :
+	arrow_out(arrow_file, ios::binary | ios::trunc), position(0), batch_rows(0), total_rows(0), schema_written(false), closed(false) {
+	if (!this->arrow_out) {
+		LogLine() << L"Couldn't create " << arrow_file;
+	}
+}
+
+bool ArrowFileWriter::is_open() const {
+	return this->arrow_out.is_open() && this->arrow_out.good();
+}
+
+int ArrowFileWriter::add_column(const wstring& name, ArrowColumnType type) {
+	ArrowColumn column;
+	column.name = to_utf8(name);
+	column.type = type;
+	column.null_count = 0;
+	column.dictionary_written = false;
+	this->columns.push_back(column);
+	return (int)this->columns.size() - 1;
+}
+
+int ArrowFileWriter::column_count() const {
+	return (int)this->columns.size();
+}
+
+void ArrowFileWriter::set_int(int column, long long value) {
+	this->columns[column].ints.push_back(value);
+	this->columns[column].valid.push_back(1);
+}
+
+void ArrowFileWriter::set_double(int column, double value) {
+	this->columns[column].doubles.push_back(value);
+	this->columns[column].valid.push_back(1);
+}
+
+void ArrowFileWriter::set_string(int column, const wstring& value) {
+	ArrowColumn& target = this->columns[column];
+	string text = to_utf8(value);
+	unordered_map<string, int>::iterator entry = target.dictionary.find(text);
+	if (entry == target.dictionary.end()) {
+		entry = target.dictionary.insert(make_pair(text, (int)target.dictionary.size())).first;
+		target.new_values.push_back(text);
+	}
+	target.indices.push_back(entry->second);
+	target.valid.push_back(1);
+}
+
+void ArrowFileWriter::end_row() {
+	this->batch_rows++;
+	for (ArrowColumn& column : this->columns) {
+		if ((int)column.valid.size() < this->batch_rows) {
+			column.valid.push_back(0);
+			column.null_count++;
+			if (column.type == ARROW_INT64) {
+				column.ints.push_back(0);
+			}
+			else if (column.type == ARROW_FLOAT64) {
+				column.doubles.push_back(0);
+			}
+			else {
+				column.indices.push_back(0);
+			}
+		}
+	}
+}
+
+void ArrowFileWriter::write_bytes(const char *data, size_t size) {
+	this->arrow_out.write(data, size);
+	this->position += size;
+}
+
+ArrowBlock ArrowFileWriter::write_message(const string& metadata, const string& body) {
+	// continuation marker, metadata length, metadata and body, all padded to 8 bytes
+	ArrowBlock block = { this->position, (int)(8 + metadata.size()), body.size() };
+	int prefix[2] = { -1, (int)metadata.size() };
+	write_bytes((const char*)prefix, sizeof(prefix));
+	write_bytes(metadata.data(), metadata.size());
+	write_bytes(body.data(), body.size());
+	return block;
+}
+
+void ArrowFileWriter::write_batch() {
+	if (!this->schema_written) {
+		write_bytes(ARROW_MAGIC, sizeof(ARROW_MAGIC));
+		write_message(flat_finish(message_table(HEADER_SCHEMA, schema_table(this->columns), 0)), string());
+		this->schema_written = true;
+	}
+	if (this->batch_rows == 0) {
+		return;
+	}
+	// strings new to the dictionaries, the first batch of a dictionary replaces nothing, later ones are deltas
+	for (size_t i = 0; i < this->columns.size(); i++) {
+		ArrowColumn& column = this->columns[i];
+		if (column.type != ARROW_DICTIONARY || (column.new_values.empty() && column.dictionary_written)) {
+			continue;
+		}
+		string offsets;
+		string data;
+		int offset = 0;
+		offsets.append((const char*)&offset, sizeof(offset));
+		for (const string& value : column.new_values) {
+			data += value;
+			offset = (int)data.size();
+			offsets.append((const char*)&offset, sizeof(offset));
+		}
+		BatchBody body;
+		body.add_node(column.new_values.size(), 0);
+		body.add_buffer("", 0);
+		body.add_buffer(offsets.data(), offsets.size());
+		body.add_buffer(data.data(), data.size());
+		FlatRef dictionary_batch = flat_table();
+		flat_scalar(dictionary_batch, 0, (long long)i);
+		flat_child(dictionary_batch, 1, body.record_batch(column.new_values.size()));
+		flat_scalar(dictionary_batch, 2, (unsigned char)(column.dictionary_written ? 1 : 0));
+		this->dictionary_blocks.push_back(write_message(flat_finish(message_table(HEADER_DICTIONARY_BATCH, dictionary_batch, body.body.size())), body.body));
+		column.new_values.clear();
+		column.dictionary_written = true;
+	}
+
+	BatchBody body;
+	for (ArrowColumn& column : this->columns) {
+		body.add_node(this->batch_rows, column.null_count);
+		string bitmap = validity_bitmap(column);
+		body.add_buffer(bitmap.data(), bitmap.size());
+		if (column.type == ARROW_INT64) {
+			body.add_buffer((const char*)column.ints.data(), column.ints.size() * sizeof(long long));
+		}
+		else if (column.type == ARROW_FLOAT64) {
+			body.add_buffer((const char*)column.doubles.data(), column.doubles.size() * sizeof(double));
+		}
+		else {
+			body.add_buffer((const char*)column.indices.data(), column.indices.size() * sizeof(int));
+		}
+		column.valid.clear();
+		column.null_count = 0;
+		column.ints.clear();
+		column.doubles.clear();
+		column.indices.clear();
+	}
+	this->record_batch_blocks.push_back(write_message(flat_finish(message_table(HEADER_RECORD_BATCH, body.record_batch(this->batch_rows), body.body.size())), body.body));
+	this->total_rows += this->batch_rows;
+	this->batch_rows = 0;
+}
+
+bool ArrowFileWriter::close() {
+	if (this->closed) {
+		return !this->arrow_out.fail();
+	}
+	this->closed = true;
+	write_batch();
+	// end of stream marker, then the footer listing all messages for random access
+	int end_of_stream[2] = { -1, 0 };
+	write_bytes((const char*)end_of_stream, sizeof(end_of_stream));
+	auto blocks_vector = [](const vector<ArrowBlock>& blocks) {
+		string bytes;
+		for (const ArrowBlock& block : blocks) {
+			long long offset = (long long)block.offset;
+			int metadata_length[2] = { block.metadata_length, 0 };
+			long long body_length = (long long)block.body_length;
+			bytes.append((const char*)&offset, sizeof(offset));
+			bytes.append((const char*)metadata_length, sizeof(metadata_length));
+			bytes.append((const char*)&body_length, sizeof(body_length));
+		}
+		return flat_raw_vector(bytes, blocks.size(), 8);
+	};
+	FlatRef footer = flat_table();
+	flat_scalar(footer, 0, ARROW_METADATA_VERSION);
+	flat_child(footer, 1, schema_table(this->columns));
+	flat_child(footer, 2, blocks_vector(this->dictionary_blocks));
+	flat_child(footer, 3, blocks_vector(this->record_batch_blocks));
+	string footer_bytes = flat_finish(footer);
+	write_bytes(footer_bytes.data(), footer_bytes.size());
+	int footer_length = (int)footer_bytes.size();
+	write_bytes((const char*)&footer_length, sizeof(footer_length));
+	write_bytes(ARROW_MAGIC, 6);
+	this->arrow_out.close();
+	return !this->arrow_out.fail();
+}
+
+unsigned long long ArrowFileWriter::row_count() const {
+	return this->total_rows;
+}
+
+unsigned long long ArrowFileWriter::file_bytes() const {
+	return this->position;
+}
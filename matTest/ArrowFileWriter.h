@@ -0,0 +1,117 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <fstream>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// type of a column, strings are always dictionary encoded
+enum ArrowColumnType {
+	ARROW_INT64,
+	ARROW_FLOAT64,
+	ARROW_DICTIONARY
+};
+
+// values of one column of the batch being collected, see ArrowFileWriter
+struct ArrowColumn {
+	string name;
+	ArrowColumnType type;
+	// one entry per row, 0 for null
+	vector<unsigned char> valid;
+	size_t null_count;
+	vector<long long> ints;
+	vector<double> doubles;
+	// ARROW_DICTIONARY: index into the dictionary per row, dictionary of all batches so far and the values added since the last batch
+	vector<int> indices;
+	unordered_map<string, int> dictionary;
+	vector<string> new_values;
+	bool dictionary_written;
+};
+
+// position of a message in the file, listed in the footer
+struct ArrowBlock {
+	unsigned long long offset;
+	int metadata_length;
+	unsigned long long body_length;
+};
+
+#pragma once
+class ArrowFileWriter
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function creates an Arrow IPC file (Feather V2), which readers can memory-map
+	*
+	* Input:
+	*		arrow_file			wstring				file to create, an existing file is replaced
+	*
+	* Columns are added first, then rows are collected and written as record batches with write_batch. Strings are dictionary encoded,
+	* a batch only writes the strings new to the dictionary (delta dictionary batch), so repeated names and units are stored once.
+	*
+	*************************************************************************************************************************************************************************/
+	ArrowFileWriter(const wstring&);
+
+	bool is_open() const;
+
+	// adds a column before the first row, returns its index
+	int add_column(const wstring&, ArrowColumnType);
+	int column_count() const;
+
+
+	/*************************************************************************************************************************************************************************
+	* These functions set a value of the current row, columns not set are null
+	*
+	* Input:
+	*		column				int					index from add_column, the value has to match its type
+	*		value				long long / double / wstring
+	*
+	*************************************************************************************************************************************************************************/
+	void set_int(int, long long);
+	void set_double(int, double);
+	void set_string(int, const wstring&);
+	void end_row();
+
+	// writes the rows collected so far as one record batch, the schema is written with the first batch
+	void write_batch();
+
+
+	/*************************************************************************************************************************************************************************
+	* This function writes the collected rows and the footer
+	*
+	* Output:
+	*		res					bool				false if the file couldn't be written completely
+	*
+	*************************************************************************************************************************************************************************/
+	bool close();
+
+	unsigned long long row_count() const;
+	unsigned long long file_bytes() const;
+
+private:
+	ArrowFileWriter(const ArrowFileWriter&);
+	ArrowFileWriter& operator=(const ArrowFileWriter&);
+
+	ArrowBlock write_message(const string&, const string&);
+	void write_bytes(const char*, size_t);
+
+	ofstream arrow_out;
+	unsigned long long position;
+	vector<ArrowColumn> columns;
+	int batch_rows;
+	unsigned long long total_rows;
+	bool schema_written;
+	bool closed;
+	vector<ArrowBlock> dictionary_blocks;
+	vector<ArrowBlock> record_batch_blocks;
+};
@@ -0,0 +1,177 @@
+#include "ContentHash.h"
+#include <cstring>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+static const unsigned long long PRIME_1 = 11400714785074694791ULL;
+static const unsigned long long PRIME_2 = 14029467366897019727ULL;
+static const unsigned long long PRIME_3 = 1609587929392839161ULL;
+static const unsigned long long PRIME_4 = 9650029242287828579ULL;
+static const unsigned long long PRIME_5 = 2870177450012600261ULL;
+
+static inline unsigned long long rotate_left(unsigned long long value, int bits) {
+	return (value << bits) | (value >> (64 - bits));
+}
+
+// memcpy keeps unaligned reads well defined, the compiler turns it into a plain load
+static inline unsigned long long read_64(const unsigned char* data) {
+	unsigned long long value;
+	memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+static inline unsigned long long read_32(const unsigned char* data) {
+	unsigned int value;
+	memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+static inline unsigned long long hash_round(unsigned long long lane, unsigned long long input) {
+	lane += input * PRIME_2;
+	lane = rotate_left(lane, 31);
+	return lane * PRIME_1;
+}
+
+static inline unsigned long long merge_round(unsigned long long hash, unsigned long long lane) {
+	hash ^= hash_round(0, lane);
+	return hash * PRIME_1 + PRIME_4;
+}
+
+ContentHash::ContentHash(unsigned long long seed) : buffered(0), total_length(0), seed(seed) {
+	this->lanes[0] = seed + PRIME_1 + PRIME_2;
+	this->lanes[1] = seed + PRIME_2;
+	this->lanes[2] = seed;
+	this->lanes[3] = seed - PRIME_1;
+}
+
+void ContentHash::update(const void* data, size_t size) {
+	const unsigned char *input = static_cast<const unsigned char*>(data);
+	const unsigned char *end = input + size;
+	this->total_length += size;
+	if (this->buffered + size < 32) {
+		if (size > 0) {
+			memcpy(this->buffer + this->buffered, input, size);
+		}
+		this->buffered += size;
+		return;
+	}
+	if (this->buffered > 0) {
+		// complete the stripe started by the last call
+		size_t fill = 32 - this->buffered;
+		memcpy(this->buffer + this->buffered, input, fill);
+		input += fill;
+		for (int i = 0; i < 4; i++) {
+			this->lanes[i] = hash_round(this->lanes[i], read_64(this->buffer + 8 * i));
+		}
+		this->buffered = 0;
+	}
+	unsigned long long lane_0 = this->lanes[0];
+	unsigned long long lane_1 = this->lanes[1];
+	unsigned long long lane_2 = this->lanes[2];
+	unsigned long long lane_3 = this->lanes[3];
+	while (end - input >= 32) {
+		lane_0 = hash_round(lane_0, read_64(input));
+		lane_1 = hash_round(lane_1, read_64(input + 8));
+		lane_2 = hash_round(lane_2, read_64(input + 16));
+		lane_3 = hash_round(lane_3, read_64(input + 24));
+		input += 32;
+	}
+	this->lanes[0] = lane_0;
+	this->lanes[1] = lane_1;
+	this->lanes[2] = lane_2;
+	this->lanes[3] = lane_3;
+	this->buffered = end - input;
+	if (this->buffered > 0) {
+		memcpy(this->buffer, input, this->buffered);
+	}
+}
+
+void ContentHash::update(const wstring& text) {
+	update((unsigned long long)text.size());
+	update(text.data(), text.size() * sizeof(wchar_t));
+}
+
+void ContentHash::update(unsigned long long value) {
+	update(&value, sizeof(value));
+}
+
+unsigned long long ContentHash::digest() const {
+	unsigned long long hash;
+	if (this->total_length >= 32) {
+		hash = rotate_left(this->lanes[0], 1) + rotate_left(this->lanes[1], 7) + rotate_left(this->lanes[2], 12) + rotate_left(this->lanes[3], 18);
+		for (int i = 0; i < 4; i++) {
+			hash = merge_round(hash, this->lanes[i]);
+		}
+	}
+	else {
+		hash = this->seed + PRIME_5;
+	}
+	hash += this->total_length;
+	const unsigned char *input = this->buffer;
+	const unsigned char *end = this->buffer + this->buffered;
+	while (end - input >= 8) {
+		hash ^= hash_round(0, read_64(input));
+		hash = rotate_left(hash, 27) * PRIME_1 + PRIME_4;
+		input += 8;
+	}
+	if (end - input >= 4) {
+		hash ^= read_32(input) * PRIME_1;
+		hash = rotate_left(hash, 23) * PRIME_2 + PRIME_3;
+		input += 4;
+	}
+	while (input < end) {
+		hash ^= (*input) * PRIME_5;
+		hash = rotate_left(hash, 11) * PRIME_1;
+		input++;
+	}
+	// avalanche
+	hash ^= hash >> 33;
+	hash *= PRIME_2;
+	hash ^= hash >> 29;
+	hash *= PRIME_3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+unsigned long long ContentHash::of(const void* data, size_t size, unsigned long long seed) {
+	ContentHash hash(seed);
+	hash.update(data, size);
+	return hash.digest();
+}
+
+wstring ContentHash::to_hex(unsigned long long value) {
+	static const wchar_t digits[] = L"0123456789abcdef";
+	wstring hex(16, L'0');
+	for (int i = 15; i >= 0; i--) {
+		hex[i] = digits[value & 0xf];
+		value >>= 4;
+	}
+	return hex;
+}
+
+bool ContentHash::from_hex(const wstring& hex, unsigned long long* value) {
+	if (hex.size() != 16) {
+		return false;
+	}
+	unsigned long long result = 0;
+	for (wchar_t digit : hex) {
+		result <<= 4;
+		if (digit >= L'0' && digit <= L'9') {
+			result |= digit - L'0';
+		}
+		else if (digit >= L'a' && digit <= L'f') {
+			result |= digit - L'a' + 10;
+		}
+		else {
+			return false;
+		}
+	}
+	*value = result;
+	return true;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+#pragma once
+class ContentHash
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function starts a 64 bit content hash (XXH64)
+	*
+	* Input:
+	*		seed				unsigned long long		different seeds give independent hashes of the same content
+	*
+	*************************************************************************************************************************************************************************/
+	ContentHash(unsigned long long = 0);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function adds bytes to the hash, the result only depends on the concatenated bytes and not on how they are split
+	*
+	* Input:
+	*		data				void*				bytes to add
+	*		size				size_t				number of bytes
+	*
+	*************************************************************************************************************************************************************************/
+	void update(const void*, size_t);
+
+	// strings are added with their length, so "ab" + "c" and "a" + "bc" hash differently
+	void update(const wstring&);
+	void update(unsigned long long);
+
+	// hash of all bytes added so far, more bytes may be added afterwards
+	unsigned long long digest() const;
+
+	// hash of one buffer
+	static unsigned long long of(const void*, size_t, unsigned long long = 0);
+
+	// 16 hex digits, as stored in manifests
+	static wstring to_hex(unsigned long long);
+	static bool from_hex(const wstring&, unsigned long long*);
+
+private:
+	unsigned long long lanes[4];
+	unsigned char buffer[32];
+	size_t buffered;
+	unsigned long long total_length;
+	unsigned long long seed;
+};
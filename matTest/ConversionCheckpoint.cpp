@@ -0,0 +1,183 @@
+#include "ConversionCheckpoint.h"
+#include "ContentHash.h"
+#include "ConversionLog.h"
+#include <fstream>
+#include <codecvt>
+#include <locale>
+#include <stdexcept>
+#include <system_error>
+#include <experimental\filesystem>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+namespace filesys = std::experimental::filesystem;
+
+// paths may contain any character, the checkpoint is kept in UTF-8
+static locale utf8_locale() {
+	return locale(locale(), new codecvt_utf8<wchar_t>);
+}
+
+ConversionCheckpoint::ConversionCheckpoint(const wstring& checkpoint_path, unsigned long long fingerprint) :
+	checkpoint_path(checkpoint_path), fingerprint(fingerprint), resumable(false), subsets(0), json_size(0) {
+	wifstream checkpoint_in(checkpoint_path);
+	if (!checkpoint_in) {
+		return;
+	}
+	checkpoint_in.imbue(utf8_locale());
+	// one "key<tab>value" per line, the repetition lines of a subset are followed by its commit line
+	bool same_inputs = false;
+	size_t committed_lines = 0;
+	wstring line;
+	while (getline(checkpoint_in, line)) {
+		// a line cut off by an interruption has no line end
+		if (checkpoint_in.eof()) {
+			break;
+		}
+		size_t tab = line.find(L'\t');
+		if (tab == wstring::npos) {
+			continue;
+		}
+		wstring key = line.substr(0, tab);
+		wstring value = line.substr(tab + 1);
+		try {
+			if (key == L"fingerprint") {
+				unsigned long long stored_fingerprint;
+				same_inputs = ContentHash::from_hex(value, &stored_fingerprint) && stored_fingerprint == fingerprint;
+			}
+			else if (key == L"out_folder") {
+				this->out_folder_path = value;
+			}
+			else if (key == L"ts_data_created") {
+				this->ts_data_created_value = value;
+			}
+			else if (key == L"repetition") {
+				this->repetition_summary.push_back(value);
+			}
+			else if (key == L"commit") {
+				// subsets<tab>json_bytes
+				size_t bytes_tab = value.find(L'\t');
+				if (bytes_tab == wstring::npos) {
+					throw invalid_argument("commit");
+				}
+				this->subsets = stoi(value.substr(0, bytes_tab));
+				this->json_size = stoull(value.substr(bytes_tab + 1));
+				committed_lines = this->repetition_summary.size();
+			}
+		}
+		catch (...) {
+			same_inputs = false;
+		}
+	}
+	// repetition lines after the last commit belong to a subset which wasn't completely written
+	this->repetition_summary.resize(committed_lines);
+	this->resumable = same_inputs && this->subsets > 0 && !this->out_folder_path.empty();
+	if (!this->resumable) {
+		this->out_folder_path.clear();
+		this->ts_data_created_value.clear();
+		this->subsets = 0;
+		this->json_size = 0;
+		this->repetition_summary.clear();
+	}
+}
+
+void ConversionCheckpoint::start(const wstring& out_folder, const wstring& ts_data_created) {
+	this->resumable = false;
+	this->out_folder_path = out_folder;
+	this->ts_data_created_value = ts_data_created;
+	this->subsets = 0;
+	this->json_size = 0;
+	this->repetition_summary.clear();
+	// a checkpoint of other inputs is of no use anymore
+	this->checkpoint_out.close();
+	error_code error;
+	filesys::remove(this->checkpoint_path, error);
+}
+
+bool ConversionCheckpoint::commit(unsigned long long json_bytes, const vector<wstring>& repetition_lines) {
+	this->subsets++;
+	this->json_size = json_bytes;
+	this->repetition_summary.insert(this->repetition_summary.end(), repetition_lines.begin(), repetition_lines.end());
+	if (!this->checkpoint_out.is_open()) {
+		// the first commit of this run writes the whole checkpoint, the next ones are appended to it
+		if (!save()) {
+			return false;
+		}
+		this->checkpoint_out.open(this->checkpoint_path, ios::out | ios::app);
+		this->checkpoint_out.imbue(utf8_locale());
+		return !this->checkpoint_out.fail();
+	}
+	for (const wstring& line : repetition_lines) {
+		this->checkpoint_out << L"repetition\t" << line << L"\n";
+	}
+	this->checkpoint_out << L"commit\t" << this->subsets << L"\t" << this->json_size << L"\n";
+	this->checkpoint_out.flush();
+	if (this->checkpoint_out.fail()) {
+		LogLine() << L"Couldn't write checkpoint: " << this->checkpoint_path;
+		return false;
+	}
+	return true;
+}
+
+bool ConversionCheckpoint::save() const {
+	wstring part_path = this->checkpoint_path + L".part";
+	wofstream checkpoint_out(part_path, ios::out | ios::trunc);
+	if (!checkpoint_out) {
+		return false;
+	}
+	checkpoint_out.imbue(utf8_locale());
+	checkpoint_out << L"fingerprint\t" << ContentHash::to_hex(this->fingerprint) << L"\n";
+	checkpoint_out << L"out_folder\t" << this->out_folder_path << L"\n";
+	checkpoint_out << L"ts_data_created\t" << this->ts_data_created_value << L"\n";
+	for (const wstring& line : this->repetition_summary) {
+		checkpoint_out << L"repetition\t" << line << L"\n";
+	}
+	checkpoint_out << L"commit\t" << this->subsets << L"\t" << this->json_size << L"\n";
+	checkpoint_out.close();
+	error_code error;
+	if (!checkpoint_out.fail()) {
+		filesys::rename(part_path, this->checkpoint_path, error);
+	}
+	if (checkpoint_out.fail() || error) {
+		filesys::remove(part_path, error);
+		LogLine() << L"Couldn't write checkpoint: " << this->checkpoint_path;
+		return false;
+	}
+	return true;
+}
+
+void ConversionCheckpoint::finish() {
+	this->checkpoint_out.close();
+	error_code error;
+	filesys::remove(this->checkpoint_path, error);
+	this->resumable = false;
+}
+
+bool ConversionCheckpoint::resume() const {
+	return this->resumable;
+}
+
+const wstring& ConversionCheckpoint::out_folder() const {
+	return this->out_folder_path;
+}
+
+const wstring& ConversionCheckpoint::ts_data_created() const {
+	return this->ts_data_created_value;
+}
+
+int ConversionCheckpoint::committed_subsets() const {
+	return this->subsets;
+}
+
+unsigned long long ConversionCheckpoint::json_bytes() const {
+	return this->json_size;
+}
+
+const vector<wstring>& ConversionCheckpoint::repetition_lines() const {
+	return this->repetition_summary;
+}
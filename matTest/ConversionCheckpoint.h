@@ -0,0 +1,91 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+#pragma once
+class ConversionCheckpoint
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function reads the checkpoint of an interrupted conversion
+	*
+	* Input:
+	*		checkpoint_path		wstring				checkpoint file next to 50_Report
+	*		fingerprint			unsigned long long	hash of the inputs of this run
+	*
+	* The checkpoint is only taken if it was written for the same inputs, otherwise the conversion starts from the beginning
+	*
+	*************************************************************************************************************************************************************************/
+	ConversionCheckpoint(const wstring&, unsigned long long);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function starts a new conversion, resume() is false afterwards
+	*
+	* Input:
+	*		out_folder			wstring				output folder of the report
+	*		ts_data_created		wstring				creation date written into the report, kept when resuming on another day
+	*
+	*************************************************************************************************************************************************************************/
+	void start(const wstring&, const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function records that the JSON of one more subset is completely written
+	*
+	* Input:
+	*		json_bytes			unsigned long long	size of the JSON file after the subset, the file is flushed
+	*		repetition_lines	vector<wstring>		repetition summary lines of the subset
+	* Output:
+	*		res					bool				checkpoint written
+	*
+	* The first commit of a run replaces the checkpoint file in one step, the next ones append the lines of their subset and a commit line.
+	* Lines after the last complete commit line are ignored, so the checkpoint always describes a consistent state
+	*
+	*************************************************************************************************************************************************************************/
+	bool commit(unsigned long long, const vector<wstring>&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function removes the checkpoint once the report is complete
+	*************************************************************************************************************************************************************************/
+	void finish();
+
+	// true if an interrupted conversion of the same inputs can be continued
+	bool resume() const;
+	const wstring& out_folder() const;
+	const wstring& ts_data_created() const;
+	// number of subsets completely written to the JSON
+	int committed_subsets() const;
+	unsigned long long json_bytes() const;
+	// repetition summary lines of the committed subsets
+	const vector<wstring>& repetition_lines() const;
+
+private:
+	bool save() const;
+
+	wstring checkpoint_path;
+	unsigned long long fingerprint;
+	bool resumable;
+
+	wstring out_folder_path;
+	wstring ts_data_created_value;
+	int subsets;
+	unsigned long long json_size;
+	vector<wstring> repetition_summary;
+	// checkpoint file the commits are appended to, open after the first commit
+	wofstream checkpoint_out;
+};
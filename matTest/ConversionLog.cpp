@@ -0,0 +1,57 @@
+#include "ConversionLog.h"
+#include <mutex>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+static mutex sink_mutex;
+static LogSink log_sink;
+// listeners are called without sink_mutex, each one only sees the lines of its own conversion
+static thread_local const LogSink* log_listener = NULL;
+
+void set_log_sink(const LogSink& sink) {
+	lock_guard<mutex> lock(sink_mutex);
+	log_sink = sink;
+}
+
+void log_line(const wstring& line) {
+	{
+		lock_guard<mutex> lock(sink_mutex);
+		if (log_sink) {
+			log_sink(line);
+		}
+	}
+	if (log_listener != NULL && *log_listener) {
+		(*log_listener)(line);
+	}
+}
+
+const LogSink* current_log_listener() {
+	return log_listener;
+}
+
+LogListenerScope::LogListenerScope(const LogSink* listener) :
+	previous_listener(log_listener) {
+	log_listener = listener;
+}
+
+LogListenerScope::~LogListenerScope() {
+	log_listener = this->previous_listener;
+}
+
+LogLine::LogLine() {
+}
+
+LogLine::~LogLine() {
+	log_line(this->line.str());
+}
+
+LogLine& LogLine::operator<<(const string& value) {
+	this->line << wstring(value.begin(), value.end());
+	return *this;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <sstream>
+#include <functional>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// receives every line the converter reports, without line break
+typedef function<void(const wstring&)> LogSink;
+
+/*************************************************************************************************************************************************************************
+* This function sets where the converter reports to, the converter prints nothing by itself
+*
+* Input:
+*		sink				LogSink				called for every line, lines of threads converting at the same time are passed one after the other
+*
+*************************************************************************************************************************************************************************/
+void set_log_sink(const LogSink&);
+
+// passes one line to the log sink and to the listener of the calling thread
+void log_line(const wstring&);
+
+// listener of the calling thread, NULL if there is none
+const LogSink* current_log_listener();
+
+#pragma once
+class LogListenerScope
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function passes the lines of the calling thread to a listener as well, until the scope ends
+	*
+	* Input:
+	*		listener			LogSink				receives the lines of one conversion (e.g. to stream them to a client), NULL for none
+	*
+	* Threads started for a conversion take over the listener of the thread starting them with LogListenerScope(current_log_listener())
+	*
+	*************************************************************************************************************************************************************************/
+	LogListenerScope(const LogSink*);
+	~LogListenerScope();
+
+private:
+	LogListenerScope(const LogListenerScope&);
+	LogListenerScope& operator=(const LogListenerScope&);
+
+	const LogSink* previous_listener;
+};
+
+#pragma once
+class LogLine
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function collects one line with <<, the line is passed to the log sink when the LogLine is destroyed
+	*
+	* Usage:
+	*		LogLine() << L"Limits loaded: " << count;
+	*
+	*************************************************************************************************************************************************************************/
+	LogLine();
+	~LogLine();
+
+	template <typename T>
+	LogLine& operator<<(const T& value) {
+		this->line << value;
+		return *this;
+	}
+	LogLine& operator<<(const string&);
+
+private:
+	LogLine(const LogLine&);
+	LogLine& operator=(const LogLine&);
+
+	wostringstream line;
+};
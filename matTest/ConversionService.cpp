@@ -0,0 +1,362 @@
+#include "ConversionService.h"
+#include "ConversionLog.h"
+#include <thread>
+#include <chrono>
+#include <codecvt>
+#include <locale>
+#include <system_error>
+#include <algorithm>
+#include <sstream>
+#include <experimental\filesystem>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+namespace filesys = std::experimental::filesystem;
+
+#ifdef _WIN32
+// afunix.h is missing in the Windows 8.1 SDK, Windows 10 accepts AF_UNIX stream sockets with this address
+#ifndef AF_UNIX
+#define AF_UNIX 1
+#endif
+struct sockaddr_un {
+	ADDRESS_FAMILY sun_family;
+	char sun_path[108];
+};
+typedef int socklen_t;
+#define poll WSAPoll
+#define close_handle closesocket
+static const int SEND_FLAGS = 0;
+#else
+#define close_handle close
+// a client going away must not end the service with SIGPIPE
+static const int SEND_FLAGS = MSG_NOSIGNAL;
+#endif
+
+static const uintptr_t NO_SOCKET = ~(uintptr_t)0;
+// accept and receive wake up this often to notice a shutdown
+static const int SERVICE_POLL_MS = 250;
+static const int LISTEN_BACKLOG = 16;
+// a longer line is no request of this protocol, the connection is closed
+static const size_t MAX_REQUEST_BYTES = 64 * 1024;
+
+static string to_utf8(const wstring& text) {
+	return wstring_convert<codecvt_utf8<wchar_t>>().to_bytes(text);
+}
+
+static bool from_utf8(const string& text, wstring& res) {
+	try {
+		res = wstring_convert<codecvt_utf8<wchar_t>>().from_bytes(text);
+		return true;
+	}
+	catch (const range_error&) {
+		return false;
+	}
+}
+
+static vector<wstring> split_fields(const wstring& line) {
+	vector<wstring> fields;
+	size_t start = 0;
+	while (true) {
+		size_t tab = line.find(L'\t', start);
+		fields.push_back(line.substr(start, tab == wstring::npos ? wstring::npos : tab - start));
+		if (tab == wstring::npos) {
+			break;
+		}
+		start = tab + 1;
+	}
+	return fields;
+}
+
+// sends one message, line breaks within a field would split it into two messages
+static bool send_line(uintptr_t connection, mutex& send_mutex, const wstring& line) {
+	string bytes = to_utf8(line);
+	replace(bytes.begin(), bytes.end(), '\n', ' ');
+	replace(bytes.begin(), bytes.end(), '\r', ' ');
+	bytes += '\n';
+	lock_guard<mutex> lock(send_mutex);
+	for (size_t sent = 0; sent < bytes.size(); ) {
+		int res = send(connection, bytes.data() + sent, (int)(bytes.size() - sent), SEND_FLAGS);
+		if (res <= 0) {
+			return false;
+		}
+		sent += res;
+	}
+	return true;
+}
+
+ConversionService::ConversionService(Converter& converter, const wstring& socket_path, int worker_count) :
+	converter(converter), socket_path(socket_path), worker_count(max(1, worker_count)), listen_socket(NO_SOCKET), stopping(false), requests(0) {
+#ifdef _WIN32
+	WSADATA wsa_data;
+	WSAStartup(MAKEWORD(2, 2), &wsa_data);
+#endif
+}
+
+ConversionService::~ConversionService() {
+	close_socket();
+#ifdef _WIN32
+	WSACleanup();
+#endif
+}
+
+bool ConversionService::open_socket() {
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	string path = to_utf8(this->socket_path);
+	if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+		LogLine() << L"Socket path too long: " << this->socket_path;
+		return false;
+	}
+	memcpy(address.sun_path, path.c_str(), path.size());
+
+	error_code error;
+	if (filesys::exists(this->socket_path, error)) {
+		// a socket file left by a service which ended without cleaning up is replaced, a listening service is not
+		uintptr_t probe = (uintptr_t)socket(AF_UNIX, SOCK_STREAM, 0);
+		bool in_use = probe != NO_SOCKET && connect(probe, (const sockaddr*)&address, sizeof(address)) == 0;
+		if (probe != NO_SOCKET) {
+			close_handle(probe);
+		}
+		if (in_use) {
+			LogLine() << L"Another service is listening on " << this->socket_path;
+			return false;
+		}
+		filesys::remove(this->socket_path, error);
+	}
+	this->listen_socket = (uintptr_t)socket(AF_UNIX, SOCK_STREAM, 0);
+	if (this->listen_socket == NO_SOCKET) {
+		LogLine() << L"Couldn't create socket for " << this->socket_path;
+		return false;
+	}
+	if (::bind(this->listen_socket, (const sockaddr*)&address, sizeof(address)) != 0 || listen(this->listen_socket, LISTEN_BACKLOG) != 0) {
+		LogLine() << L"Couldn't listen on " << this->socket_path;
+		close_handle(this->listen_socket);
+		this->listen_socket = NO_SOCKET;
+		return false;
+	}
+	return true;
+}
+
+void ConversionService::close_socket() {
+	if (this->listen_socket == NO_SOCKET) {
+		return;
+	}
+	close_handle(this->listen_socket);
+	this->listen_socket = NO_SOCKET;
+	error_code error;
+	filesys::remove(this->socket_path, error);
+}
+
+bool ConversionService::run() {
+	if (!open_socket()) {
+		return false;
+	}
+	LogLine() << L"Conversion service listening on " << this->socket_path << L" with " << this->worker_count << L" workers";
+	vector<thread> workers;
+	for (int i = 0; i < this->worker_count; i++) {
+		workers.push_back(thread(&ConversionService::worker, this));
+	}
+	while (!this->stopping) {
+		pollfd ready;
+		ready.fd = this->listen_socket;
+		ready.events = POLLIN;
+		ready.revents = 0;
+		if (poll(&ready, 1, SERVICE_POLL_MS) <= 0) {
+			continue;
+		}
+		uintptr_t connection = (uintptr_t)accept(this->listen_socket, NULL, NULL);
+		if (connection == NO_SOCKET) {
+			continue;
+		}
+		{
+			lock_guard<mutex> lock(this->connection_mutex);
+			this->connections.push_back(connection);
+		}
+		this->connection_ready.notify_one();
+	}
+	this->connection_ready.notify_all();
+	for (thread& worker_thread : workers) {
+		worker_thread.join();
+	}
+	// connections accepted after the shutdown request are not served
+	for (uintptr_t connection : this->connections) {
+		close_handle(connection);
+	}
+	this->connections.clear();
+	close_socket();
+	LogLine() << L"Conversion service stopped after " << this->requests << L" requests, " << admission_report();
+	return true;
+}
+
+void ConversionService::stop() {
+	this->stopping = true;
+	this->connection_ready.notify_all();
+}
+
+void ConversionService::worker() {
+	while (true) {
+		uintptr_t connection;
+		{
+			unique_lock<mutex> lock(this->connection_mutex);
+			while (!this->stopping && this->connections.empty()) {
+				this->connection_ready.wait(lock);
+			}
+			if (this->stopping) {
+				return;
+			}
+			connection = this->connections.front();
+			this->connections.pop_front();
+		}
+		serve(connection);
+		close_handle(connection);
+	}
+}
+
+bool ConversionService::read_line(uintptr_t connection, string& pending, string& line) {
+	while (true) {
+		size_t end = pending.find('\n');
+		if (end != string::npos) {
+			line = pending.substr(0, end);
+			pending.erase(0, end + 1);
+			if (!line.empty() && line.back() == '\r') {
+				line.pop_back();
+			}
+			return true;
+		}
+		if (pending.size() > MAX_REQUEST_BYTES || this->stopping) {
+			return false;
+		}
+		pollfd ready;
+		ready.fd = connection;
+		ready.events = POLLIN;
+		ready.revents = 0;
+		if (poll(&ready, 1, SERVICE_POLL_MS) <= 0) {
+			continue;
+		}
+		char buffer[4096];
+		int received = recv(connection, buffer, sizeof(buffer), 0);
+		if (received <= 0) {
+			return false;
+		}
+		pending.append(buffer, received);
+	}
+}
+
+void ConversionService::serve(uintptr_t connection) {
+	// progress lines of a conversion come from the pipeline threads while the worker waits for it
+	mutex send_mutex;
+	string pending;
+	string bytes;
+	while (read_line(connection, pending, bytes)) {
+		if (bytes.empty()) {
+			continue;
+		}
+		wstring line;
+		if (!from_utf8(bytes, line)) {
+			send_line(connection, send_mutex, L"error\trequest is not UTF-8");
+			continue;
+		}
+		this->requests++;
+		vector<wstring> fields = split_fields(line);
+		if (fields[0] == L"ping") {
+			send_line(connection, send_mutex, L"pong");
+		}
+		else if (fields[0] == L"shutdown") {
+			send_line(connection, send_mutex, L"bye");
+			LogLine() << L"Conversion service shutdown requested";
+			stop();
+			return;
+		}
+		else if (fields[0] == L"stats") {
+			send_line(connection, send_mutex, L"stats\t" + admission_report());
+		}
+		else if (fields[0] == L"convert") {
+			handle_convert(connection, send_mutex, fields);
+		}
+		else {
+			send_line(connection, send_mutex, L"error\tunknown request " + fields[0]);
+		}
+	}
+}
+
+void ConversionService::handle_convert(uintptr_t connection, mutex& send_mutex, const vector<wstring>& fields) {
+	typedef chrono::high_resolution_clock Time;
+	typedef chrono::duration<float, milli> mil;
+	if (fields.size() < 2 || fields[1].empty()) {
+		send_line(connection, send_mutex, L"error\tconvert needs a folder");
+		return;
+	}
+	ConverterOptions options = this->converter.converter_options();
+	wstring config_path;
+	for (size_t i = 2; i < fields.size(); i++) {
+		if (!apply_conversion_option(fields[i], options, config_path)) {
+			send_line(connection, send_mutex, L"error\tunknown option " + fields[i]);
+			return;
+		}
+	}
+
+	// everything the converter logs for this request also goes to the client
+	LogSink progress = [connection, &send_mutex](const wstring& log) {
+		send_line(connection, send_mutex, L"progress\t" + log);
+	};
+	LogListenerScope listener_scope(&progress);
+	auto t_start = Time::now();
+	ConversionInputs inputs;
+	if (!this->converter.collect_inputs(fields[1], inputs)) {
+		send_line(connection, send_mutex, L"error\tno capture found in " + fields[1]);
+		return;
+	}
+	shared_ptr<const TestFlowSetup> setup;
+	if (config_path.empty()) {
+		setup = this->converter.test_flow_setup(inputs.raw_data_path);
+	}
+	else {
+		setup = this->converter.test_flow_setup_from(config_path);
+	}
+	if (!setup) {
+		send_line(connection, send_mutex, L"error\tno configuration for " + fields[1]);
+		return;
+	}
+	send_line(connection, send_mutex, L"accepted");
+	ConversionResult result;
+	try {
+		result = this->converter.convert(inputs, *setup, options);
+	}
+	catch (const exception& e) {
+		wstring message;
+		from_utf8(e.what(), message);
+		send_line(connection, send_mutex, L"error\t" + message);
+		return;
+	}
+	bool ok = result.converted && (result.staged || !options.stage_report);
+	LogLine() << L"Request " << fields[1] << (ok ? L" converted in " : L" failed after ") << mil(Time::now() - t_start).count() << L" ms";
+	send_line(connection, send_mutex, wstring(L"done\t") + (ok ? L"ok" : L"failed") + L"\t" + result.out_folder + L"\t" + result.json_file);
+}
+
+wstring ConversionService::admission_report() {
+	AdmissionController& admission = this->converter.admission();
+	wstringstream report;
+	report << L"memory=" << admission.in_use() / (1024 * 1024) << L"/" << admission.budget() / (1024 * 1024);
+	const wchar_t *class_names[PRIORITY_CLASSES] = { L"interactive", L"batch" };
+	for (int i = 0; i < PRIORITY_CLASSES; i++) {
+		AdmissionStats stats = admission.stats((JobPriority)i);
+		report << L"\t" << class_names[i] << L"=" << stats.admitted << L"," << stats.waiting << L"," <<
+			(stats.admitted > 0 ? stats.wait_ms_total / stats.admitted : 0) << L"," << stats.wait_ms_max;
+	}
+	return report.str();
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include "Converter.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+#pragma once
+class ConversionService
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function creates a resident conversion service on a local (AF_UNIX) socket
+	*
+	* Input:
+	*		converter			Converter			converter shared by all requests, its configuration and limits stay loaded between requests
+	*		socket_path			wstring				path of the socket file
+	*		worker_count		int					number of clients served at the same time
+	*
+	* Protocol, one UTF-8 line per message, fields separated by tabs:
+	*		ping												-> pong
+	*		convert	<folder>[	key=value]...					-> accepted, progress	<line>..., done	ok|failed	<report folder>	<json file>
+	*			folder		30_RawData folder or a folder within it, like the command line
+	*			config=		20_TestFlow folder or its Config_Tembo.txt, default next to 30_RawData
+	*			stage=		on|off, copy the report to the staging area
+	*			resume=		on|off, continue an interrupted conversion of the same inputs
+	*			priority=	interactive|batch, class the conversion waits in when memory is short, default interactive
+	*		stats												-> stats	memory=<MB in use>/<MB budget>	interactive=<admitted>,<waiting>,<mean wait ms>,<max wait ms>	batch=...
+	*		shutdown											-> bye, running requests are finished
+	* A request that can't be served is answered with error	<message>. A client may send any number of requests on one connection.
+	*
+	*************************************************************************************************************************************************************************/
+	ConversionService(Converter&, const wstring&, int);
+	~ConversionService();
+
+
+	/*************************************************************************************************************************************************************************
+	* This function serves requests until a shutdown request or stop()
+	*
+	* Output:
+	*		res					bool				false if the socket couldn't be opened, e.g. because another service is listening on it
+	*
+	*************************************************************************************************************************************************************************/
+	bool run();
+	void stop();
+
+private:
+	ConversionService(const ConversionService&);
+	ConversionService& operator=(const ConversionService&);
+
+	bool open_socket();
+	void close_socket();
+	void worker();
+	void serve(uintptr_t);
+	bool read_line(uintptr_t, string&, string&);
+	void handle_convert(uintptr_t, mutex&, const vector<wstring>&);
+	wstring admission_report();
+
+	Converter& converter;
+	wstring socket_path;
+	int worker_count;
+	// SOCKET on Windows, file descriptor elsewhere, all bits set while closed
+	uintptr_t listen_socket;
+	atomic<bool> stopping;
+
+	// accepted connections waiting for a worker
+	mutex connection_mutex;
+	condition_variable connection_ready;
+	deque<uintptr_t> connections;
+	atomic<size_t> requests;
+};
@@ -0,0 +1,2462 @@
+#include "Converter.h"
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <sstream>
+#include <experimental\filesystem>
+#include <map>
+#include <set>
+#include <tuple>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <codecvt>
+#include "DataReader.h"
+#include "RepetitionCounter.h"
+#include "TestNumberAllocator.h"
+#include "LimitsCatalog.h"
+#include "UnitScaling.h"
+#include "MonotonicArena.h"
+#include "SubsetTable.h"
+#include "SpscQueue.h"
+#include "ObjectSpillStore.h"
+#include "StagingArea.h"
+#include "StagingManifest.h"
+#include "SubsetCache.h"
+#include "ContentHash.h"
+#include "ConversionCheckpoint.h"
+#include "CsvCapture.h"
+#include "XlsxWriter.h"
+#include "ArrowFileWriter.h"
+#include "ParameterStatistics.h"
+#include "LimitEvaluator.h"
+#include "ReportLease.h"
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <exception>
+#include <clocale>
+#include <time.h>
+#include <chrono>
+#include <mat.h>
+#ifdef _WIN32
+#include <comdef.h>
+#endif
+
+namespace filesys = std::experimental::filesystem;
+using namespace std;
+
+// number of test data rows sharing the row arena before it is released
+const int ARENA_ROW_BATCH = 64;
+// number of subsets each pipeline queue can hold before the stage in front of it has to wait
+const int PIPELINE_QUEUE_CAPACITY = 4;
+// number of merged objects handed to the renderer at once when a subset was spilled
+const size_t SPILL_MERGE_BATCH = 1000;
+// number of files copied to the staging area at the same time
+const int STAGING_WORKERS = 8;
+// part of every subset cache key, increase it whenever the JSON of a subset changes so older entries are not used
+const unsigned long long SUBSET_CACHE_VERSION = 1;
+
+// memory of one loaded cell of a subset, mxArray header and value
+const unsigned long long MX_BYTES_PER_CELL = 128;
+// memory of one cell of a subset within the pipeline, decoded row and rendered JSON
+const unsigned long long PIPELINE_BYTES_PER_CELL = 256;
+// loaded size of a capture per byte of its compressed .mat file, used when the header can't be read
+const unsigned long long MAT_FILE_EXPANSION = 16;
+// memory of a decoded and rendered subset per byte of its CSV file
+const unsigned long long CSV_FILE_EXPANSION = 8;
+// rows above the test data in a sheet of the workbook: name, field, unit, lower_limit, upper_limit
+const int WORKBOOK_HEADER_ROWS = 5;
+
+// the mat and mx API is not thread safe, conversions running side by side take turns on it
+mutex mat_api_mutex;
+
+wstring convert_to_lower(wstring data) {
+	transform(data.begin(), data.end(), data.begin(),
+		[](unsigned char c) { return tolower(c); });
+	return data;
+}
+
+// matching_files are allocated from the arena of file_match_conditions and only live for the current row batch
+// at_least: return files containing at least (instead of exactly) as many conditions as they have, see get_candidate_files
+arena_wstring_vector match_files(const arena_wstring_vector& file_match_conditions, const vector<wstring>& files, bool at_least) {
+	arena_wstring_vector matching_files(file_match_conditions.get_allocator());
+	// conditions are the same for every file, align them once
+	arena_wstring_vector lower_conditions(file_match_conditions.get_allocator());
+	for (const arena_wstring& condition : file_match_conditions) {
+		lower_conditions.push_back(condition);
+		arena_wstring& file_match_cond = lower_conditions.back();
+		// make change in order to align with ending 0s              111111111111111
+		if (file_match_cond.find(L"=") != arena_wstring::npos) {
+			int pos_last_non_zero_digit = file_match_cond.find_last_of(L"123456789");
+			int pos_decimal_symbol = file_match_cond.find_last_of(L".");
+			if (pos_last_non_zero_digit > pos_decimal_symbol) {
+				file_match_cond.erase(pos_last_non_zero_digit + 1, file_match_cond.length() - 2);
+			}
+			else {
+				if (pos_decimal_symbol != -1)
+					file_match_cond.erase(pos_decimal_symbol, file_match_cond.length() - 1);
+			}
+		}
+		transform(file_match_cond.begin(), file_match_cond.end(), file_match_cond.begin(),
+			[](unsigned char c) { return tolower(c); });
+	}
+	// lower case file name, buffer is reused for all files
+	arena_wstring lower_file(file_match_conditions.get_allocator());
+	for (const wstring& file : files) {
+		// check how many conditions are given in the current filename based on the number of '=' chars
+		// there is always should be at least 1 occurence for dut_id / sample, the rest are for conditions
+		int num_of_conds_in_filename = (int)count(file.begin(), file.end(), L'=');
+		// should be decreased by 2 since two extra = , one for dut_id, one for REP=
+		num_of_conds_in_filename = num_of_conds_in_filename - 2;
+		// add one more condition for matching parent folder name
+		num_of_conds_in_filename++;
+		// add one more condition for matching Report-Picture or Report-waveform names
+		num_of_conds_in_filename++;
+		lower_file.assign(file.begin(), file.end());
+		transform(lower_file.begin(), lower_file.end(), lower_file.begin(),
+			[](unsigned char c) { return tolower(c); });
+		int num_of_conds_matched = 0;
+		for (const arena_wstring& file_match_cond : lower_conditions) {
+			// count number of conditions that match with conditions in the filename
+			if (lower_file.find(file_match_cond) != arena_wstring::npos) {
+				num_of_conds_matched++;
+			}
+		}
+		// png file is matched if the number of total matched conditions are same as the number of 
+		// conditions in the filename
+		if (num_of_conds_matched == num_of_conds_in_filename || (at_least && num_of_conds_matched > num_of_conds_in_filename)) {
+			size_t base_start = file.find_last_of(L"/\\") + 1;
+			matching_files.emplace_back(file.begin() + base_start, file.end());
+		}
+	}
+	return matching_files;
+}
+
+arena_wstring_vector get_corresponding_files(const arena_wstring_vector& file_match_conditions, const vector<wstring>& files) {
+	return match_files(file_match_conditions, files, false);
+}
+
+// subset_conditions are the conditions of all rows of a subset (see collect_subset_conditions). A row can only match a file
+// if the conditions of all rows together contain enough of its conditions, so every file of any row is among the candidates
+arena_wstring_vector get_candidate_files(const arena_wstring_vector& subset_conditions, const vector<wstring>& files) {
+	return match_files(subset_conditions, files, true);
+}
+
+vector<wstring> getAllFilesInDir(const wstring &dirPath, const wstring &fileExt)
+{
+	// Create a vector of wstring
+	vector<wstring> listOfFiles;
+
+	try {
+		// Check if given path exists and points to a directory
+		if (filesys::exists(dirPath) && filesys::is_directory(dirPath))
+		{
+			// Create a Recursive Directory Iterator object and points to the starting of directory
+			filesys::recursive_directory_iterator iter(dirPath);
+
+			// Create a Recursive Directory Iterator object pointing to end.
+			filesys::recursive_directory_iterator end;
+
+			// Iterate till end
+			while (iter != end) {
+				// Check if current entry is a directory and if exists in skip list
+				if (filesys::is_directory(iter->path())) {
+					// Skip the iteration of current directory pointed by iterator
+				}
+				else {
+					// Add the name in vector
+					try {
+						if (iter->path().wstring().find(fileExt) != wstring::npos) {
+							listOfFiles.push_back(iter->path().wstring());
+						}
+					}
+					catch (invalid_argument &e) {
+						error_code ec;
+						iter.increment(ec);
+					}
+				}
+
+				error_code ec;
+				// Increment the iterator to point to next entry in recursive iteration
+				iter.increment(ec);
+				if (ec) {
+					LogLine() << L"Error While Accessing : " << iter->path().wstring() << L" :: " << ec.message();
+				}
+			}
+
+		}
+	}
+	catch (system_error & e) {
+		LogLine() << L"Exception :: " << e.what();
+	}
+	return listOfFiles;
+}
+
+wstring strrep(wstring line, char from, char to) {
+	for (auto i = 0; i < line.size(); i++) {
+		if (char(line[i]) == char(from)) {
+			line[i] = to;
+		}
+	}
+	return line;
+}
+
+// replace all special characters with _ to avoid Tembo crash
+wstring validate_param_name(wstring raw_param_name) {
+	wstring param_name = raw_param_name;
+	param_name = strrep(param_name, '-', '_');
+	param_name = strrep(param_name, '(', '_');
+	param_name = strrep(param_name, ')', '_');
+	param_name = strrep(param_name, '!', '_');
+	param_name = strrep(param_name, '#', '_');
+	param_name = strrep(param_name, ',', '_');
+	param_name = strrep(param_name, '.', '_');
+	// if first char is _, remove it
+	if (param_name[0] == '_') {
+		param_name.erase(0, 1);
+	}
+	return param_name;
+}
+
+wstring construct_recipe(wstring report_template, wstring report_name, wstring project_name) {
+	return wstring(L"<Recipe><Name>Report Starter</Name>") +
+		L"<ApplyTemplate href=&quot;rcodes/apply_report_template_to_data." +
+		L"xsl&quot; enabled=&quot;true&quot;>" +
+		L"<param><name>generatePDF</name><value>true</value></param>" +
+		L"<param><name>reportTemplate</name><value>" + report_template + L"</value></param>" +
+		L"<param><name>reportName</name><value>" + report_name + L"</value></param>" +
+		L"<param><name>reportID</name><value /></param>" +
+		L"<param><name>d</name><value /></param>" +
+		L"<param><name>mapping</name><value /></param>" +
+		L"<param><name>index</name><value>" + project_name + L"</value></param>" +
+		L"<param><name>field</name><value>payload.*</value></param>" +
+		L"<param><name>filter</name><value><filters>" +
+		L"<filter><field>metaData.dataset_id</field><name>Dataset Id</name><filterType>MultiSelect</filterType><filterOperator /><filterUnit />" +
+		L"<filterValues><filterValue>$dataset_id$</filterValue></filterValues></filter>" +
+		L"<filter><field>metaData.data_object_type</field><name>Data Object Type</name><filterType>MultiSelect</filterType><filterOperator /><filterUnit />" +
+		L"<filterValues><filterValue>value</filterValue></filterValues></filter></filters></value></param>" +
+		L"<param><name>grouping</name><value /></param>" +
+		L"<param><name>query</name><value>{      &quot;query&quot" +
+		L";:{      &quot;bool&quot;: {      &quot;must&quot; :" +
+		L"[            ]      }      }      }</value></param></ApplyTemplate></Recipe>";
+}
+
+int check_data_type(mxArray *cellArrayData) {
+	// check the type of current cell. Possible: [], NaN, string, double
+	// need different function to read different type of data, so we have to know what the type it is 
+	// 1: []; 2:string; 3:NaN; number:double
+	int return_value = 0;
+	try {
+		double *double_pointer = (double*)mxGetDoubles(cellArrayData);
+		if (double_pointer == NULL)
+			throw("current cell is string.");
+		if (isnan(*double_pointer)) {
+			return_value = 3;
+		}
+		else {
+			return_value = 4;
+		}
+	}
+	catch (...) {
+		string *string_pointer = (string*)mxGetPr(cellArrayData);
+		if (string_pointer == NULL) {
+			return_value = 1;
+		}
+		else {
+			return_value = 2;
+		}
+	}
+	return return_value;
+}
+
+wstring mat_read_string(const mxArray *cellArrayData) {
+	char pr[500];
+	mwSize len;
+	string string_middle;
+	wstring out_wstring;
+	mwSize num = mxGetNumberOfElements(cellArrayData);
+	int res = mxGetString(cellArrayData, pr, num + 1);
+	string_middle = pr;
+	out_wstring = std::wstring_convert<std::codecvt_utf8<wchar_t>>().from_bytes(string_middle);
+	return out_wstring;
+}
+
+wstring mat_read_double(mxArray *cellArrayData) {
+	double out_double;
+	double *double_pointer = (double*)mxGetDoubles(cellArrayData);
+	out_double = *double_pointer;
+	return to_wstring(out_double);
+}
+
+// shortest text which reads back to the same double, used for limits to keep all digits
+wstring mat_read_double_exact(mxArray *cellArrayData) {
+	double out_double;
+	double *double_pointer = (double*)mxGetDoubles(cellArrayData);
+	out_double = *double_pointer;
+	return UnitScaling::format_double(out_double);
+}
+
+// row_array_data___deviation: add #row elements to get the next element along current row
+// col_array_data___num_iteration: iterate through #col times
+// exact_doubles: read doubles with all digits (limits) instead of to_wstring
+vector<wstring> get_whole_row_test_data(mxArray *pMxArrayData, vector<wstring> single_row, int current_row, int deviation, int num_iteration, bool exact_doubles = false) {
+	// have to invoke char_to_wstring
+	for (auto i = 0; i < num_iteration; i++) {
+		wstring cell_element{};
+		mxArray *cellArrayData = NULL;
+		int index = current_row + deviation * i;
+		cellArrayData = mxGetCell(pMxArrayData, index);
+		int type_indicator_int = check_data_type(cellArrayData);
+		// type of current cell is []
+		if (type_indicator_int == 1) {
+			cell_element = L"";
+		}
+		// type of current cell is NaN
+		else if (type_indicator_int == 3) {
+			cell_element = L"NaN";
+		}
+		// type of current cell is string
+		else if (type_indicator_int == 2) {
+			cell_element = mat_read_string(cellArrayData);
+		}
+		// type of current cell is double
+		else if (exact_doubles) {
+			cell_element = mat_read_double_exact(cellArrayData);
+		}
+		else {
+			cell_element = mat_read_double(cellArrayData);
+		}
+		single_row.push_back(cell_element);
+	}
+	return single_row;
+}
+
+// prints depth and stall times of a pipeline queue
+void print_queue_stats(const wchar_t* queue_name, const QueueStats& stats) {
+	LogLine() << L"Pipeline " << queue_name << L": " << stats.pushed << L" items, max depth " << stats.max_depth << L"/" << stats.capacity <<
+		L", producer stalls " << stats.producer_stalls << L" (" << stats.producer_stall_ms << L" ms)" <<
+		L", consumer stalls " << stats.consumer_stalls << L" (" << stats.consumer_stall_ms << L" ms)";
+}
+
+// decodes one subset into a SubsetTable. Runs on the thread owning the .mat file, because the mx API is not thread safe
+// cells are formatted like get_whole_row_test_data, limit rows (#usl, #lsl) with all digits
+shared_ptr<SubsetTable> decode_subset(mxArray *pMxArrayData, int subset_index) {
+	lock_guard<mutex> lock(mat_api_mutex);
+	shared_ptr<SubsetTable> table = make_shared<SubsetTable>();
+	mxArray *pMxArrayDataSubset = mxGetField(pMxArrayData, subset_index, "data");
+	table->id = mat_read_string(mxGetField(pMxArrayData, subset_index, "id"));
+	LogLine() << "dimension of data structure:" << mxGetM(pMxArrayDataSubset) << "___" << mxGetN(pMxArrayDataSubset);
+
+	int row_array_data = mxGetM(pMxArrayDataSubset);
+	int col_array_data = mxGetN(pMxArrayDataSubset);
+	for (int row_index = 0; row_index < row_array_data; row_index++) {
+		mxArray *cellArrayData = mxGetCell(pMxArrayDataSubset, row_index);
+		// type_indicator_int: indicates whether it is #variables or test data
+		int type_indicator_int = (cellArrayData == NULL) ? 1 : check_data_type(cellArrayData);
+		if (type_indicator_int == 2) {
+			// header row, limits are read with all digits
+			wstring type_indicator_ws = mat_read_string(cellArrayData);
+			bool exact_doubles = type_indicator_ws.find(L"#FIELD") == wstring::npos &&
+				(type_indicator_ws.find(L"#usl") != wstring::npos || type_indicator_ws.find(L"#lsl") != wstring::npos);
+			vector<wstring> header_row = get_whole_row_test_data(pMxArrayDataSubset, vector<wstring>(), row_index, row_array_data, col_array_data, exact_doubles);
+			for (const wstring& cell_element : header_row) {
+				table->add_cell(cell_element);
+			}
+		}
+		else {
+			// test data row, formatted like to_wstring without a heap wstring per cell
+			for (int i = 0; i < col_array_data; i++) {
+				mxArray *cellElement = mxGetCell(pMxArrayDataSubset, row_index + row_array_data * i);
+				int cell_type = check_data_type(cellElement);
+				// type of current cell is NaN
+				if (cell_type == 3) {
+					table->add_cell(L"NaN", 3);
+				}
+				// type of current cell is string
+				else if (cell_type == 2) {
+					table->add_cell(mat_read_string(cellElement));
+				}
+				// type of current cell is double
+				else if (cell_type != 1) {
+					wchar_t buffer[400];
+					int length = swprintf(buffer, 400, L"%f", *(double*)mxGetDoubles(cellElement));
+					table->add_cell(buffer, length > 0 ? length : 0);
+				}
+				// type of current cell is []
+				else {
+					table->add_cell(L"", 0);
+				}
+			}
+		}
+		table->end_row((SubsetRowType)type_indicator_int);
+	}
+	return table;
+}
+
+// copies a decoded test data row into the row arena of single_row
+void read_row_test_data(const SubsetTable& table, int current_row, arena_wstring_vector& single_row) {
+	int num_iteration = table.col_count(current_row);
+	single_row.reserve(single_row.size() + num_iteration);
+	for (auto i = 0; i < num_iteration; i++) {
+		size_t length;
+		const wchar_t* text = table.cell(current_row, i, &length);
+		single_row.emplace_back(text, text + length);
+	}
+}
+
+// conditions of all test data rows of a subset for get_candidate_files: parent folder and name=value[ of every condition column
+// built like file_match_conditions of a row, a condition repeated within a row is kept as often as in the row repeating it most
+arena_wstring_vector collect_subset_conditions(const SubsetTable& table, const wstring& parent_folder, MonotonicArena& arena) {
+	vector<wstring> field;
+	vector<wstring> usl;
+	vector<wstring> lsl;
+	vector<wstring> unit_meta;
+	vector<wstring> name;
+	map<wstring, int> condition_counts;
+	for (int row_index = 0; row_index < table.row_count(); row_index++) {
+		if (table.row_type(row_index) == ROW_HEADER) {
+			// same header rows as in the build stage
+			wstring type_indicator_ws = table.cell_string(row_index, 0);
+			if (type_indicator_ws.find(L"#FIELD") != wstring::npos) {
+				table.append_row(row_index, field);
+			}
+			else if (type_indicator_ws.find(L"#usl") != wstring::npos) {
+				table.append_row(row_index, usl);
+			}
+			else if (type_indicator_ws.find(L"#lsl") != wstring::npos) {
+				table.append_row(row_index, lsl);
+			}
+			else if (type_indicator_ws.find(L"#unit") != wstring::npos) {
+				table.append_row(row_index, unit_meta);
+			}
+			else if (type_indicator_ws.find(L"#name") != wstring::npos) {
+				table.append_row(row_index, name);
+			}
+			continue;
+		}
+		map<wstring, int> row_counts;
+		int col_array_data = table.col_count(row_index);
+		for (int current_col = 0; current_col < col_array_data && current_col < (int)name.size() && current_col < (int)field.size(); current_col++) {
+			if (name[current_col].empty() || field[current_col].compare(L"cond") != 0) {
+				continue;
+			}
+			wstring value = table.cell_string(row_index, current_col);
+			// empty temperature is taken as 0
+			if (value.empty() && convert_to_lower(name[current_col]).compare(L"tambient") == 0) {
+				value = L"0";
+			}
+			row_counts[name[current_col] + L"=" + value + L"["]++;
+		}
+		for (map<wstring, int>::value_type& row_count : row_counts) {
+			int& subset_count = condition_counts[row_count.first];
+			subset_count = max(subset_count, row_count.second);
+		}
+	}
+	arena_wstring_vector subset_conditions(arena.allocator<arena_wstring>());
+	subset_conditions.emplace_back(parent_folder.begin(), parent_folder.end());
+	for (map<wstring, int>::value_type& condition_count : condition_counts) {
+		for (int i = 0; i < condition_count.second; i++) {
+			subset_conditions.emplace_back(condition_count.first.begin(), condition_count.first.end());
+		}
+	}
+	return subset_conditions;
+}
+
+// writes the conditions, outputs and limits of a subset to its sheet, test data rows beyond the rows of a sheet continue on another one
+// one row per test data row below the WORKBOOK_HEADER_ROWS header rows, outputs are named by their test name
+void write_subset_sheets(XlsxWriter& workbook, const SubsetTable& table, const LimitsCatalog& limits) {
+	vector <wstring> field;
+	vector <wstring> name;
+	vector <wstring> unit_meta;
+	vector <wstring> usl;
+	vector <wstring> lsl;
+	for (int row_index = 0; row_index < table.row_count(); row_index++) {
+		if (table.row_type(row_index) != ROW_HEADER) {
+			continue;
+		}
+		wstring type_indicator_ws = table.cell_string(row_index, 0);
+		if (type_indicator_ws.find(L"#FIELD") != wstring::npos) {
+			table.append_row(row_index, field);
+		}
+		else if (type_indicator_ws.find(L"#usl") != wstring::npos) {
+			table.append_row(row_index, usl);
+		}
+		else if (type_indicator_ws.find(L"#lsl") != wstring::npos) {
+			table.append_row(row_index, lsl);
+		}
+		else if (type_indicator_ws.find(L"#unit") != wstring::npos) {
+			table.append_row(row_index, unit_meta);
+		}
+		else if (type_indicator_ws.find(L"#name") != wstring::npos) {
+			table.append_row(row_index, name);
+		}
+	}
+	vector<int> columns;
+	for (int col = 0; col < (int)name.size() && col < (int)field.size() && (int)columns.size() < XLSX_MAX_COLUMNS; col++) {
+		if (!name[col].empty() && (field[col] == L"cond" || field[col] == L"out" || field[col] == L"aux")) {
+			columns.push_back(col);
+		}
+	}
+	// limits in the unit of the column, from the #usl and #lsl rows of the subset or else from testlimits.txt
+	UnitScaling unit_scaling;
+	vector<wstring> lower_limits(columns.size());
+	vector<wstring> upper_limits(columns.size());
+	for (size_t i = 0; i < columns.size(); i++) {
+		int col = columns[i];
+		if (field[col] == L"cond") {
+			continue;
+		}
+		lower_limits[i] = (col < (int)lsl.size() && lsl[col] != L"NaN") ? lsl[col] : L"";
+		upper_limits[i] = (col < (int)usl.size() && usl[col] != L"NaN") ? usl[col] : L"";
+		const LimitEntry *limit = limits.find(validate_param_name(name[col]));
+		if (lower_limits[i].empty() && upper_limits[i].empty() && limit != NULL) {
+			// catalog limits are in the unit without prefix
+			int scale = get<0>(unit_scaling.get_unit_scale(col < (int)unit_meta.size() ? unit_meta[col] : L""));
+			lower_limits[i] = unit_scaling.scale_value(-scale, limit->lower_limit);
+			upper_limits[i] = unit_scaling.scale_value(-scale, limit->upper_limit);
+		}
+	}
+
+	auto begin_sheet = [&]() {
+		workbook.begin_sheet(table.id, WORKBOOK_HEADER_ROWS);
+		for (int col : columns) {
+			workbook.add_text(field[col] == L"cond" ? name[col] : validate_param_name(name[col]));
+		}
+		workbook.end_row();
+		for (int col : columns) {
+			workbook.add_text(field[col]);
+		}
+		workbook.end_row();
+		for (int col : columns) {
+			workbook.add_text(col < (int)unit_meta.size() ? unit_meta[col] : L"");
+		}
+		workbook.end_row();
+		for (const wstring& lower_limit : lower_limits) {
+			workbook.add_cell(lower_limit.data(), lower_limit.size());
+		}
+		workbook.end_row();
+		for (const wstring& upper_limit : upper_limits) {
+			workbook.add_cell(upper_limit.data(), upper_limit.size());
+		}
+		workbook.end_row();
+	};
+	begin_sheet();
+	for (int row_index = 0; row_index < table.row_count(); row_index++) {
+		if (table.row_type(row_index) == ROW_HEADER) {
+			continue;
+		}
+		if (workbook.sheet_full()) {
+			begin_sheet();
+		}
+		int col_count = table.col_count(row_index);
+		for (int col : columns) {
+			size_t length = 0;
+			const wchar_t* text = col < col_count ? table.cell(row_index, col, &length) : L"";
+			workbook.add_cell(text, length);
+		}
+		workbook.end_row();
+	}
+	workbook.end_sheet();
+}
+
+// columns of the Arrow file of a subset, one row per limit or value object
+struct SubsetArrowColumns {
+	int subset_id;
+	int data_object_type;
+	int test_name;
+	int test_number;
+	int idx;
+	// condition name -> column, numeric conditions are float64 columns
+	map<wstring, pair<int, ArrowColumnType>> conditions;
+	int value;
+	int unit;
+	int lower_limit;
+	int upper_limit;
+};
+
+// file name of a subset in the Arrow folder, chars Windows doesn't take in file names are replaced
+static wstring subset_file_name(const wstring& subset_id) {
+	wstring file_name = subset_id;
+	for (wchar_t& c : file_name) {
+		if (wcschr(L"\\/:*?\"<>|", c) != NULL) {
+			c = L'_';
+		}
+	}
+	return file_name;
+}
+
+// meta key of a cond column (e.g. cond_VIO)
+static wstring condition_key(const wstring& condition_name) {
+	wstring key_name = L"cond_" + condition_name;
+	if (key_name.compare(L"cond_vio") == 0) {
+		key_name = L"cond_VIO";
+	}
+	return key_name;
+}
+
+// condition columns of the Arrow file of a subset, from its cond columns, sorted by meta key
+// a condition column is float64 if all its test data cells are numbers, empty cells are nulls
+vector<pair<wstring, ArrowColumnType>> subset_arrow_conditions(const SubsetTable& table, int first_row, const vector<wstring>& field, const vector<wstring>& name) {
+	map<wstring, ArrowColumnType> condition_types;
+	for (int col = 0; col < (int)field.size() && col < (int)name.size(); col++) {
+		if (field[col].compare(L"cond") != 0 || name[col].empty()) {
+			continue;
+		}
+		bool numeric = true;
+		double number;
+		for (int row = first_row; row < table.row_count() && numeric; row++) {
+			size_t length = 0;
+			if (table.row_type(row) == ROW_HEADER || col >= table.col_count(row)) {
+				continue;
+			}
+			const wchar_t* text = table.cell(row, col, &length);
+			numeric = length == 0 || UnitScaling::parse_double(text, length, &number);
+		}
+		// a condition in two columns takes the value of the last one, it stays a number only if both are
+		wstring key_name = condition_key(name[col]);
+		map<wstring, ArrowColumnType>::iterator condition_type = condition_types.find(key_name);
+		if (condition_type == condition_types.end()) {
+			condition_types[key_name] = numeric ? ARROW_FLOAT64 : ARROW_DICTIONARY;
+		}
+		else if (!numeric) {
+			condition_type->second = ARROW_DICTIONARY;
+		}
+	}
+	return vector<pair<wstring, ArrowColumnType>>(condition_types.begin(), condition_types.end());
+}
+
+// adds the columns of a subset, conditions from subset_arrow_conditions
+SubsetArrowColumns add_subset_arrow_columns(ArrowFileWriter& arrow_file, const vector<pair<wstring, ArrowColumnType>>& conditions) {
+	SubsetArrowColumns columns;
+	columns.subset_id = arrow_file.add_column(L"subset_id", ARROW_DICTIONARY);
+	columns.data_object_type = arrow_file.add_column(L"data_object_type", ARROW_DICTIONARY);
+	columns.test_name = arrow_file.add_column(L"test_name", ARROW_DICTIONARY);
+	columns.test_number = arrow_file.add_column(L"test_number", ARROW_INT64);
+	columns.idx = arrow_file.add_column(L"idx", ARROW_INT64);
+	for (const pair<wstring, ArrowColumnType>& condition : conditions) {
+		columns.conditions[condition.first] = make_pair(arrow_file.add_column(condition.first, condition.second), condition.second);
+	}
+	columns.value = arrow_file.add_column(L"value", ARROW_FLOAT64);
+	columns.unit = arrow_file.add_column(L"unit", ARROW_DICTIONARY);
+	columns.lower_limit = arrow_file.add_column(L"lower_limit", ARROW_FLOAT64);
+	columns.upper_limit = arrow_file.add_column(L"upper_limit", ARROW_FLOAT64);
+	return columns;
+}
+
+// adds a row per object, value objects fill value, limit objects unit and limits
+// summary objects are left out, they don't fit the columns
+// returns the number of condition values without column or which aren't a number in a float64 column, they are left out
+unsigned long long add_subset_arrow_rows(ArrowFileWriter& arrow_file, const vector<DataObject>& objects, const wstring& subset_id, const SubsetArrowColumns& columns) {
+	unsigned long long dropped_values = 0;
+	double number;
+	for (const DataObject& object : objects) {
+		const wstring* data_object_type = object.find_meta(META_DATA_OBJECT_TYPE);
+		if (data_object_type != NULL && *data_object_type == L"summary") {
+			continue;
+		}
+		arrow_file.set_string(columns.subset_id, subset_id);
+		if (data_object_type != NULL) {
+			arrow_file.set_string(columns.data_object_type, *data_object_type);
+		}
+		// limit objects carry the test name as parameter_name
+		const wstring* test_name = object.find_meta(META_TEST_NAME);
+		if (test_name == NULL) {
+			test_name = object.find_meta(META_PARAMETER_NAME);
+		}
+		if (test_name != NULL) {
+			arrow_file.set_string(columns.test_name, *test_name);
+		}
+		const wstring* test_number = object.find_meta(META_TEST_NUMBER);
+		if (test_number != NULL && UnitScaling::parse_double(*test_number, &number)) {
+			arrow_file.set_int(columns.test_number, (long long)number);
+		}
+		const wstring* idx = object.find_meta(META_IDX);
+		if (idx != NULL && UnitScaling::parse_double(*idx, &number)) {
+			arrow_file.set_int(columns.idx, (long long)number);
+		}
+		object.for_each_meta([&](const wchar_t* key, const wstring& value) {
+			if (wcsncmp(key, L"cond_", 5) != 0) {
+				return;
+			}
+			map<wstring, pair<int, ArrowColumnType>>::const_iterator condition = columns.conditions.find(key);
+			if (condition == columns.conditions.end()) {
+				// cond_link_* are fields of every object, not conditions
+				if (MetaFields::field(key) == META_FIELD_COUNT) {
+					dropped_values++;
+				}
+				return;
+			}
+			if (condition->second.second == ARROW_DICTIONARY) {
+				arrow_file.set_string(condition->second.first, value);
+			}
+			else if (UnitScaling::parse_double(value, &number)) {
+				arrow_file.set_double(condition->second.first, number);
+			}
+			else if (!value.empty()) {
+				dropped_values++;
+			}
+		});
+		bool value_object = data_object_type != NULL && *data_object_type == L"value";
+		for (const pair<wstring, wstring>& payload : object.payload_fields()) {
+			if (value_object) {
+				if (test_name != NULL && payload.first == *test_name && UnitScaling::parse_double(payload.second, &number)) {
+					arrow_file.set_double(columns.value, number);
+				}
+			}
+			else if (payload.first == L"unit") {
+				arrow_file.set_string(columns.unit, payload.second);
+			}
+			else if (payload.first == L"lower_limit" && UnitScaling::parse_double(payload.second, &number)) {
+				arrow_file.set_double(columns.lower_limit, number);
+			}
+			else if (payload.first == L"upper_limit" && UnitScaling::parse_double(payload.second, &number)) {
+				arrow_file.set_double(columns.upper_limit, number);
+			}
+		}
+		arrow_file.end_row();
+	}
+	return dropped_values;
+}
+
+//bool CSVReader::csvs_to_json(vector<wstring> csv_files, map<wstring, map<wstring, wstring>> limits_struct, \
+							map<wstring, wstring> configs_struct, \
+							wstring out_folder_path, vector<wstring> png_files, vector<wstring> mat_files)
+map <wstring, wstring> construct_overall_meta_data(mxArray *pMxArrayMeta) {
+	LogLine() << "Start: Processing overall metadata ..................................................";
+
+	mxArray *pMxArrayMiddle = NULL;
+	mxArray *pMxArrayAssign = NULL;
+	wstring ws_assign;
+
+	map <wstring, wstring> overall_meta_data;
+	wstring username = L"";
+	wstring product_sales_code = L"";
+	wstring basic_type = L"";
+	wstring product_design_step = L"";
+	wstring package = L"";
+	wstring dut_id = L"";
+	wstring req_id = L"";
+	wstring description = L"";
+	wstring typical = L"";
+	//wstring test_number = L"";
+	// in meta.meas.Jama: api_id global_id
+	wstring api_id = L"";
+	wstring global_id = L"";
+	// need to be clerified where to find this one 
+	wstring test_program_name = L"";
+	wstring testunit_version = L"";
+	wstring email = L"";
+
+	wstring generator = L"";
+	wstring generator_version = L"";
+	wstring generator_domain = L"";
+	wstring simulator_name = L"";
+	wstring simulation_type = L"";
+	wstring netlist_label = L"";
+	
+	// construct ts_data_created
+	time_t theTime = time(NULL);
+	struct tm *aTime = localtime(&theTime);
+	int day = aTime->tm_mday;
+	int month = aTime->tm_mon + 1;
+	int year = aTime->tm_year + 1900;
+	bool month_one_digit = false;
+	bool day__one_digit = false;
+	if (month < 10)
+		month_one_digit = true;
+	if (day < 10)
+		day__one_digit = true;
+	wstring ts_data_created = to_wstring(year) + ((month_one_digit) ? to_wstring(0) : +L"") + to_wstring(month) + ((day__one_digit) ? to_wstring(0) : +L"") + to_wstring(day);
+	overall_meta_data[L"ts_data_created"] = ts_data_created;
+	// -----------------------------------------------start: get metadata from meta.dut-----------------------------------------------
+	
+	pMxArrayMiddle = mxGetField(pMxArrayMeta, 0, "dut");
+
+	pMxArrayAssign = mxGetField(pMxArrayMiddle, 0, "product_sales_code");
+	ws_assign = mat_read_string(pMxArrayAssign);
+	overall_meta_data[L"product_sales_code"] = ws_assign;
+
+	pMxArrayAssign = mxGetField(pMxArrayMiddle, 0, "basic_type");
+	ws_assign = mat_read_string(pMxArrayAssign);
+	overall_meta_data[L"basic_type"] = ws_assign;
+
+	pMxArrayAssign = mxGetField(pMxArrayMiddle, 0, "product_design_step");
+	ws_assign = mat_read_string(pMxArrayAssign);
+	overall_meta_data[L"product_design_step"] = ws_assign;
+
+	pMxArrayAssign = mxGetField(pMxArrayMiddle, 0, "package");
+	ws_assign = mat_read_string(pMxArrayAssign);
+	overall_meta_data[L"package"] = ws_assign;
+
+	pMxArrayAssign = mxGetField(pMxArrayMiddle, 0, "dut_id");
+	ws_assign = mat_read_string(pMxArrayAssign);
+	overall_meta_data[L"dut_id"] = ws_assign;
+	
+	// -----------------------------------------------end: get metadata from meta.dut-----------------------------------------------
+
+	// -----------------------------------------------start: get metadata from meta.meas----------------------------------------------
+	// need to evaluate how the dimension of the array. like here is 2, so name1 + name2
+	
+	pMxArrayMiddle = mxGetField(pMxArrayMeta, 0, "meas");
+
+	pMxArrayAssign = mxGetField(pMxArrayMiddle, 0, "user");
+	ws_assign = mat_read_string(pMxArrayAssign);
+	overall_meta_data[L"user"] = ws_assign;
+
+	pMxArrayAssign = mxGetField(pMxArrayMiddle, 0, "user_name");
+	ws_assign = mat_read_string(pMxArrayAssign);
+	overall_meta_data[L"username"] = ws_assign;
+
+	//overall_meta_data[L"user"] = overall_meta_data[L"username"];
+
+	pMxArrayAssign = mxGetField(pMxArrayMiddle, 0, "user_email_address");
+	ws_assign = mat_read_string(pMxArrayAssign);
+	overall_meta_data[L"email"] = ws_assign;
+
+	/*
+	pMxArrayAssign = mxGetField(pMxArrayMiddle, 0, "Jama");
+	pMxArrayAssign = mxGetField(pMxArrayAssign, 0, "api_id");
+	ws_assign = mat_read_string(pMxArrayAssign);
+	overall_meta_data[L"api_id"] = ws_assign;
+
+	pMxArrayAssign = mxGetField(pMxArrayMiddle, 0, "Jama");
+	pMxArrayAssign = mxGetField(pMxArrayAssign, 0, "global_id");
+	ws_assign = mat_read_string(pMxArrayAssign);
+	overall_meta_data[L"global_id"] = ws_assign;
+	*/
+	pMxArrayAssign = mxGetField(pMxArrayMiddle, 0, "Jama");
+	pMxArrayAssign = mxGetField(pMxArrayAssign, 0, "a");
+	pMxArrayAssign = mxGetField(pMxArrayAssign, 0, "api_id");
+	ws_assign = mat_read_string(pMxArrayAssign);
+	overall_meta_data[L"api_id"] = ws_assign;
+
+	pMxArrayAssign = mxGetField(pMxArrayMiddle, 0, "Jama");
+	pMxArrayAssign = mxGetField(pMxArrayAssign, 0, "a");
+	pMxArrayAssign = mxGetField(pMxArrayAssign, 0, "global_id");
+	ws_assign = mat_read_string(pMxArrayAssign);
+	overall_meta_data[L"global_id"] = ws_assign;
+
+
+	
+	// -----------------------------------------------end: get metadata from meta.meas---------------------------------------------
+
+	// -----------------------------------------------start: get metadata from meta.sw-----------------------------------------------
+	// need to evaluate how the dimension of the array. like here is 2, so name1 + name2
+	// mxGetN(pMxArrayMiddle) is 2
+	pMxArrayMiddle = mxGetField(pMxArrayMeta, 0, "sw");
+
+	/*
+	// check the dimension of meta.sw dynamically 
+	int dimension_sw = mxGetN(pMxArrayMiddle);
+	for (int i = 0; i < dimension_sw; i++) {
+		pMxArrayAssign = mxGetField(pMxArrayMiddle, i, "name");
+		ws_assign = mat_read_string(pMxArrayAssign);
+		overall_meta_data[L"sw_name" + to_wstring(i)] = ws_assign;
+	}
+	*/
+
+	const char *fieldname;
+
+	int nfields_sw = mxGetNumberOfFields(pMxArrayMiddle);
+	for (int i = 0; i < nfields_sw; i++) {
+		fieldname = mxGetFieldNameByNumber(pMxArrayMiddle, i);
+		LogLine() << "-------------------------crt fieldname in sw:" << fieldname;
+		pMxArrayAssign = mxGetField(pMxArrayMiddle, 0, fieldname);
+		pMxArrayAssign = mxGetField(pMxArrayAssign, 0, "name");
+		ws_assign = mat_read_string(pMxArrayAssign);
+		overall_meta_data[L"sw_name" + to_wstring(i)] = ws_assign;
+	}
+
+
+	/*
+	pMxArrayAssign = mxGetField(pMxArrayMiddle, 0, "name");
+	ws_assign = mat_read_string(pMxArrayAssign);
+	overall_meta_data[L"sw_name1"] = ws_assign;
+
+	pMxArrayAssign = mxGetField(pMxArrayMiddle, 1, "name");
+	ws_assign = mat_read_string(pMxArrayAssign);
+	overall_meta_data[L"sw_name2"] = ws_assign;
+	*/
+	// -----------------------------------------------end: get metadata from meta.sw-----------------------------------------------
+	overall_meta_data[L"testunit_version"] = L"1";
+
+	LogLine() << "-------------------------length of overall_meta_data:" << overall_meta_data.size();
+	for (map <wstring, wstring> ::value_type& iter : overall_meta_data) {
+		LogLine() << iter.first << ":" << iter.second;
+	}
+
+	LogLine() << "End: Processing overall metadata ..................................................";
+	return overall_meta_data;
+}
+// used for test
+map <wstring, wstring> hardcode_overall_metadata() {
+	map <wstring, wstring> overall_meta_data;
+	overall_meta_data[L"username"] = L"Xing Jin";
+	overall_meta_data[L"basic_type"] = L"S1234";
+	overall_meta_data[L"product_sales_code"] = L"TLS1234";
+	overall_meta_data[L"product_design_step"] = L"A21";
+	overall_meta_data[L"package"] = L"TSON10";
+	overall_meta_data[L"dut_id"] = L"1";
+	//test_program_name get from name of right click 
+	overall_meta_data[L"test_program_name"] = L".matTest";
+	overall_meta_data[L"testunit_version"] = L"1";
+	overall_meta_data[L"api_id"] = L"923";
+	overall_meta_data[L"global_id"] = L"GID942";
+	overall_meta_data[L"email"] = L"Jin.Xing@infineon.com";
+
+	// construct ts_data_created
+	time_t theTime = time(NULL);
+	struct tm *aTime = localtime(&theTime);
+	int day = aTime->tm_mday;
+	int month = aTime->tm_mon + 1;
+	int year = aTime->tm_year + 1900;
+	bool month_one_digit = false;
+	bool day__one_digit = false;
+	if (month < 10)
+		month_one_digit = true;
+	if (day < 10)
+		day__one_digit = true;
+	wstring ts_data_created = to_wstring(year) + ((month_one_digit) ? to_wstring(0) : +L"") + to_wstring(month) + ((day__one_digit) ? to_wstring(0) : +L"") + to_wstring(day);
+	overall_meta_data[L"ts_data_created"] = ts_data_created;
+
+	return overall_meta_data;
+}
+
+// will be called within test_data_reader
+map <wstring, wstring> construct_common_meta_data(map <wstring, wstring> overall_meta_data) {
+	map <wstring, wstring> common_meta_data;
+
+	common_meta_data[L"basic_type"] = overall_meta_data[L"basic_type"];
+	common_meta_data[L"product_design_step"] = overall_meta_data[L"product_design_step"];
+	common_meta_data[L"product_sales_code"] = overall_meta_data[L"product_sales_code"];
+	common_meta_data[L"ts_data_created"] = overall_meta_data[L"ts_data_created"];
+	common_meta_data[L"generator"] = L"C++";
+	common_meta_data[L"generator_version"] = L"V11";
+	common_meta_data[L"generator_domain"] = L"CV";
+	common_meta_data[L"simulator_name"] = L"simulator";
+	common_meta_data[L"simulation_type"] = L"type";
+	common_meta_data[L"data_object_type"] = L"value";
+	common_meta_data[L"data_object_type_version"] = L"1";
+	common_meta_data[L"netlist_label"] = L"netlist_label";
+	common_meta_data[L"user_name"] = overall_meta_data[L"username"];
+	common_meta_data[L"user_email_address"] = overall_meta_data[L"email"];
+
+	return common_meta_data;
+}
+
+// objects of a subset (or of a batch of a spilled subset) on the way from the build to the render stage
+struct BuiltChunk {
+	vector<DataObject> objects;
+	// JSON of a subset taken from the subset cache, objects is empty then
+	shared_ptr<wstring> cached_json;
+	// the rendered JSON is stored in the subset cache under this key, 0 if it is not stored
+	unsigned long long cache_key;
+	// last chunk of the subset, carries the repetition summary lines of the cache entry
+	bool subset_complete;
+	vector<wstring> repetition_lines;
+	// id of the subset, names its Arrow file
+	wstring subset_id;
+	// condition columns of its Arrow file (meta key, type)
+	vector<pair<wstring, ArrowColumnType>> arrow_conditions;
+
+	BuiltChunk() : cache_key(0), subset_complete(false) {}
+};
+
+// JSON of a subset (or of a batch of a spilled subset) on the way from the render to the write stage
+struct RenderedChunk {
+	shared_ptr<wstring> json;
+	// last chunk of the subset, the subset is committed to the checkpoint once it is written
+	bool subset_complete;
+	vector<wstring> repetition_lines;
+
+	RenderedChunk() : subset_complete(false) {}
+};
+
+// hash of the inputs of a conversion, an interrupted conversion is only continued for the same inputs
+// ts_data_created changes every day, the memory budget and the workbook export do not change the JSON, they are left out
+// the Arrow export stays in: a resumed conversion doesn't write the Arrow files of the subsets before the resume point again
+// capture_files: the .mat file, or all CSV files of the capture
+unsigned long long input_fingerprint(const vector<wstring>& capture_files, map<wstring, wstring> configs_struct, const LimitsCatalog& limits, map<wstring, wstring> overall_meta_data,
+	const vector<wstring>& png_files, const vector<wstring>& mat_wfm_files) {
+	ContentHash hash(SUBSET_CACHE_VERSION);
+	error_code error;
+	for (const wstring& capture_file : capture_files) {
+		hash.update(capture_file);
+		hash.update((unsigned long long)filesys::file_size(capture_file, error));
+		hash.update((unsigned long long)filesys::last_write_time(capture_file, error).time_since_epoch().count());
+	}
+	configs_struct.erase(L"MemoryBudgetMB");
+	configs_struct.erase(L"ExcelExport");
+	for (map<wstring, wstring>::value_type& config : configs_struct) {
+		hash.update(config.first);
+		hash.update(config.second);
+	}
+	overall_meta_data.erase(L"ts_data_created");
+	for (map<wstring, wstring>::value_type& meta : overall_meta_data) {
+		hash.update(meta.first);
+		hash.update(meta.second);
+	}
+	hash.update(limits.fingerprint());
+	for (const wstring& png_file : png_files) {
+		hash.update(png_file);
+	}
+	hash.update((unsigned long long)png_files.size());
+	for (const wstring& mat_wfm_file : mat_wfm_files) {
+		hash.update(mat_wfm_file);
+	}
+	return hash.digest();
+}
+
+// name part of the cache directory and the checkpoint of a capture, captures of one 50_Report folder must not share them
+// capture_file: the .mat file or the first CSV file, paths are compared without case as on Windows
+wstring capture_key(const wstring& capture_file) {
+	ContentHash hash;
+	hash.update(convert_to_lower(capture_file));
+	return ContentHash::to_hex(hash.digest());
+}
+
+// limit as number for statistics and limit check, NaN if it is empty or not a finite number
+static double column_limit(const wstring& text) {
+	double limit;
+	if (!UnitScaling::parse_double(text, &limit) || !isfinite(limit)) {
+		return numeric_limits<double>::quiet_NaN();
+	}
+	return limit;
+}
+
+// pass also meta data
+// staging_json_path: if not empty, the JSON is written there as well (staging area on another filesystem)
+// checkpoint: progress is committed per subset, a resumable checkpoint continues after its last subset (NULL for none)
+// capture: subsets of a .mat file or of CSV files, decoded one after the other on this thread
+bool test_data_reader(const SubsetSource& capture, map <wstring, wstring> overall_meta_data, map <wstring, wstring> configs_struct, const LimitsCatalog& limits, wstring out_folder_path, wstring path_mat_data, vector<wstring> png_files, vector<wstring> mat_wfm_files, wstring staging_json_path, ConversionCheckpoint* checkpoint) {
+	LogLine() << "Start: Processing Test Data ..................................................";
+	
+	DataReader dr;
+	// define header struct
+	map<wstring, wstring> header_struct;
+	header_struct[L"version"] = L"1.0.1";
+
+	// build common_meta_data based on overall_meta_data
+	map <wstring, wstring> common_meta_data = construct_common_meta_data(overall_meta_data);
+
+	// meta data shared by all value objects of this run, objects only keep their own fields
+	shared_ptr<MetaTemplate> value_run_template = MetaTemplate::derive(shared_ptr<const MetaTemplate>());
+	value_run_template->set_meta(META_DATA_OBJECT_TYPE, L"value");
+	value_run_template->set_meta(META_DUT_ID, overall_meta_data[L"dut_id"]);
+	value_run_template->set_meta(META_PACKAGE, overall_meta_data[L"package"]);
+	value_run_template->set_meta(META_USER_NAME, overall_meta_data[L"username"]);
+	value_run_template->set_meta(META_TEST_PROGRAM_NAME, overall_meta_data[L"test_program_name"]);
+	value_run_template->set_meta(META_TEST_PROGRAM_REVISION, overall_meta_data[L"testunit_version"]);
+	value_run_template->set_meta(META_RDDF_TC_ID, overall_meta_data[L"api_id"] + L":" + overall_meta_data[L"global_id"]);
+	// meta data shared by all limit objects of this run
+	shared_ptr<const MetaTemplate> limit_meta_template = dr.construct_limit_meta_template(common_meta_data);
+	shared_ptr<const MetaTemplate> summary_meta_template = dr.construct_summary_meta_template(common_meta_data);
+
+	// repetition summary of all subsets, written next to the JSON
+	vector<wstring> repetition_summary;
+	wstring json_path = out_folder_path + L"\\" + configs_struct[L"ReportName"] + L".json";
+	// subsets already in the JSON of an interrupted conversion, they are neither decoded nor written again
+	int resume_subsets = 0;
+	if (checkpoint != NULL && checkpoint->resume()) {
+		resume_subsets = checkpoint->committed_subsets();
+		repetition_summary = checkpoint->repetition_lines();
+		// anything written after the last committed subset is incomplete
+		filesys::resize_file(json_path, checkpoint->json_bytes());
+		// the staging copy can't be continued, main stages the JSON once it is complete
+		staging_json_path = L"";
+		LogLine() << L"Resuming after subset " << resume_subsets << L" at byte " << checkpoint->json_bytes() << L" of " << json_path;
+	}
+
+	// subsets run through a pipeline, so decoding of subset N+1 overlaps building and rendering of subset N:
+	// decode subset (this thread, owns the capture) -> build objects -> render JSON -> write
+	// the bounded queues between the stages give back-pressure, only a few subsets are in memory at a time
+	SpscQueue<shared_ptr<SubsetTable>> decoded_subsets(PIPELINE_QUEUE_CAPACITY);
+	SpscQueue<shared_ptr<BuiltChunk>> built_subsets(PIPELINE_QUEUE_CAPACITY);
+	SpscQueue<shared_ptr<RenderedChunk>> rendered_chunks(PIPELINE_QUEUE_CAPACITY);
+	// decoded subsets are also handed to the workbook stage if Excel export is on
+	SpscQueue<shared_ptr<SubsetTable>> workbook_subsets(PIPELINE_QUEUE_CAPACITY);
+	// rendered chunks are also handed to the Arrow stage if Arrow export is on, it reports each complete subset back to the writer
+	SpscQueue<shared_ptr<BuiltChunk>> arrow_chunks(PIPELINE_QUEUE_CAPACITY);
+	SpscQueue<int> arrow_subsets(PIPELINE_QUEUE_CAPACITY);
+	// first error of any stage, all queues are cancelled then and the error is thrown after the stages are joined
+	exception_ptr pipeline_error;
+	mutex pipeline_error_mutex;
+	auto cancel_pipeline = [&](exception_ptr error) {
+		lock_guard<mutex> lock(pipeline_error_mutex);
+		if (!pipeline_error) {
+			pipeline_error = error;
+		}
+		decoded_subsets.cancel();
+		built_subsets.cancel();
+		rendered_chunks.cancel();
+		workbook_subsets.cancel();
+		arrow_chunks.cancel();
+		arrow_subsets.cancel();
+	};
+
+	// value objects of a subset kept in memory before they are spilled, 0 for no limit
+	size_t memory_budget = (size_t)(wcstod(configs_struct[L"MemoryBudgetMB"].c_str(), NULL) * 1024 * 1024);
+	wstring spill_prefix = out_folder_path + L"\\" + configs_struct[L"ReportName"] + L"_spill_";
+
+	// conditions, outputs and limits of every subset as a sheet of an Excel workbook next to the JSON
+	wstring workbook_path = out_folder_path + L"\\" + configs_struct[L"ReportName"] + L".xlsx";
+	unique_ptr<XlsxWriter> workbook;
+	if (convert_to_lower(configs_struct[L"ExcelExport"]) == L"on") {
+		workbook.reset(new XlsxWriter(workbook_path));
+		if (!workbook->is_open()) {
+			workbook.reset();
+		}
+	}
+
+	// limit and value objects of every subset as an Arrow IPC file (Feather V2) in a folder next to the JSON
+	wstring arrow_folder_path = out_folder_path + L"\\" + configs_struct[L"ReportName"] + L"_arrow";
+	bool arrow_export = convert_to_lower(configs_struct[L"ArrowExport"]) == L"on";
+	if (arrow_export) {
+		error_code create_error;
+		filesys::create_directories(arrow_folder_path, create_error);
+	}
+
+	// mean, sigma, min, max, Cpk and percentiles of every out parameter per subset and condition group, as summary objects after the value objects
+	bool parameter_statistics = convert_to_lower(configs_struct[L"ParameterStatistics"]) == L"on";
+	// pass/fail of every out value against the limits of its parameter, fail counts per parameter as summary objects
+	bool limit_check = convert_to_lower(configs_struct[L"LimitCheck"]) == L"on";
+
+	// rendered subsets of earlier runs of this capture, kept next to 50_Report
+	wstring report_folder_path = out_folder_path.substr(0, out_folder_path.find_last_of(L"\\"));
+	SubsetCache subset_cache(report_folder_path + L"_cache\\" + capture_key(path_mat_data), convert_to_lower(configs_struct[L"SubsetCache"]) != L"off");
+	// part of the cache key shared by all subsets: meta data, limits and the .mat path end up in the JSON of every subset
+	ContentHash run_hash(SUBSET_CACHE_VERSION);
+	for (map<wstring, wstring>::value_type& meta : overall_meta_data) {
+		run_hash.update(meta.first);
+		run_hash.update(meta.second);
+	}
+	for (map<wstring, wstring>::value_type& meta : common_meta_data) {
+		run_hash.update(meta.first);
+		run_hash.update(meta.second);
+	}
+	run_hash.update(limits.fingerprint());
+	run_hash.update(path_mat_data);
+	// summary objects are part of the cached JSON
+	run_hash.update(configs_struct[L"ParameterStatistics"]);
+	run_hash.update(configs_struct[L"StatisticsConditions"]);
+	run_hash.update(configs_struct[L"StatisticsQuantiles"]);
+	run_hash.update(configs_struct[L"LimitCheck"]);
+	unsigned long long run_cache_key = run_hash.digest();
+
+	// the stage threads report to the listener of this conversion
+	const LogSink* log_listener = current_log_listener();
+
+	// stage: build limit and value objects of each subset
+	thread build_thread([&]() {
+		LogListenerScope listener_scope(log_listener);
+		try {
+			int subset_count = 0;
+			ParameterStatistics statistics(configs_struct[L"StatisticsConditions"], configs_struct[L"StatisticsQuantiles"]);
+			LimitEvaluator limit_evaluator;
+			shared_ptr<SubsetTable> decoded_subset;
+			while (decoded_subsets.pop(decoded_subset)) {
+				int test_data_rows = 0;
+				const SubsetTable& subset_table = *decoded_subset;
+				const wstring& ws_id = subset_table.id;
+				int row_array_data = subset_table.row_count();
+				// limit and value objects of this subset, handed to the renderer as a whole (in batches if spilled)
+				vector<DataObject> data_objects;
+
+				//!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+				// define structure to keep repeated condition data for output
+				map<wstring, map<wstring, vector<int>>> repeated_conds;
+				bool cond_repetition = false;
+				// count occurences of each key_cond_str to assign _repN suffixes without scanning internal_json
+				RepetitionCounter repetition_counter;
+
+				wstring req_id = L"";
+				wstring description = L"";
+				wstring typical = L"";
+				wstring test_number = L"";
+
+				vector <wstring> column_types;
+				// column_types -> field
+				vector <wstring> field;
+				// new fields---begin
+				vector <wstring> tag;
+				vector <wstring> sbfields;
+				//vector <wstring> description;
+				// new fields---end
+				vector <wstring> usl;
+				vector <wstring> lsl;
+				// units -> unit
+				vector <wstring> unit_meta;
+				// variables -> name
+				vector <wstring> name;
+				vector <wstring> no_limit_match;
+				// scale, unit and scaled usl/lsl per column, computed once before the first test data row
+				bool limit_columns_scaled = false;
+				vector <int> unit_scales;
+				vector <wstring> units;
+				vector <wstring> scaled_usl;
+				vector <wstring> scaled_lsl;
+				// limits of each out column in the unit of the column (the unit of its values), NaN if not set, for statistics and limit check
+				vector <double> column_lsl;
+				vector <double> column_usl;
+				// condition columns of the Arrow file of the subset
+				vector<pair<wstring, ArrowColumnType>> arrow_conditions;
+				wstring type_indicator_ws;
+				int type_indicator_int;
+
+				// define struct to store unique out paramters(e.g.uniq('ibat_stb') = dummy_test_number)
+				// if there is no limit specified then test number will be added in increasing order for each
+				// unique parameter.
+				map <wstring, int> unique_params;
+				// keeps track of used test numbers to find the next free one without searching unique_params
+				TestNumberAllocator test_numbers;
+				// test numbers given by testlimits.txt must not be assigned to other parameters
+				for (int limit_test_number : limits.test_numbers()) {
+					test_numbers.reserve_catalog(limit_test_number);
+				}
+
+				// get parent folder name for png match
+				//wstring curr_file = L"C:\\Users\\XingJin\\Desktop\\matdata.mat";
+				wstring curr_file = path_mat_data;
+				wstring parent_folder = curr_file.substr(0, curr_file.find_last_of(L"\\") + 1);
+				// LogLine() << "Parent folder: " << parent_folder;
+				// per row temporaries (test data, comments, match conditions, matched files) are allocated here
+				// and released in one shot every ARENA_ROW_BATCH test data rows and when the subset is flushed
+				MonotonicArena row_arena;
+
+				// the JSON of a subset depends on the subset, the run and the png and waveform files its rows can match,
+				// new captures only change the key of subsets whose conditions they share
+				unsigned long long cache_key = 0;
+				if (subset_cache.is_enabled()) {
+					ContentHash subset_hash(run_cache_key);
+					subset_hash.update(subset_table.content_hash());
+					auto hash_files = [&subset_hash](const arena_wstring_vector& files) {
+						subset_hash.update((unsigned long long)files.size());
+						for (const arena_wstring& file : files) {
+							subset_hash.update(from_arena(file));
+						}
+					};
+					{
+						// conditions and candidates are arena temporaries, they are gone before the arena is released
+						arena_wstring_vector subset_conditions = collect_subset_conditions(subset_table, parent_folder, row_arena);
+						subset_conditions.emplace_back(L"Report-Picture");
+						hash_files(get_candidate_files(subset_conditions, png_files));
+						subset_conditions.back() = L"Report-waveform";
+						hash_files(get_candidate_files(subset_conditions, mat_wfm_files));
+					}
+					cache_key = subset_hash.digest();
+					row_arena.release();
+
+					shared_ptr<BuiltChunk> cached_chunk = make_shared<BuiltChunk>();
+					cached_chunk->cached_json = make_shared<wstring>();
+					cached_chunk->subset_complete = true;
+					// cached subsets come without objects, so the Arrow export builds every subset (and still fills the cache)
+					if (!arrow_export && subset_cache.lookup(cache_key, *cached_chunk->cached_json, cached_chunk->repetition_lines)) {
+						LogLine() << L"Subset " << ws_id << L" taken from subset cache";
+						repetition_summary.insert(repetition_summary.end(), cached_chunk->repetition_lines.begin(), cached_chunk->repetition_lines.end());
+						if (!built_subsets.push(cached_chunk)) {
+							break;
+						}
+						continue;
+					}
+				}
+
+				// meta data shared by all value objects of this subset
+				shared_ptr<MetaTemplate> subset_template = MetaTemplate::derive(value_run_template);
+				// get cond_link as path to the folder containing current file
+				subset_template->set_meta(META_COND_LINK_SCREENSHOTS, L"file:///" + strrep(curr_file.substr(0, curr_file.find_last_of(L"\\")), '\\', '/'));
+				subset_template->set_meta(META_COND_LINK_RAW_DATA, L"file:///" + strrep(curr_file.substr(0, curr_file.find_last_of(L"\\")), '\\', '/'));
+				// add subset id
+				subset_template->set_meta(META_SUBSET_ID, ws_id);
+
+				// iteratre through each csv file
+				// represents temp structure, where each fieldname is wstring combining
+				// unique conditions(e.g. "{cond_vio}{cond_vbat}")
+				// objects beyond the memory budget are spilled to sorted runs next to the JSON
+				ObjectSpillStore internal_json(memory_budget, spill_prefix + to_wstring(subset_count++), subset_template);
+
+				// start reading file
+				// iterate trough all rows of data cell 
+				for (int row_index = 0; row_index < row_array_data; row_index++) {
+					// type_indicator_int: indicates whether it is #variables or test data, given by the type of the first cell
+					type_indicator_int = subset_table.row_type(row_index);
+					int col_array_data = subset_table.col_count(row_index);
+
+					//current row is #variables
+					if (type_indicator_int == 2) {
+						// read the content of the current cell. return type is wstring
+						type_indicator_ws = subset_table.cell_string(row_index, 0);
+						//LogLine() << "String field:" << ws_middle;
+						//LogLine() << "address of char:" << static_cast<void *>(&pr);
+						if (type_indicator_ws.find(L"#FIELD") != wstring::npos) {
+							subset_table.append_row(row_index, field);
+						}
+						else if (type_indicator_ws.find(L"#usl") != wstring::npos) {
+							subset_table.append_row(row_index, usl);
+						}
+						else if (type_indicator_ws.find(L"#lsl") != wstring::npos) {
+							subset_table.append_row(row_index, lsl);
+						}
+						else if (type_indicator_ws.find(L"#unit") != wstring::npos) {
+							subset_table.append_row(row_index, unit_meta);
+						}
+						else if (type_indicator_ws.find(L"#name") != wstring::npos) {
+							subset_table.append_row(row_index, name);
+						}
+					}
+					//curent row is test data
+					else {
+						test_data_rows++;
+						// header rows are complete, scale limit rows of this subset once
+						if (!limit_columns_scaled) {
+							UnitScaling unit_scaling;
+							unit_scaling.get_unit_scale_column(unit_meta, &unit_scales, &units);
+							scaled_usl = unit_scaling.scale_column(usl, unit_scales);
+							scaled_lsl = unit_scaling.scale_column(lsl, unit_scales);
+							limit_columns_scaled = true;
+							if (arrow_export) {
+								arrow_conditions = subset_arrow_conditions(subset_table, row_index, field, name);
+							}
+							// the limit objects get the limits in the unit without prefix, the values keep the unit of the column
+							// #usl and #lsl rows are in the unit of the column, catalog limits are scaled back to it
+							if (parameter_statistics || limit_check) {
+								column_lsl.assign(field.size(), numeric_limits<double>::quiet_NaN());
+								column_usl.assign(field.size(), numeric_limits<double>::quiet_NaN());
+								for (int current_col = 0; current_col < (int)field.size() && current_col < (int)name.size(); current_col++) {
+									if (field[current_col].compare(L"out") != 0 || name[current_col].empty()) {
+										continue;
+									}
+									if (current_col < (int)lsl.size() && current_col < (int)usl.size() && !lsl[current_col].empty() && !usl[current_col].empty()) {
+										column_lsl[current_col] = column_limit(lsl[current_col]);
+										column_usl[current_col] = column_limit(usl[current_col]);
+									}
+									else {
+										const LimitEntry *limit = limits.find(validate_param_name(name[current_col]));
+										if (limit != NULL) {
+											int scale = current_col < (int)unit_scales.size() ? unit_scales[current_col] : 0;
+											column_lsl[current_col] = column_limit(unit_scaling.scale_value(-scale, limit->lower_limit));
+											column_usl[current_col] = column_limit(unit_scaling.scale_value(-scale, limit->upper_limit));
+										}
+									}
+								}
+							}
+							// compare the out columns of all test data rows with the limits in the unit of the column
+							if (limit_check) {
+								for (int current_col = 0; current_col < (int)column_lsl.size(); current_col++) {
+									limit_evaluator.evaluate_column(subset_table, row_index, current_col, column_lsl[current_col], column_usl[current_col]);
+								}
+							}
+						}
+						//curent row is test data
+						// vector<wstring> e.g.
+						arena_wstring_vector test_data(row_arena.allocator<arena_wstring>());
+						read_row_test_data(subset_table, row_index, test_data);
+						// conditions that will help to match corresponding png and .mat files for raw_data_link and waveform links
+						arena_wstring_vector file_match_conditions(row_arena.allocator<arena_wstring>());
+						// add first png file match condition to png_file_match_conditions
+						file_match_conditions.emplace_back(parent_folder.begin(), parent_folder.end());
+
+						//keyname is used for tracking the name of the current column( cond + out )
+						// key_name wstring (e.g. conv_VIO)
+						wstring key_name = L"";
+						// init meta data template of current row (conditions, idx), shared by all its value objects
+						shared_ptr<MetaTemplate> row_template = MetaTemplate::derive(subset_template);
+						// wstring containing combination of conditions
+						wstring cond_str = L"";
+						wstring key_cond_str = L"";
+						// readable combination of conditions for the repetition summary (e.g. tambient=25, VIO=3.3)
+						wstring cond_label = L"";
+						// conditions of the row which form the condition group of the statistics
+						vector<pair<wstring, wstring>> statistics_conditions;
+						// Start: scale, unit:might not be used 
+						int scale{};
+						wstring unit{};
+						wstring scaled_value{};
+						// End:scale, unit:might not be used 
+						arena_wstring_vector comments(row_arena.allocator<arena_wstring>());
+
+						// build cond_ metadata
+						for (int current_col = 0; current_col < col_array_data; current_col++) {
+							// another test is ignored since assume .mat is better formatted
+							// check if param name is not present skip column
+							if (name[current_col].empty()) {
+								continue;
+							}
+							// check if current column corresponds to parameter
+							if (field[current_col].compare(L"cond") == 0) {
+								// construct meta_data key name (e.g. conv_VIO)
+								// !!! most important one
+								key_name = condition_key(name[current_col]);
+								// handle special cases
+								if (convert_to_lower(key_name).compare(L"cond_tambient") == 0) {
+									// if temperature is empty, make it 0
+									if (test_data[current_col].empty()) {
+										LogLine() << L"TEMP IS EMPTY AT " << row_index;
+										test_data[current_col] = L"0";
+									}
+								}
+								// combine conditions
+								cond_str = cond_str + L"_" + from_arena(test_data[current_col]);
+								cond_str = cond_str + overall_meta_data[L"username"] + L"_" + overall_meta_data[L"basic_type"] + L"_" + overall_meta_data[L"product_sales_code"] + L"_" + overall_meta_data[L"product_design_step"] + L"_" +
+									overall_meta_data[L"package"] + L"_" + overall_meta_data[L"dut_id"];
+								if (!cond_label.empty()) {
+									cond_label += L", ";
+								}
+								cond_label += name[current_col] + L"=" + from_arena(test_data[current_col]);
+								// assign value to the right name
+								row_template->set_meta(key_name, from_arena(test_data[current_col]));
+								if (parameter_statistics && statistics.groups_by(name[current_col])) {
+									statistics_conditions.emplace_back(key_name, from_arena(test_data[current_col]));
+								}
+								// add each condition to the png_file_match_conditions with values. add [ as end of condition (e.g. vio=3[V])
+								file_match_conditions.emplace_back(name[current_col].begin(), name[current_col].end());
+								file_match_conditions.back() += L"=";
+								file_match_conditions.back() += test_data[current_col];
+								file_match_conditions.back() += L"[";
+							}
+							// check if current column corresponds to comment, except if variable is picture path or waveform path
+							if (convert_to_lower(field[current_col]).find(L"comment") != wstring::npos && name[current_col] != L"picture_path" && name[current_col] != L"wfm_path" &&
+								!test_data[current_col].empty()) {
+								comments.push_back(test_data[current_col]);
+							}
+						}
+						// Start:------------------------- distinguish waveform or data (mat)------------------------
+						/*
+						// since for now we use only folder name, it doesn't matter how many files matched. All of them are in the same folder
+						wstring matching_mat_filename{};
+						for (auto mat_file : mat_files) {
+						if (mat_file.find(parent_folder) != wstring::npos) {
+						matching_mat_filename = mat_file;
+						break;
+						}
+						}
+						// constuct proper cond_link_waveforms if matching mat file was found
+						if (!matching_mat_filename.empty()) {
+						// todo: uncomment this for cond_link_waveforms
+						// meta_data[l"cond_link_waveforms"] = l"file:///" + waveform_explorer_path + l" /k " + matching_mat_filename;
+						// meta_data[l"cond_link_waveforms"] = strrep(meta_data[l"cond_link_waveforms"], '\\', '/');
+						meta_data[l"cond_link_waveforms"] = l"file:///" + strrep(matching_mat_filename.substr(0, matching_mat_filename.find_last_of(l"\\")), '\\', '/');
+						}
+						*/
+						// End:------------------------- distinguish waveform or data (mat)------------------------
+						// row_array_data <--> line_count
+						repeated_conds[cond_str][curr_file].push_back(row_array_data);
+						if (parameter_statistics) {
+							statistics.set_row_conditions(statistics_conditions);
+						}
+
+						// iterate through each col again for the aux_sequenceNumber
+						// add sequence number for each test case 
+						for (int current_col = 0; current_col < col_array_data; current_col++) {
+							if (field[current_col].compare(L"aux") == 0 && name[current_col].compare(L"idx") == 0) {
+								row_template->set_meta(META_IDX, from_arena(test_data[current_col]));
+							}
+						}
+						// png and .mat files only depend on the conditions of the row, match them once for all out columns
+						bool row_files_matched = false;
+						arena_wstring_vector matching_png_files(row_arena.allocator<arena_wstring>());
+						arena_wstring_vector matching_mat_files(row_arena.allocator<arena_wstring>());
+
+						// iterate through each col again and for each out
+						// construct dataObject with payload + meta_data
+						for (int current_col = 0; current_col < col_array_data; current_col++) {
+							// another test is ignored since assume .mat is better formatted
+							// check if param name is not present skip column
+							if (name[current_col].empty()) {
+								continue;
+							}
+							if (field[current_col].compare(L"out") == 0 || field[current_col].compare(L"aux") == 0) {
+								if (name[current_col].compare(L"idx") == 0)
+									continue;
+								// skip if empty
+								if (test_data[current_col].empty()) {
+									continue;
+								}
+								// init record to keep payload and meta data
+								DataObject data_object;
+								// construct key_name from variables row, e.g. ibat_stb
+								key_name = name[current_col];
+								// validate key_name
+								key_name = validate_param_name(key_name);
+								// add out param name to keep param conds str separately
+								//keyname is used for tracking the name of the current column 
+								key_cond_str = key_name + cond_str;
+
+								scaled_value = from_arena(test_data[current_col]);
+								// !!!!!!!!!! add scale value to the variable of payload 
+								data_object.set_payload(key_name, scaled_value);
+								// save related png and mat waveforms 
+								// if there are matching png files save them to payload
+								if (!row_files_matched) {
+									file_match_conditions.emplace_back(L"Report-Picture");
+									matching_png_files = get_corresponding_files(file_match_conditions, png_files);
+									file_match_conditions.pop_back();
+
+									// get corresponding .mat files
+									file_match_conditions.emplace_back(L"Report-waveform");
+									matching_mat_files = get_corresponding_files(file_match_conditions, mat_wfm_files);
+									file_match_conditions.pop_back();
+									row_files_matched = true;
+								}
+
+								// save related png files to current payload
+								for (auto i = 0; i < matching_png_files.size(); i++) {
+									data_object.add_link(LINK_PNG, strrep(from_arena(matching_png_files[i]), '\\', '/'));
+								}
+
+								// save related .mat files
+								for (auto i = 0; i < matching_mat_files.size(); i++) {
+									data_object.add_link(LINK_MAT, strrep(from_arena(matching_mat_files[i]), '\\', '/'));
+								}
+					
+								// save related comments
+								for (auto i = 0; i < comments.size(); i++) {
+									data_object.add_comment(from_arena(comments[i]));
+								}
+
+								// other meta fields come from row, subset and run template
+								data_object.set_template(row_template);
+								data_object.set_meta(META_TEST_NAME, key_name);
+								// !!!!! import parameters limits
+								// add test number from limits if it exists, otherwise hardcode
+								const LimitEntry *limit = limits.find(key_name);
+								if (limit != NULL) {
+									// get test number from limits
+									data_object.set_meta(META_TEST_NUMBER, limit->test_number);
+								}
+								else {
+									// if limit doesn't exist, check if hardcoded test number already exists
+									if (unique_params.find(key_name) != unique_params.end()) {
+										// use already assigned test number
+										data_object.set_meta(META_TEST_NUMBER, to_wstring(unique_params[key_name]));
+									}
+									else if (unique_params.empty()) {
+										// first unique parameter. Add test number manually, counter is incremented with the limit
+										data_object.set_meta(META_TEST_NUMBER, to_wstring(test_numbers.skip_catalog()));
+									}
+									else {
+										// otherwise assign a new unique test number
+										// by moving the counter past the used test numbers
+										// to avoid overlap with test numbers from limits file
+										data_object.set_meta(META_TEST_NUMBER, to_wstring(test_numbers.advance()));
+									}
+								}
+
+
+								// if key_cond_str was already stored in internal_json, condition repetition occurred
+								// mark flag true to inform user
+								int rep_times = repetition_counter.record(key_cond_str, key_name, cond_label);
+								if (rep_times > 0) {
+									cond_repetition = true;
+									key_cond_str = key_cond_str + L"_rep" + to_wstring(rep_times);
+								}
+
+								if (parameter_statistics && field[current_col].compare(L"out") == 0) {
+									const wstring* value_test_number = data_object.find_meta(META_TEST_NUMBER);
+									statistics.add(key_name, value_test_number != NULL ? *value_test_number : L"", scaled_value);
+								}
+								LimitResult limit_result = limit_check ? limit_evaluator.result(row_index, current_col) : LIMIT_NOT_CHECKED;
+								if (limit_result != LIMIT_NOT_CHECKED) {
+									data_object.set_meta(L"limit_result", LIMIT_RESULT_NAMES[limit_result]);
+									const wstring* value_test_number = data_object.find_meta(META_TEST_NUMBER);
+									const wstring* idx = data_object.find_meta(META_IDX);
+									limit_evaluator.record(key_name, value_test_number != NULL ? *value_test_number : L"", limit_result, cond_label, idx != NULL ? *idx : L"");
+								}
+								// store current metaData and payload in internal_json
+								internal_json.put(key_cond_str, move(data_object));
+
+								// add structure for limit 594 -- 707
+								if (unique_params.find(key_name) == unique_params.end()) {
+									// create a data object for current limit, payload is set directly
+									DataObject limit_data_object;
+									if (!lsl.empty() && !usl.empty() && !lsl[current_col].empty() && !usl[current_col].empty()
+										&& current_col < lsl.size() && current_col < usl.size()) {
+										// unit and limits were scaled for the whole row, NaN limits are empty
+										// hardcode scale 0, because tembo does auto conversion
+										limit_data_object.set_payload(L"scale", L"0");
+										limit_data_object.set_payload(L"unit", units[current_col]);
+										limit_data_object.set_payload(L"lower_limit", scaled_lsl[current_col]);
+										limit_data_object.set_payload(L"upper_limit", scaled_usl[current_col]);
+
+										req_id = L"";
+										description = L"";
+										typical = L"";
+										test_number = to_wstring(test_numbers.current());
+										// LogLine() << L"Getting from USL: " << usl[current_col];
+									}
+									// limits is definded in the limit structure!
+									else if (limit != NULL) {
+										// limits from catalog are already scaled
+										// hardcode scale 0, because tembo does auto conversion
+										limit_data_object.set_payload(L"scale", L"0");
+										limit_data_object.set_payload(L"unit", limit->unit);
+										limit_data_object.set_payload(L"lower_limit", limit->lower_limit);
+										limit_data_object.set_payload(L"upper_limit", limit->upper_limit);
+
+										// add meta data from limit
+										req_id = limit->req_id;
+										description = limit->description;
+										typical = limit->typical;
+										test_number = limit->test_number;
+									}
+									else {
+										// use hardcoded limits
+										// get unit
+										limit_data_object.set_payload(L"unit", (current_col < (int)units.size()) ? units[current_col] : L"");
+										// hardcode scale to 0, because tembo does auto conversion
+										limit_data_object.set_payload(L"scale", L"0");
+
+										// get upper limit
+										// limit_payload["upper_limit"] = generate_limit_from_test_value(payload[key_name], true);
+
+										// get lower limit
+										// limit_payload["lower_limit"] = generate_limit_from_test_value(payload[key_name], false);
+
+										// Back to empty limits
+										limit_data_object.set_payload(L"upper_limit", L"");
+										limit_data_object.set_payload(L"lower_limit", L"");
+
+										req_id = L"";
+										description = L"";
+										typical = L"";
+										test_number = to_wstring(test_numbers.current());
+										// save no matches in txt
+										no_limit_match.push_back(key_name);
+									}
+									// construct limit meta data on top of the shared limit template
+									limit_data_object.set_template(limit_meta_template);
+									dr.set_limit_meta_data(limit_data_object, req_id, description, typical, test_number, key_name);
+									if (parameter_statistics && current_col < (int)column_lsl.size()) {
+										statistics.set_limits(key_name, column_lsl[current_col], column_usl[current_col]);
+									}
+									// add limit_data_object to data_objects
+									data_objects.push_back(move(limit_data_object));
+									// store unique out params to add limits
+									// check if it has defined limits or hard coded
+									if (limit != NULL && usl.empty() && lsl.empty() && limit->test_number_value >= 0) {
+										unique_params[key_name] = limit->test_number_value;
+										test_numbers.reserve(unique_params[key_name]);
+									}
+									else {
+										unique_params[key_name] = test_numbers.take();
+									}
+								}
+							}//if (column_types[current_col].compare(L"out") == 0) {
+						}//for (int current_col = 0; current_col < test_data.size(); current_col++) {
+					} // Else: curent row is test data
+					// row temporaries are out of scope, give the arena back after each batch of rows
+					if (type_indicator_int != 2 && test_data_rows % ARENA_ROW_BATCH == 0) {
+						row_arena.release();
+					}
+
+				} // finished reading current mat -> while(inf)
+				  // since current csv is done, copy remaining internal json objects into
+				  // data_objects, because new file will have different params
+				// value objects follow the limit objects in key order, merged from memory and spilled runs
+				DataObject value_object;
+				while (internal_json.next(value_object)) {
+					data_objects.push_back(move(value_object));
+					// a spilled subset is handed to the renderer in batches, so it is never completely in memory
+					if (internal_json.spilled() && data_objects.size() >= SPILL_MERGE_BATCH) {
+						shared_ptr<BuiltChunk> built_chunk = make_shared<BuiltChunk>();
+						built_chunk->objects = move(data_objects);
+						built_chunk->cache_key = cache_key;
+						built_chunk->subset_id = ws_id;
+						built_chunk->arrow_conditions = arrow_conditions;
+						if (!built_subsets.push(built_chunk)) {
+							break;
+						}
+						data_objects.clear();
+					}
+				}
+				if (internal_json.spilled()) {
+					LogLine() << L"Subset " << ws_id << L" spilled " << internal_json.spilled_objects() << L" objects in " << internal_json.run_count() <<
+						L" runs (" << internal_json.spilled_bytes() << L" bytes), peak memory " << internal_json.peak_memory() << L" bytes";
+				}
+				// subset is flushed, release the last row batch
+				row_arena.release();
+				LogLine() << L"Row arena of subset " << ws_id << L": " << row_arena.allocation_count() << L" allocations, high water " << row_arena.high_water_mark() <<
+					L" bytes, " << row_arena.block_count() << L" heap blocks, " << row_arena.release_count() << L" releases";
+				// summary objects follow the value objects of the subset
+				if (parameter_statistics) {
+					LogLine() << L"Statistics of subset " << ws_id << L": " << statistics.group_count() << L" parameter groups";
+					statistics.append_summary_objects(data_objects, summary_meta_template, ws_id);
+				}
+				if (limit_check) {
+					LogLine() << L"Limit check of subset " << ws_id << L": " << limit_evaluator.failed_values() << L" values failed";
+					limit_evaluator.append_summary_objects(data_objects, summary_meta_template, ws_id);
+				}
+				shared_ptr<BuiltChunk> built_chunk = make_shared<BuiltChunk>();
+				built_chunk->objects = move(data_objects);
+				built_chunk->cache_key = cache_key;
+				built_chunk->subset_id = ws_id;
+				built_chunk->arrow_conditions = arrow_conditions;
+				built_chunk->subset_complete = true;
+				// keep repetition counts of current subset for the report
+				if (cond_repetition) {
+					built_chunk->repetition_lines = repetition_counter.summary_lines(ws_id);
+					LogLine() << L"Repeated conditions in subset " << ws_id << L": " << built_chunk->repetition_lines.size();
+					repetition_summary.insert(repetition_summary.end(), built_chunk->repetition_lines.begin(), built_chunk->repetition_lines.end());
+				}
+				// hand objects of this subset to the renderer, waits if the renderer is behind
+				if (!built_subsets.push(built_chunk)) {
+					break;
+				}
+			}
+			built_subsets.close();
+		}
+		catch (...) {
+			cancel_pipeline(current_exception());
+		}
+	});
+
+	// stage: render the objects of each subset into one JSON chunk
+	thread render_thread([&]() {
+		LogListenerScope listener_scope(log_listener);
+		try {
+			DataReader renderer;
+			shared_ptr<BuiltChunk> built_chunk;
+			// key of the cache entry being written, its chunks arrive one after another
+			unsigned long long writing_cache_key = 0;
+			while (built_subsets.pop(built_chunk)) {
+				shared_ptr<wstring> json_chunk = built_chunk->cached_json;
+				if (!json_chunk) {
+					json_chunk = make_shared<wstring>();
+					for (const DataObject& data_object : built_chunk->objects) {
+						renderer.render_data_object(data_object, *json_chunk);
+					}
+					if (built_chunk->cache_key != 0) {
+						if (writing_cache_key != built_chunk->cache_key) {
+							subset_cache.begin(built_chunk->cache_key);
+							writing_cache_key = built_chunk->cache_key;
+						}
+						subset_cache.append(*json_chunk);
+						if (built_chunk->subset_complete) {
+							subset_cache.commit(built_chunk->repetition_lines);
+							writing_cache_key = 0;
+						}
+					}
+				}
+				shared_ptr<RenderedChunk> rendered_chunk = make_shared<RenderedChunk>();
+				rendered_chunk->json = json_chunk;
+				rendered_chunk->subset_complete = built_chunk->subset_complete;
+				rendered_chunk->repetition_lines = move(built_chunk->repetition_lines);
+				// the objects go on to the Arrow stage, the chunk is released there
+				if (arrow_export && !arrow_chunks.push(built_chunk)) {
+					break;
+				}
+				built_chunk.reset();
+				if (!rendered_chunks.push(rendered_chunk)) {
+					break;
+				}
+			}
+			rendered_chunks.close();
+			arrow_chunks.close();
+		}
+		catch (...) {
+			cancel_pipeline(current_exception());
+		}
+	});
+
+	// stage: write chunks to the JSON file, recipe is added once all stages are done
+	LogLine() << "Start: Writing JSON ..................................................";
+	wofstream json_out(json_path, resume_subsets > 0 ? ios::out | ios::app : ios::out | ios::trunc);
+	// the staging copy is written at the same time instead of copying the JSON afterwards
+	// it is renamed from .part once complete, so the staging area never sees a partial file
+	wstring staging_part_path = staging_json_path.empty() ? L"" : staging_json_path + L".part";
+	wofstream staging_out;
+	if (!staging_part_path.empty()) {
+		staging_out.open(staging_part_path, ios::out | ios::trunc);
+	}
+	auto write_json = [&](const wstring& json_chunk) {
+		json_out << json_chunk;
+		if (staging_out.is_open()) {
+			staging_out << json_chunk;
+		}
+	};
+	if (resume_subsets == 0) {
+		write_json(dr.json_header_chunk(header_struct, common_meta_data));
+	}
+	thread write_thread([&]() {
+		LogListenerScope listener_scope(log_listener);
+		try {
+			shared_ptr<RenderedChunk> rendered_chunk;
+			while (rendered_chunks.pop(rendered_chunk)) {
+				write_json(*rendered_chunk->json);
+				if (checkpoint != NULL && rendered_chunk->subset_complete) {
+					// the subset has to be on disk before it is committed, its Arrow file too
+					int arrow_subset;
+					if (arrow_export && !arrow_subsets.pop(arrow_subset)) {
+						break;
+					}
+					json_out.flush();
+					error_code size_error;
+					unsigned long long json_bytes = filesys::file_size(json_path, size_error);
+					if (json_out.good() && !size_error) {
+						checkpoint->commit(json_bytes, rendered_chunk->repetition_lines);
+					}
+				}
+			}
+		}
+		catch (...) {
+			cancel_pipeline(current_exception());
+		}
+	});
+
+	// stage: write the sheets of the workbook beside building and rendering the JSON
+	thread workbook_thread;
+	if (workbook) {
+		workbook_thread = thread([&]() {
+			LogListenerScope listener_scope(log_listener);
+			try {
+				shared_ptr<SubsetTable> workbook_subset;
+				while (workbook_subsets.pop(workbook_subset)) {
+					write_subset_sheets(*workbook, *workbook_subset, limits);
+				}
+			}
+			catch (...) {
+				cancel_pipeline(current_exception());
+			}
+		});
+	}
+
+	// stage: write the objects of each subset to its Arrow file, one record batch per chunk
+	// a file is written as .part and renamed once the subset is complete, so the folder only holds complete subsets
+	thread arrow_thread;
+	int arrow_files = 0;
+	unsigned long long arrow_rows = 0;
+	unsigned long long arrow_bytes = 0;
+	if (arrow_export) {
+		arrow_thread = thread([&]() {
+			LogListenerScope listener_scope(log_listener);
+			unique_ptr<ArrowFileWriter> arrow_file;
+			wstring arrow_part_path;
+			try {
+				SubsetArrowColumns arrow_columns;
+				unsigned long long dropped_values = 0;
+				shared_ptr<BuiltChunk> built_chunk;
+				int subset_count = 0;
+				while (arrow_chunks.pop(built_chunk)) {
+					if (!arrow_file) {
+						arrow_part_path = arrow_folder_path + L"\\" + subset_file_name(built_chunk->subset_id) + L".arrow.part";
+						arrow_file.reset(new ArrowFileWriter(arrow_part_path));
+						if (!arrow_file->is_open()) {
+							throw runtime_error("Couldn't create Arrow file");
+						}
+						arrow_columns = add_subset_arrow_columns(*arrow_file, built_chunk->arrow_conditions);
+						dropped_values = 0;
+					}
+					dropped_values += add_subset_arrow_rows(*arrow_file, built_chunk->objects, built_chunk->subset_id, arrow_columns);
+					arrow_file->write_batch();
+					if (built_chunk->subset_complete) {
+						wstring arrow_path = arrow_part_path.substr(0, arrow_part_path.size() - 5);
+						error_code rename_error;
+						bool arrow_ok = arrow_file->close();
+						if (arrow_ok) {
+							filesys::remove(arrow_path, rename_error);
+							filesys::rename(arrow_part_path, arrow_path, rename_error);
+						}
+						if (!arrow_ok || rename_error) {
+							throw runtime_error("Couldn't write Arrow file");
+						}
+						if (dropped_values > 0) {
+							LogLine() << L"Arrow file of subset " << built_chunk->subset_id << L": " << dropped_values << L" condition values left out";
+						}
+						arrow_files++;
+						arrow_rows += arrow_file->row_count();
+						arrow_bytes += arrow_file->file_bytes();
+						arrow_file.reset();
+						// the writer commits the subset once its Arrow file is complete
+						if (checkpoint != NULL && !arrow_subsets.push(++subset_count)) {
+							break;
+						}
+					}
+					built_chunk.reset();
+				}
+			}
+			catch (...) {
+				cancel_pipeline(current_exception());
+			}
+			// partial file of a cancelled subset
+			if (arrow_file) {
+				arrow_file.reset();
+				error_code remove_error;
+				filesys::remove(arrow_part_path, remove_error);
+			}
+		});
+	}
+
+	// stage: decode subsets, the capture is only read by this thread
+	LogLine() << L"Reading capture: " << capture.path();
+	try {
+		int num_dataset = capture.subset_count();
+		// the workbook is not part of the checkpoint, a resumed conversion writes it from the first subset again
+		for (int i = workbook ? 0 : resume_subsets; i < num_dataset; i++) {
+			// iterate through all datasets, waits if the builder or the workbook is behind
+			shared_ptr<SubsetTable> subset = capture.read_subset(i);
+			if (workbook && !workbook_subsets.push(subset)) {
+				break;
+			}
+			if (i >= resume_subsets && !decoded_subsets.push(subset)) {
+				break;
+			}
+		}
+		decoded_subsets.close();
+		workbook_subsets.close();
+	}
+	catch (...) {
+		cancel_pipeline(current_exception());
+	}
+	build_thread.join();
+	render_thread.join();
+	write_thread.join();
+	if (workbook_thread.joinable()) {
+		workbook_thread.join();
+	}
+	if (arrow_thread.joinable()) {
+		arrow_thread.join();
+	}
+	if (pipeline_error) {
+		if (workbook) {
+			workbook.reset();
+			error_code remove_error;
+			filesys::remove(workbook_path, remove_error);
+		}
+		json_out.close();
+		if (staging_out.is_open()) {
+			staging_out.close();
+			error_code remove_error;
+			filesys::remove(staging_part_path, remove_error);
+		}
+		rethrow_exception(pipeline_error);
+	}
+	print_queue_stats(L"decode -> build", decoded_subsets.stats());
+	print_queue_stats(L"build -> render", built_subsets.stats());
+	print_queue_stats(L"render -> write", rendered_chunks.stats());
+	if (workbook) {
+		print_queue_stats(L"decode -> workbook", workbook_subsets.stats());
+	}
+	if (arrow_export) {
+		print_queue_stats(L"render -> arrow", arrow_chunks.stats());
+		LogLine() << arrow_files << L" Arrow files with " << arrow_rows << L" rows (" << arrow_bytes << L" bytes) are saved in ";
+		LogLine() << arrow_folder_path;
+	}
+	// entries of subsets which are no longer in the .mat (or changed) are dropped
+	// a resumed run didn't look up the subsets before the resume point, their entries are kept
+	if (resume_subsets == 0) {
+		subset_cache.prune();
+	}
+	subset_cache.print_summary();
+
+	// write repetition summary next to the JSON
+	if (!repetition_summary.empty()) {
+		wstring summary_path = out_folder_path + L"\\" + configs_struct[L"ReportName"] + L"_repetitions.txt";
+		wofstream summary_out(summary_path);
+		summary_out << L"subset_id\ttest_name\tconditions\trepetitions" << endl;
+		for (auto line : repetition_summary) {
+			summary_out << line << endl;
+		}
+		summary_out.close();
+		LogLine() << L"Repetition summary is saved in ";
+		LogLine() << summary_path;
+	}
+	//// create recipe payload
+	wstring recipe_payload = construct_recipe(configs_struct[L"ReportTemplate"], configs_struct[L"ReportName"], configs_struct[L"Project"]);
+	write_json(dr.json_closing_chunk(recipe_payload));
+	json_out.close();
+	bool res = !json_out.fail();
+	LogLine() << L"JSON is saved in ";
+	LogLine() << json_path;
+	if (staging_out.is_open()) {
+		staging_out.close();
+		error_code staging_error;
+		if (res && !staging_out.fail()) {
+			filesys::rename(staging_part_path, staging_json_path, staging_error);
+		}
+		if (!res || staging_out.fail() || staging_error) {
+			// main copies the JSON instead
+			filesys::remove(staging_part_path, staging_error);
+			LogLine() << L"Couldn't write JSON to staging area: " << staging_json_path;
+		}
+		else {
+			LogLine() << L"JSON is saved in ";
+			LogLine() << staging_json_path;
+		}
+	}
+	if (workbook) {
+		if (workbook->close()) {
+			LogLine() << L"Workbook with " << workbook->sheet_count() << L" sheets (" << workbook->xml_bytes() << L" bytes of XML, " << workbook->compressed_bytes() <<
+				L" bytes compressed) is saved in ";
+			LogLine() << workbook_path;
+		}
+		else {
+			LogLine() << L"Couldn't write workbook " << workbook_path;
+			error_code remove_error;
+			filesys::remove(workbook_path, remove_error);
+		}
+	}
+	// the report is complete, a re-run converts again
+	if (res && checkpoint != NULL) {
+		checkpoint->finish();
+	}
+	LogLine() << "End: Writing JSON ..................................................";
+
+	LogLine() << "End: Processing Test Data ..................................................";
+	return res;
+}
+
+// will be called within test_data_reader
+map <wstring, wstring> configure_reader(DataReader dr, wstring configs_path) {
+	LogLine() << "Start: Processing Config_Tembo.txt ..................................................";
+	map <wstring, wstring> configs_struct;
+	map<wstring, wstring> raw_configs_struct;
+	//wstring wpath{};
+	//wpath = L"C:\\svn\\ps_cvsv_projects\\S0000_SVEN\\B11\\20_TestFlow\\Config_Tembo.txt";
+	raw_configs_struct = dr.read_config_file(configs_path);
+	configs_struct = dr.setup_configurations(raw_configs_struct, true);
+	LogLine() << "End: Processing Config_Tembo.txt ..................................................";
+	return configs_struct;
+}
+
+//test_data_reader_new for testing purpose
+/*
+bool test_data_reader_new(mxArray *pMxArrayData, map <wstring, wstring> overall_meta_data, map <wstring, wstring> configs_struct, wstring out_folder_path, wstring path_mat_data, wstring w_out_folder_path, wstring mat_files_first) {
+	LogLine() << "entering the test_data_reader_new......";
+	int num_dataset = mxGetN(pMxArrayData);
+	mxArray *pMxArrayDataSubset = NULL;
+	mxArray *pMxArrayIdSubset = NULL;
+	wstring ws_id;
+	bool res_data = 0;
+	for (int i = 0; i < num_dataset; i++) {
+		// iterate through all datasets 
+		
+		pMxArrayDataSubset = mxGetField(pMxArrayData, i, "data");
+		pMxArrayIdSubset = mxGetField(pMxArrayData, i, "id");
+		ws_id = mat_read_string(pMxArrayIdSubset);
+		LogLine() << "dimension of data structure:" << mxGetM(pMxArrayDataSubset) << "___" << mxGetN(pMxArrayDataSubset);
+		LogLine() << "ws_id: " << ws_id;
+
+		res_data = test_data_reader(pMxArrayDataSubset, overall_meta_data, configs_struct, w_out_folder_path, mat_files_first);
+
+	}
+
+	return res_data;
+}
+*/
+
+// name of a new report folder in 50_Report, the time of the conversion
+wstring report_folder_name() {
+	time_t theTime = time(NULL);
+	struct tm *aTime = localtime(&theTime);
+	int day = aTime->tm_mday;
+	int month = aTime->tm_mon + 1;
+	int year = aTime->tm_year + 1900;
+	int hour = aTime->tm_hour;
+	int min = aTime->tm_min;
+	int sec = aTime->tm_sec;
+
+	bool month_one_digit = false;
+	bool day_one_digit = false;
+	bool hour_one_digit = false;
+	bool min_one_digit = false;
+	bool sec_one_digit = false;
+
+	if (month < 10) month_one_digit = true;
+	if (day < 10) day_one_digit = true;
+	if (hour < 10) hour_one_digit = true;
+	if (min < 10) min_one_digit = true;
+	if (sec < 10) sec_one_digit = true;
+
+	string out_folder_name = to_string(year) + ((month_one_digit) ? to_string(0) : +"") + to_string(month) + ((day_one_digit) ? to_string(0) : +"") + to_string(day) + "T" + ((hour_one_digit) ? to_string(0) : +"") + to_string(hour) + ((min_one_digit) ? to_string(0) : +"") + to_string(min) + ((sec_one_digit) ? to_string(0) : +"") + to_string(sec);
+	return wstring(out_folder_name.begin(), out_folder_name.end());
+}
+
+// matOpen takes the path in the code page of the system
+string mat_path(const wstring& path) {
+#ifdef _WIN32
+	_bstr_t path_mat_data_char(path.c_str());
+	return string((const char*)path_mat_data_char);
+#else
+	return wstring_convert<codecvt_utf8<wchar_t>>().to_bytes(path);
+#endif
+}
+
+ConverterOptions::ConverterOptions() :
+	staging_workers(STAGING_WORKERS), stage_report(true), resume_interrupted(true), priority(PRIORITY_INTERACTIVE) {
+}
+
+ConversionInputs::ConversionInputs() :
+	footprint_bytes(0) {
+}
+
+wstring test_flow_folder_of(const wstring& raw_data_path) {
+	return raw_data_path.substr(0, raw_data_path.find_last_of(L"\\") + 1) + L"20_TestFlow";
+}
+
+bool apply_conversion_option(const wstring& option, ConverterOptions& options, wstring& test_flow_folder) {
+	size_t equal = option.find(L'=');
+	wstring key = option.substr(0, equal);
+	wstring value = equal == wstring::npos ? L"" : option.substr(equal + 1);
+	if (key == L"config" && !value.empty()) {
+		// the Config_Tembo.txt may be given instead of its folder
+		error_code error;
+		test_flow_folder = filesys::is_regular_file(value, error) ? filesys::path(value).parent_path().wstring() : value;
+	}
+	else if ((key == L"stage" || key == L"resume") && (value == L"on" || value == L"off")) {
+		(key == L"stage" ? options.stage_report : options.resume_interrupted) = value == L"on";
+	}
+	else if (key == L"priority" && (value == L"interactive" || value == L"batch")) {
+		options.priority = value == L"batch" ? PRIORITY_BATCH : PRIORITY_INTERACTIVE;
+	}
+	else {
+		return false;
+	}
+	return true;
+}
+
+MatCapture::MatCapture(const wstring& mat_file) :
+	mat_file(mat_file), mat(NULL), subsets_array(NULL), meta_array(NULL) {
+	lock_guard<mutex> lock(mat_api_mutex);
+	this->mat = matOpen(mat_path(mat_file).c_str(), "r");
+	if (this->mat == NULL) {
+		LogLine() << L"Couldn't open " << mat_file;
+		return;
+	}
+	this->subsets_array = matGetVariable(this->mat, "subsets");
+	this->meta_array = matGetVariable(this->mat, "meta");
+	if (this->subsets_array == NULL || this->meta_array == NULL) {
+		LogLine() << L"No subsets or meta in " << mat_file;
+		return;
+	}
+	//dimension of the overall data and metadata
+	LogLine() << "dimension of data structure:" << mxGetM(this->subsets_array) << "___" << mxGetN(this->subsets_array);
+
+	// Metadata------------------------------------------------------------------------
+	//overall_meta_data = hardcode_overall_metadata();
+	// get all necessary metadata from meta 
+	this->meta = construct_overall_meta_data(this->meta_array);
+	// get name of the folder containing csv file -> test_program_name
+	wstring test_program_name = mat_file.substr(0, mat_file.find_last_of(L"\\"));
+	test_program_name = test_program_name.substr(test_program_name.find_last_of(L"\\") + 1, test_program_name.size() - 1);
+	this->meta[L"test_program_name"] = test_program_name;
+	LogLine() << "overall_meta_data[Ltest_program_name]: " << this->meta[L"test_program_name"];
+}
+
+MatCapture::~MatCapture() {
+	lock_guard<mutex> lock(mat_api_mutex);
+	if (this->subsets_array != NULL) {
+		mxDestroyArray(this->subsets_array);
+	}
+	if (this->meta_array != NULL) {
+		mxDestroyArray(this->meta_array);
+	}
+	if (this->mat != NULL) {
+		matClose(this->mat);
+	}
+}
+
+bool MatCapture::is_open() const {
+	return this->subsets_array != NULL && this->meta_array != NULL;
+}
+
+const wstring& MatCapture::path() const {
+	return this->mat_file;
+}
+
+const map<wstring, wstring>& MatCapture::meta_data() const {
+	return this->meta;
+}
+
+int MatCapture::subset_count() const {
+	return this->subsets_array == NULL ? 0 : (int)mxGetN(this->subsets_array);
+}
+
+shared_ptr<SubsetTable> MatCapture::read_subset(int subset_index) const {
+	return decode_subset(this->subsets_array, subset_index);
+}
+
+mxArray* MatCapture::subsets() const {
+	return this->subsets_array;
+}
+
+Converter::Converter(const ConverterOptions& options) :
+	options(options), admission_control(AdmissionController::physical_memory() > 0 ? AdmissionController::physical_memory() / 2 : ULLONG_MAX) {
+}
+
+AdmissionController& Converter::admission() {
+	return this->admission_control;
+}
+
+unsigned long long Converter::estimate_footprint(const ConversionInputs& inputs) const {
+	if (inputs.mat_files.empty()) {
+		// CSV subsets are mapped one at a time, only the subsets in the pipeline are in memory
+		unsigned long long largest_file_bytes = 0;
+		for (const wstring& csv_file : inputs.csv_files) {
+			error_code error;
+			unsigned long long file_bytes = filesys::file_size(csv_file, error);
+			largest_file_bytes = max(largest_file_bytes, error ? 0 : file_bytes);
+		}
+		return (PIPELINE_QUEUE_CAPACITY * 3 + 1) * largest_file_bytes * CSV_FILE_EXPANSION;
+	}
+	const wstring& mat_file = inputs.mat_files[0];
+	unsigned long long cells = 0;
+	unsigned long long largest_subset_cells = 0;
+	bool from_header = false;
+	{
+		lock_guard<mutex> lock(mat_api_mutex);
+		MATFile *mat = matOpen(mat_path(mat_file).c_str(), "r");
+		if (mat != NULL) {
+			// header of every array without the values
+			mxArray *subsets_info = matGetVariableInfo(mat, "subsets");
+			if (subsets_info != NULL) {
+				from_header = true;
+				mwSize subset_count = mxGetNumberOfElements(subsets_info);
+				for (mwIndex i = 0; i < subset_count; i++) {
+					mxArray *data_info = mxIsStruct(subsets_info) ? mxGetField(subsets_info, i, "data") : NULL;
+					if (data_info == NULL) {
+						from_header = false;
+						break;
+					}
+					unsigned long long subset_cells = (unsigned long long)mxGetM(data_info) * mxGetN(data_info);
+					cells += subset_cells;
+					largest_subset_cells = max(largest_subset_cells, subset_cells);
+				}
+				mxDestroyArray(subsets_info);
+			}
+			matClose(mat);
+		}
+	}
+	if (!from_header) {
+		error_code error;
+		unsigned long long file_bytes = filesys::file_size(mat_file, error);
+		return error ? 0 : file_bytes * MAT_FILE_EXPANSION;
+	}
+	// all subsets are loaded at once, the pipeline holds a few of them decoded and rendered besides
+	return cells * MX_BYTES_PER_CELL + (PIPELINE_QUEUE_CAPACITY * 3 + 1) * largest_subset_cells * PIPELINE_BYTES_PER_CELL;
+}
+
+const ConverterOptions& Converter::converter_options() const {
+	return this->options;
+}
+
+bool Converter::collect_inputs(const wstring& searchpath, ConversionInputs& inputs) const {
+	error_code error;
+	if (!filesys::is_directory(searchpath, error)) {
+		LogLine() << L"Folder not found: " << searchpath;
+		return false;
+	}
+	inputs.raw_data_path = searchpath;
+	// check whether upload whole 30_RawData or just a single folder within it 
+	// right click on a single file 
+	if (searchpath.find(L"30_RawData\\") != wstring::npos) {
+		inputs.raw_data_path = inputs.raw_data_path.replace(inputs.raw_data_path.find_last_of(L"\\"), inputs.raw_data_path.size() - 1, L"");
+	}
+
+	inputs.mat_files = getAllFilesInDir(searchpath, L".mat");
+	// read all png files
+	inputs.png_files = getAllFilesInDir(searchpath, L".png");
+
+	// find all folders there 
+	vector<wstring> waveformfolder_inside_searchpath;
+	for (auto& p : filesys::recursive_directory_iterator(searchpath))
+		if (is_directory(p))
+			waveformfolder_inside_searchpath.push_back(wstring(p.path()));
+	wstring searchpath_waveforms{};
+	for (auto folder : waveformfolder_inside_searchpath) {
+		if (folder.find(L"waveform")) {
+			LogLine() << "found .mat waveforms.";
+			searchpath_waveforms = folder;
+		}
+	}
+	// read all mat waveforms within the current folder !!!!! need to change the path level
+	inputs.mat_wfm_files = getAllFilesInDir(searchpath_waveforms, L".mat");
+	for (auto mat_waveform : inputs.mat_wfm_files) {
+		inputs.mat_files.erase(remove(inputs.mat_files.begin(), inputs.mat_files.end(), mat_waveform), inputs.mat_files.end());
+	}
+	if (inputs.mat_files.empty()) {
+		// older test benches write a CSV file per subset instead
+		for (const wstring& csv_file : getAllFilesInDir(searchpath, L".csv")) {
+			if (CsvCapture::is_subset_file(csv_file)) {
+				inputs.csv_files.push_back(csv_file);
+			}
+		}
+		sort(inputs.csv_files.begin(), inputs.csv_files.end());
+	}
+	if (inputs.mat_files.empty() && inputs.csv_files.empty()) {
+		LogLine() << L"No .mat or CSV capture found in " << searchpath;
+		return false;
+	}
+	return true;
+}
+
+shared_ptr<const TestFlowSetup> Converter::test_flow_setup(const wstring& raw_data_path) {
+	return test_flow_setup_from(test_flow_folder_of(raw_data_path));
+}
+
+shared_ptr<const TestFlowSetup> Converter::test_flow_setup_from(const wstring& test_flow_folder) {
+	error_code error;
+	vector<wstring> configs_file = getAllFilesInDir(test_flow_folder, L"Config_Tembo.txt");
+	vector<wstring> limits_file = getAllFilesInDir(test_flow_folder, L"testlimits.txt");
+	if (configs_file.empty()) {
+		LogLine() << L"No Config_Tembo.txt found in " << test_flow_folder;
+		return shared_ptr<const TestFlowSetup>();
+	}
+	filesys::file_time_type configs_time = filesys::last_write_time(configs_file[0], error);
+	filesys::file_time_type limits_time = limits_file.empty() ? filesys::file_time_type() : filesys::last_write_time(limits_file[0], error);
+
+	lock_guard<mutex> lock(this->setup_mutex);
+	shared_ptr<const TestFlowSetup>& cached = this->setups[test_flow_folder];
+	if (cached && cached->configs_file == configs_file[0] && cached->configs_time == configs_time &&
+		cached->limits_file == (limits_file.empty() ? L"" : limits_file[0]) && cached->limits_time == limits_time) {
+		return cached;
+	}
+	shared_ptr<TestFlowSetup> setup = make_shared<TestFlowSetup>();
+	DataReader dr;
+	setup->configs_struct = configure_reader(dr, configs_file[0]);
+	setup->configs_file = configs_file[0];
+	setup->configs_time = configs_time;
+	// limits are loaded once and shared by all subsets and conversions
+	if (limits_file.size() > 0) {
+		setup->limits.load(limits_file[0]);
+		setup->limits_file = limits_file[0];
+		setup->limits_time = limits_time;
+	}
+	else {
+		LogLine() << L"No testlimits.txt found in " << test_flow_folder;
+	}
+	cached = setup;
+	return cached;
+}
+
+ConversionResult Converter::convert(const ConversionInputs& inputs, const TestFlowSetup& setup) {
+	return convert(inputs, setup, this->options);
+}
+
+ConversionResult Converter::convert(const ConversionInputs& inputs, const TestFlowSetup& setup, const ConverterOptions& options) {
+	ConversionResult result = { false, false, L"", L"" };
+	map <wstring, wstring> configs_struct = setup.configs_struct;
+	DataReader dr;
+	// get the output folder path
+	wstring report_folder_path = inputs.raw_data_path.substr(0, inputs.raw_data_path.find_last_of(L"\\") + 1) + L"50_Report";
+	shared_ptr<mutex> report_lock;
+	{
+		lock_guard<mutex> lock(this->report_mutex);
+		shared_ptr<mutex>& folder_lock = this->report_locks[report_folder_path];
+		if (!folder_lock) {
+			folder_lock = make_shared<mutex>();
+		}
+		report_lock = folder_lock;
+	}
+	// the capture is only loaded once it is this conversion's turn
+	lock_guard<mutex> report_guard(*report_lock);
+	// conversions on other hosts (spool workers) writing to the same 50_Report wait as well
+	ReportLease report_lease(report_folder_path);
+	unsigned long long footprint = inputs.footprint_bytes > 0 ? inputs.footprint_bytes : estimate_footprint(inputs);
+	AdmissionTicket admission_ticket(this->admission_control, options.priority, footprint);
+	LogLine() << L"Admitted with an estimated " << footprint / (1024 * 1024) << L" MB after waiting " << admission_ticket.waited_ms() << L" ms";
+	vector<wstring> capture_files = inputs.mat_files.empty() ? inputs.csv_files : vector<wstring>(1, inputs.mat_files[0]);
+	unique_ptr<SubsetSource> capture;
+	if (inputs.mat_files.empty()) {
+		capture.reset(new CsvCapture(inputs.csv_files));
+	}
+	else {
+		capture.reset(new MatCapture(inputs.mat_files[0]));
+	}
+	if (!capture->is_open()) {
+		return result;
+	}
+	const wstring& capture_file = capture->path();
+	map <wstring, wstring> overall_meta_data = capture->meta_data();
+	// Data-----------------------------------------------------------------------------
+	wstring w_out_folder_path = report_folder_path + L"\\" + report_folder_name();
+	// captures converted within the same second must not share a folder
+	error_code exists_error;
+	while (filesys::exists(w_out_folder_path, exists_error)) {
+		this_thread::sleep_for(chrono::seconds(1));
+		w_out_folder_path = report_folder_path + L"\\" + report_folder_name();
+	}
+	// an interrupted conversion of the same inputs is continued in its output folder instead, each capture has its own checkpoint
+	ConversionCheckpoint checkpoint(report_folder_path + L"_checkpoint_" + capture_key(capture_file) + L".txt", input_fingerprint(capture_files, configs_struct, setup.limits, overall_meta_data, inputs.png_files, inputs.mat_wfm_files));
+	error_code resume_error;
+	if (options.resume_interrupted && checkpoint.resume() &&
+		filesys::file_size(checkpoint.out_folder() + L"\\" + configs_struct[L"ReportName"] + L".json", resume_error) >= checkpoint.json_bytes() && !resume_error) {
+		w_out_folder_path = checkpoint.out_folder();
+		// keep the date of the first attempt, so the report is the same as without interruption
+		overall_meta_data[L"ts_data_created"] = checkpoint.ts_data_created();
+		LogLine() << L"Continuing interrupted conversion in " << w_out_folder_path;
+	}
+	else {
+		checkpoint.start(w_out_folder_path, overall_meta_data[L"ts_data_created"]);
+	}
+	result.out_folder = w_out_folder_path;
+
+	error_code create_error;
+	filesys::create_directories(w_out_folder_path, create_error);
+	if (create_error) {
+		LogLine() << L"Failed to create directory!";
+		return result;
+	}
+	LogLine() << "succeed in creating output folders!";
+	wstring prj_name = configs_struct[L"Project"];
+	transform(prj_name.begin(), prj_name.end(), prj_name.begin(), ::toupper);
+	wstring staging_area = configs_struct[L"StagingArea"] + L"\\" + prj_name + L"\\job";
+	wstring report_name = configs_struct[L"ReportName"];
+	wstring json_file = w_out_folder_path + L"\\" + report_name + L".json";
+	result.json_file = json_file;
+	unique_ptr<StagingArea> staging;
+	wstring staging_json_path;
+	if (options.stage_report) {
+		staging.reset(new StagingArea(staging_area, options.staging_workers));
+		// on the same filesystem the JSON is linked into the staging area afterwards, otherwise it is written there directly
+		if (staging->is_available() && !staging->same_filesystem(w_out_folder_path)) {
+			staging_json_path = staging->staged_path(json_file);
+		}
+	}
+	if (!staging_json_path.empty()) {
+		// a JSON left from an earlier run must not be taken for this one
+		error_code remove_error;
+		filesys::remove(staging_json_path, remove_error);
+	}
+	result.converted = test_data_reader(*capture, overall_meta_data, configs_struct, setup.limits, w_out_folder_path, capture_file, inputs.png_files, inputs.mat_wfm_files,
+		staging_json_path, &checkpoint);
+	if (!result.converted || !options.stage_report) {
+		return result;
+	}
+
+	LogLine() << "Start: Moving data to staging area ..................................................";
+	LogLine() << L"Staging area location";
+	LogLine() << staging_area;
+
+	// move file to Tembo
+	vector<wstring> staging_files;
+	// move png files
+	for (auto png_file : inputs.png_files) {
+		if (dr.convert_to_lower(png_file).find(L"report-picture") != wstring::npos) {
+			staging_files.push_back(png_file);
+		}
+	}
+	// move mat files
+	for (auto mat_waveform : inputs.mat_wfm_files) {
+		if (dr.convert_to_lower(mat_waveform).find(L"report-waveform") != wstring::npos) {
+			staging_files.push_back(mat_waveform);
+		}
+	}
+	// pictures and waveforms are kept between runs, only new or changed ones are staged
+	StagingManifest manifest(report_folder_path + L"_staging_manifest.txt", options.staging_workers);
+	bool res_staging = manifest.sync(staging_files, *staging);
+	manifest.save();
+	manifest.print_summary();
+	// the JSON is new on every run
+	if (staging_json_path.empty() || !filesys::exists(staging_json_path, exists_error)) {
+		res_staging = staging->stage_files(vector<wstring>(1, json_file)) && res_staging;
+	}
+	if (!res_staging) {
+		LogLine() << staging_area;
+		LogLine() << json_file;
+	}
+	staging->print_summary();
+	LogLine() << "End: Moving data to staging area ..................................................";
+	result.staged = res_staging;
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <experimental\filesystem>
+#include <mat.h>
+#include "LimitsCatalog.h"
+#include "SubsetTable.h"
+#include "SubsetSource.h"
+#include "ConversionLog.h"
+#include "AdmissionController.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// options of a Converter, the defaults are those of the command line tool
+struct ConverterOptions {
+	// number of files copied to the staging area at the same time
+	int staging_workers;
+	// copy the JSON, pictures and waveforms to the staging area of the project after the conversion
+	bool stage_report;
+	// continue an interrupted conversion of the same inputs from its checkpoint next to 50_Report
+	bool resume_interrupted;
+	// class the conversion waits in when memory is short, see AdmissionController
+	JobPriority priority;
+
+	ConverterOptions();
+};
+
+// files of one conversion, see Converter::collect_inputs
+struct ConversionInputs {
+	// 30_RawData folder, 20_TestFlow and 50_Report are next to it
+	wstring raw_data_path;
+	// captures found, the first one is converted
+	vector<wstring> mat_files;
+	// subsets of a capture of an older test bench, one CSV file per subset, converted if there is no .mat capture
+	vector<wstring> csv_files;
+	vector<wstring> png_files;
+	vector<wstring> mat_wfm_files;
+	// estimated memory of the conversion, see Converter::estimate_footprint, estimated by convert if 0
+	unsigned long long footprint_bytes;
+
+	ConversionInputs();
+};
+
+// configuration and limits of a 20_TestFlow folder
+struct TestFlowSetup {
+	wstring configs_file;
+	std::experimental::filesystem::file_time_type configs_time;
+	wstring limits_file;
+	std::experimental::filesystem::file_time_type limits_time;
+	map <wstring, wstring> configs_struct;
+	LimitsCatalog limits;
+};
+
+// outcome of Converter::convert
+struct ConversionResult {
+	// the JSON is complete
+	bool converted;
+	// JSON, pictures and waveforms are in the staging area
+	bool staged;
+	wstring out_folder;
+	wstring json_file;
+};
+
+// 20_TestFlow folder next to a 30_RawData folder
+wstring test_flow_folder_of(const wstring&);
+// applies a key=value option of a conversion request, config= sets the 20_TestFlow folder, false if the option is unknown
+bool apply_conversion_option(const wstring&, ConverterOptions&, wstring&);
+// all files below a folder whose path contains fileExt
+vector<wstring> getAllFilesInDir(const wstring&, const wstring&);
+
+#pragma once
+class MatCapture : public SubsetSource
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function opens a capture and reads its subsets and meta data
+	*
+	* Input:
+	*		mat_file			wstring				.mat file of the capture
+	*
+	* Calls into the mat and mx API are serialized, captures may be opened and read from several threads
+	*
+	*************************************************************************************************************************************************************************/
+	MatCapture(const wstring&);
+	~MatCapture();
+
+	bool is_open() const;
+	const wstring& path() const;
+	// meta data of the capture, test_program_name is the folder of the capture
+	const map<wstring, wstring>& meta_data() const;
+	int subset_count() const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function decodes one subset
+	*
+	* Input:
+	*		subset_index		int					0 ... subset_count() - 1
+	* Output:
+	*		res					SubsetTable			header rows, limit rows and test data of the subset
+	*
+	*************************************************************************************************************************************************************************/
+	shared_ptr<SubsetTable> read_subset(int) const;
+
+	// subsets variable of the .mat file, owned by the capture
+	mxArray* subsets() const;
+
+private:
+	MatCapture(const MatCapture&);
+	MatCapture& operator=(const MatCapture&);
+
+	wstring mat_file;
+	MATFile *mat;
+	mxArray *subsets_array;
+	mxArray *meta_array;
+	map<wstring, wstring> meta;
+};
+
+#pragma once
+class Converter
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function creates a converter, one converter can run any number of conversions, also from several threads at the same time
+	*
+	* Input:
+	*		options				ConverterOptions	options used for every conversion
+	*
+	* The converter reports through the log sink (see ConversionLog.h) and never prints to the console itself
+	*
+	*************************************************************************************************************************************************************************/
+	Converter(const ConverterOptions&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function finds the capture (a .mat file or the CSV files of a subset each), pictures and waveforms of a conversion
+	*
+	* Input:
+	*		searchpath			wstring				30_RawData folder or a folder within it
+	*		inputs				ConversionInputs	receives the files
+	* Output:
+	*		res					bool				false if there is no capture to convert
+	*
+	*************************************************************************************************************************************************************************/
+	bool collect_inputs(const wstring&, ConversionInputs&) const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function returns the configuration and limits for a 30_RawData folder
+	*
+	* Input:
+	*		raw_data_path		wstring				30_RawData folder, the files are taken from 20_TestFlow next to it
+	* Output:
+	*		res					TestFlowSetup		NULL if there is no Config_Tembo.txt
+	*
+	* Files are read once and kept, they are only read again when their modification time changes. A setup handed out stays valid
+	* while it is used, even if it is replaced meanwhile.
+	*
+	*************************************************************************************************************************************************************************/
+	shared_ptr<const TestFlowSetup> test_flow_setup(const wstring&);
+	// same for a 20_TestFlow folder given directly
+	shared_ptr<const TestFlowSetup> test_flow_setup_from(const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function converts the first capture of the inputs and moves the report to the staging area
+	*
+	* Input:
+	*		inputs				ConversionInputs	capture, pictures and waveforms
+	*		setup				TestFlowSetup		configuration and limits
+	*		options				ConverterOptions	options of this conversion, the options of the converter if not given
+	* Output:
+	*		res					ConversionResult	report folder and how far the conversion got
+	*
+	* Conversions writing to the same 50_Report run one after the other, also on different hosts (see ReportLease), they share the staging manifest.
+	* A conversion waits with loading the capture until its estimated memory fits into the budget of admission().
+	*
+	*************************************************************************************************************************************************************************/
+	ConversionResult convert(const ConversionInputs&, const TestFlowSetup&);
+	ConversionResult convert(const ConversionInputs&, const TestFlowSetup&, const ConverterOptions&);
+
+	const ConverterOptions& converter_options() const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function estimates the memory a conversion of a capture needs, from the header of the .mat file without loading the data
+	*
+	* Input:
+	*		inputs				ConversionInputs	capture to convert
+	* Output:
+	*		res					unsigned long long	bytes of the loaded subsets and of the subsets in the pipeline at once
+	*
+	*************************************************************************************************************************************************************************/
+	unsigned long long estimate_footprint(const ConversionInputs&) const;
+
+	// conversions running at once are admitted against its memory budget, half the physical memory by default
+	AdmissionController& admission();
+
+private:
+	ConverterOptions options;
+	AdmissionController admission_control;
+	mutex setup_mutex;
+	// 20_TestFlow folder -> latest setup read from it
+	map<wstring, shared_ptr<const TestFlowSetup>> setups;
+	mutex report_mutex;
+	// 50_Report folder -> lock held by the conversion writing to it
+	map<wstring, shared_ptr<mutex>> report_locks;
+};
@@ -0,0 +1,343 @@
+#include "CsvCapture.h"
+#include "MappedFile.h"
+#include "ConversionLog.h"
+#include "UnitScaling.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <ctime>
+#include <codecvt>
+#include <locale>
+#include <stdexcept>
+#include <experimental\filesystem>
+
+// SSE2 is part of every x64 CPU, 32 bit builds only use it when compiled for it
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define CSV_SCAN_SSE2
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+namespace filesys = std::experimental::filesystem;
+
+// a cell longer than this is no number
+static const size_t MAX_NUMBER_CHARS = 64;
+
+// cell of the current row, in the mapped file or, if it was quoted, in the unquoted text of the row
+struct CsvField {
+	const char *text;
+	size_t offset;
+	size_t length;
+};
+
+// kind of a cell, decides the row type like check_data_type does for .mat cells
+enum CsvCellKind {
+	CELL_EMPTY,
+	CELL_TEXT,
+	CELL_NAN,
+	CELL_NUMBER
+};
+
+#ifdef CSV_SCAN_SSE2
+static inline int first_set_bit(unsigned int mask) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return (int)index;
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+// next separator, quote or line end at or after text, end if there is none. Compares 16 bytes at once where SSE2 is available
+static const char* next_special(const char *text, const char *end, char delimiter) {
+#ifdef CSV_SCAN_SSE2
+	const __m128i delimiters = _mm_set1_epi8(delimiter);
+	const __m128i quotes = _mm_set1_epi8('"');
+	const __m128i line_feeds = _mm_set1_epi8('\n');
+	const __m128i carriage_returns = _mm_set1_epi8('\r');
+	while (end - text >= 16) {
+		__m128i block = _mm_loadu_si128((const __m128i*)text);
+		__m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, delimiters), _mm_cmpeq_epi8(block, quotes)),
+			_mm_or_si128(_mm_cmpeq_epi8(block, line_feeds), _mm_cmpeq_epi8(block, carriage_returns)));
+		unsigned int mask = (unsigned int)_mm_movemask_epi8(hits);
+		if (mask != 0) {
+			return text + first_set_bit(mask);
+		}
+		text += 16;
+	}
+#endif
+	while (text < end && *text != delimiter && *text != '"' && *text != '\n' && *text != '\r') {
+		text++;
+	}
+	return text;
+}
+
+static const char* skip_bom(const char *begin, const char *end) {
+	if (end - begin >= 3 && (unsigned char)begin[0] == 0xEF && (unsigned char)begin[1] == 0xBB && (unsigned char)begin[2] == 0xBF) {
+		return begin + 3;
+	}
+	return begin;
+}
+
+// separator of the file, taken from its first line like for testlimits.txt
+static char find_delimiter(const char *begin, const char *end) {
+	const char *line_end = (const char*)memchr(begin, '\n', end - begin);
+	if (line_end == NULL) {
+		line_end = end;
+	}
+	if (memchr(begin, '\t', line_end - begin) != NULL) {
+		return '\t';
+	}
+	return memchr(begin, ';', line_end - begin) != NULL ? ';' : ',';
+}
+
+static CsvCellKind classify_cell(const char *text, size_t length, bool decimal_comma, double& value) {
+	while (length > 0 && (*text == ' ' || *text == '\t')) {
+		text++;
+		length--;
+	}
+	while (length > 0 && (text[length - 1] == ' ' || text[length - 1] == '\t')) {
+		length--;
+	}
+	if (length == 0) {
+		return CELL_EMPTY;
+	}
+	if (length >= MAX_NUMBER_CHARS) {
+		return CELL_TEXT;
+	}
+	// strtod takes hex numbers and leading blanks as well, a cell has to look like a number first
+	char first = text[0];
+	if (!((first >= '0' && first <= '9') || first == '-' || first == '+' || first == '.' || (decimal_comma && first == ',') ||
+		first == 'n' || first == 'N' || first == 'i' || first == 'I') || memchr(text, 'x', length) != NULL || memchr(text, 'X', length) != NULL) {
+		return CELL_TEXT;
+	}
+	char number[MAX_NUMBER_CHARS];
+	memcpy(number, text, length);
+	number[length] = 0;
+	if (decimal_comma) {
+		for (size_t i = 0; i < length; i++) {
+			if (number[i] == ',') {
+				number[i] = '.';
+			}
+		}
+	}
+	char *number_end;
+	value = strtod(number, &number_end);
+	if (number_end != number + length) {
+		return CELL_TEXT;
+	}
+	return std::isnan(value) ? CELL_NAN : CELL_NUMBER;
+}
+
+// cell text as UTF-8, or as ANSI if it isn't
+static void widen_cell(const char *text, size_t length, wstring& cell) {
+	cell.resize(length);
+	for (size_t i = 0; i < length; i++) {
+		if ((unsigned char)text[i] >= 0x80) {
+			try {
+				cell = wstring_convert<codecvt_utf8<wchar_t>>().from_bytes(text, text + length);
+			}
+			catch (const range_error&) {
+				for (size_t j = 0; j < length; j++) {
+					cell[j] = (unsigned char)text[j];
+				}
+			}
+			return;
+		}
+		cell[i] = text[i];
+	}
+}
+
+// appends one row to the table, cells formatted like decode_subset formats the cells of a .mat subset
+static void add_row(SubsetTable& table, const vector<CsvField>& fields, const string& unquoted, bool decimal_comma, wstring& cell) {
+	SubsetRowType row_type = ROW_EMPTY;
+	bool exact_doubles = false;
+	for (size_t i = 0; i < fields.size(); i++) {
+		const char *text = fields[i].text != NULL ? fields[i].text : unquoted.data() + fields[i].offset;
+		double value = 0;
+		CsvCellKind kind = classify_cell(text, fields[i].length, decimal_comma, value);
+		if (i == 0) {
+			row_type = kind == CELL_EMPTY ? ROW_EMPTY : (kind == CELL_TEXT ? ROW_HEADER : (kind == CELL_NAN ? ROW_NAN : ROW_VALUE));
+			if (row_type == ROW_HEADER) {
+				// limit rows keep all digits
+				string first_cell(text, fields[i].length);
+				exact_doubles = first_cell.find("#FIELD") == string::npos && (first_cell.find("#usl") != string::npos || first_cell.find("#lsl") != string::npos);
+			}
+		}
+		if (kind == CELL_EMPTY) {
+			table.add_cell(L"", 0);
+		}
+		else if (kind == CELL_NAN) {
+			table.add_cell(L"NaN", 3);
+		}
+		else if (kind == CELL_TEXT) {
+			widen_cell(text, fields[i].length, cell);
+			table.add_cell(cell);
+		}
+		else {
+			if (exact_doubles) {
+				// same as mat_read_double_exact
+				table.add_cell(UnitScaling::format_double(value));
+			}
+			else {
+				wchar_t buffer[400];
+				int length = swprintf(buffer, 400, L"%f", value);
+				table.add_cell(buffer, length > 0 ? length : 0);
+			}
+		}
+	}
+	table.end_row(row_type);
+}
+
+CsvCapture::CsvCapture(const vector<wstring>& csv_files) :
+	csv_files(csv_files) {
+	// the files carry no meta data, the fields read from a .mat capture stay empty
+	const wchar_t *meta_fields[] = { L"product_sales_code", L"basic_type", L"product_design_step", L"package", L"dut_id", L"user", L"username",
+		L"email", L"api_id", L"global_id" };
+	for (const wchar_t *meta_field : meta_fields) {
+		this->meta[meta_field] = L"";
+	}
+	time_t now = time(NULL);
+	tm local_time;
+#ifdef _WIN32
+	localtime_s(&local_time, &now);
+#else
+	localtime_r(&now, &local_time);
+#endif
+	wchar_t date[16];
+	wcsftime(date, 16, L"%Y%m%d", &local_time);
+	this->meta[L"ts_data_created"] = date;
+	this->meta[L"testunit_version"] = L"1";
+	if (!csv_files.empty()) {
+		// get name of the folder containing csv file -> test_program_name
+		wstring test_program_name = csv_files[0].substr(0, csv_files[0].find_last_of(L"\\"));
+		this->meta[L"test_program_name"] = test_program_name.substr(test_program_name.find_last_of(L"\\") + 1);
+	}
+}
+
+bool CsvCapture::is_open() const {
+	return !this->csv_files.empty();
+}
+
+const wstring& CsvCapture::path() const {
+	return this->csv_files.at(0);
+}
+
+const map<wstring, wstring>& CsvCapture::meta_data() const {
+	return this->meta;
+}
+
+int CsvCapture::subset_count() const {
+	return (int)this->csv_files.size();
+}
+
+shared_ptr<SubsetTable> CsvCapture::read_subset(int subset_index) const {
+	const wstring& csv_file = this->csv_files.at(subset_index);
+	shared_ptr<SubsetTable> table = make_shared<SubsetTable>();
+	table->id = filesys::path(csv_file).stem().wstring();
+	MappedFile mapped;
+	if (!mapped.open(csv_file)) {
+		// a missing subset fails the conversion, an empty table would be converted and cached as if the subset had no data
+		LogLine() << L"Couldn't read " << csv_file;
+		throw runtime_error("Couldn't read CSV file");
+	}
+	if (mapped.size() == 0) {
+		return table;
+	}
+	const char *end = mapped.data() + mapped.size();
+	const char *text = skip_bom(mapped.data(), end);
+	char delimiter = find_delimiter(text, end);
+	// German exports separate with ; and write 1,5
+	bool decimal_comma = delimiter == ';';
+
+	vector<CsvField> fields;
+	string unquoted;
+	wstring cell;
+	while (text < end) {
+		fields.clear();
+		unquoted.clear();
+		while (true) {
+			CsvField field = { text, 0, 0 };
+			if (text < end && *text == '"') {
+				// quoted cell, "" stands for "
+				field.text = NULL;
+				field.offset = unquoted.size();
+				text++;
+				while (text < end) {
+					const char *quote = (const char*)memchr(text, '"', end - text);
+					if (quote == NULL) {
+						unquoted.append(text, end);
+						text = end;
+						break;
+					}
+					unquoted.append(text, quote);
+					text = quote + 1;
+					if (text < end && *text == '"') {
+						unquoted += '"';
+						text++;
+					}
+					else {
+						break;
+					}
+				}
+				field.length = unquoted.size() - field.offset;
+				// text between the closing quote and the separator is dropped
+				while (text < end && *text != delimiter && *text != '\n' && *text != '\r') {
+					text++;
+				}
+			}
+			else {
+				const char *cell_end = next_special(text, end, delimiter);
+				// a quote within an unquoted cell belongs to the cell
+				while (cell_end < end && *cell_end == '"') {
+					cell_end = next_special(cell_end + 1, end, delimiter);
+				}
+				field.length = cell_end - text;
+				text = cell_end;
+			}
+			fields.push_back(field);
+			if (text < end && *text == delimiter) {
+				text++;
+				continue;
+			}
+			break;
+		}
+		if (text < end && *text == '\r') {
+			text++;
+		}
+		if (text < end && *text == '\n') {
+			text++;
+		}
+		if (fields.size() == 1 && fields[0].length == 0) {
+			// blank line
+			continue;
+		}
+		add_row(*table, fields, unquoted, decimal_comma, cell);
+	}
+	return table;
+}
+
+bool CsvCapture::is_subset_file(const wstring& csv_file) {
+	MappedFile mapped;
+	if (!mapped.open(csv_file) || mapped.size() == 0) {
+		return false;
+	}
+	const char *end = mapped.data() + mapped.size();
+	const char *text = skip_bom(mapped.data(), end);
+	if (text < end && *text == '"') {
+		text++;
+	}
+	return text < end && *text == '#';
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include "SubsetSource.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+#pragma once
+class CsvCapture : public SubsetSource
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function opens the CSV files of a capture, as written by older test benches
+	*
+	* Input:
+	*		csv_files			vector<wstring>		one file per subset, the file name without extension is the id of the subset
+	*
+	* A file has the rows of the subsets cell array of a .mat capture: header rows starting with #FIELD, #name, #unit, #usl, #lsl and
+	* test data rows. Cells are separated by tab, ; or , (whichever the first line has), may be quoted with " and are UTF-8 or ANSI.
+	* With ; as separator a decimal comma is accepted as well. Files are mapped and only read when their subset is decoded.
+	*
+	*************************************************************************************************************************************************************************/
+	CsvCapture(const vector<wstring>&);
+
+	bool is_open() const;
+	const wstring& path() const;
+	const map<wstring, wstring>& meta_data() const;
+	int subset_count() const;
+	// throws if the CSV file of the subset can't be read
+	shared_ptr<SubsetTable> read_subset(int) const;
+
+	// the file starts with a header row (#FIELD, #name, ...), other CSV files in 30_RawData are not captures
+	static bool is_subset_file(const wstring&);
+
+private:
+	vector<wstring> csv_files;
+	map<wstring, wstring> meta;
+};
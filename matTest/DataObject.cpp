@@ -0,0 +1,238 @@
+#include "DataObject.h"
+#include <algorithm>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+DataObject::DataObject()
+{
+}
+
+
+DataObject::~DataObject()
+{
+}
+
+void DataObject::set_meta(MetaField field, const wstring& value) {
+	this->meta_delta.set(field, value);
+}
+
+void DataObject::set_meta(const wstring& key, const wstring& value) {
+	this->meta_delta.set(key, value);
+}
+
+void DataObject::set_template(const shared_ptr<const MetaTemplate>& meta_template) {
+	this->meta_shared = meta_template;
+}
+
+const shared_ptr<const MetaTemplate>& DataObject::meta_template() const {
+	return this->meta_shared;
+}
+
+const MetaFields& DataObject::own_meta() const {
+	return this->meta_delta;
+}
+
+const wstring* DataObject::find_meta(MetaField field) const {
+	const wstring *value = this->meta_delta.find(field);
+	if (value == NULL && this->meta_shared) {
+		value = this->meta_shared->find_meta(field);
+	}
+	return value;
+}
+
+void DataObject::set_payload(const wstring& key, const wstring& value) {
+	vector<pair<wstring, wstring>>::iterator it = lower_bound(this->payload.begin(), this->payload.end(), key,
+		[](const pair<wstring, wstring>& entry, const wstring& k) { return entry.first < k; });
+	if (it != this->payload.end() && it->first == key) {
+		it->second = value;
+	}
+	else {
+		this->payload.insert(it, make_pair(key, value));
+	}
+}
+
+const vector<pair<wstring, wstring>>& DataObject::payload_fields() const {
+	return this->payload;
+}
+
+void DataObject::add_link(DataLinkType type, const wstring& filename) {
+	DataLink link;
+	link.type = type;
+	link.filename = filename;
+	this->payload_links.push_back(link);
+}
+
+void DataObject::add_comment(const wstring& comment) {
+	this->payload_comments.push_back(comment);
+}
+
+const vector<DataLink>& DataObject::links() const {
+	return this->payload_links;
+}
+
+const vector<wstring>& DataObject::comments() const {
+	return this->payload_comments;
+}
+
+static void write_spill_size(ostream& out, size_t size) {
+	unsigned int value = (unsigned int)size;
+	out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void write_spill_string(ostream& out, const wstring& text) {
+	write_spill_size(out, text.size());
+	out.write(reinterpret_cast<const char*>(text.data()), text.size() * sizeof(wchar_t));
+}
+
+static bool read_spill_size(istream& in, size_t& size) {
+	unsigned int value = 0;
+	in.read(reinterpret_cast<char*>(&value), sizeof(value));
+	size = value;
+	return in.good();
+}
+
+static bool read_spill_string(istream& in, wstring& text) {
+	size_t size;
+	if (!read_spill_size(in, size)) {
+		return false;
+	}
+	text.resize(size);
+	if (size > 0) {
+		in.read(reinterpret_cast<char*>(&text[0]), size * sizeof(wchar_t));
+	}
+	return in.good();
+}
+
+static size_t string_memory(const wstring& text) {
+	// short strings are stored inside the object
+	return (text.capacity() > 7) ? (text.capacity() + 1) * sizeof(wchar_t) : 0;
+}
+
+void DataObject::write_spill(ostream& out, const MetaTemplate* shared_base) const {
+	// layers below shared_base, nearest first
+	const MetaFields *layers[MAX_META_LAYERS];
+	int layer_count = 0;
+	layers[layer_count++] = &this->meta_delta;
+	const MetaTemplate *layer = this->meta_shared.get();
+	while (layer != NULL && layer != shared_base) {
+		if (layer_count == MAX_META_LAYERS) {
+			throw runtime_error("Couldn't spill meta data, template chain deeper than MAX_META_LAYERS");
+		}
+		layers[layer_count++] = &layer->own_fields();
+		layer = layer->parent().get();
+	}
+	// shared_base is only attached again if the object was built on it
+	bool keeps_base = (layer != NULL && layer == shared_base);
+	out.put(keeps_base ? 1 : 0);
+
+	// farthest layer first, so nearer values overwrite when read back
+	size_t field_count = 0;
+	for (int i = 0; i < layer_count; i++) {
+		field_count += layers[i]->slots().size() + layers[i]->overflow().size();
+	}
+	write_spill_size(out, field_count);
+	for (int i = layer_count - 1; i >= 0; i--) {
+		for (const pair<MetaField, wstring>& slot : layers[i]->slots()) {
+			write_spill_string(out, META_FIELD_NAMES[slot.first]);
+			write_spill_string(out, slot.second);
+		}
+		for (const pair<wstring, wstring>& field : layers[i]->overflow()) {
+			write_spill_string(out, field.first);
+			write_spill_string(out, field.second);
+		}
+	}
+
+	write_spill_size(out, this->payload.size());
+	for (const pair<wstring, wstring>& field : this->payload) {
+		write_spill_string(out, field.first);
+		write_spill_string(out, field.second);
+	}
+	write_spill_size(out, this->payload_links.size());
+	for (const DataLink& link : this->payload_links) {
+		out.put((char)link.type);
+		write_spill_string(out, link.filename);
+	}
+	write_spill_size(out, this->payload_comments.size());
+	for (const wstring& comment : this->payload_comments) {
+		write_spill_string(out, comment);
+	}
+}
+
+bool DataObject::read_spill(istream& in, const shared_ptr<const MetaTemplate>& shared_base) {
+	*this = DataObject();
+	int keeps_base = in.get();
+	if (!in.good()) {
+		return false;
+	}
+	if (keeps_base == 1) {
+		this->meta_shared = shared_base;
+	}
+	size_t count;
+	wstring key;
+	wstring value;
+	if (!read_spill_size(in, count)) {
+		return false;
+	}
+	for (size_t i = 0; i < count; i++) {
+		if (!read_spill_string(in, key) || !read_spill_string(in, value)) {
+			return false;
+		}
+		this->meta_delta.set(key, value);
+	}
+	if (!read_spill_size(in, count)) {
+		return false;
+	}
+	// payload was written sorted
+	this->payload.reserve(count);
+	for (size_t i = 0; i < count; i++) {
+		if (!read_spill_string(in, key) || !read_spill_string(in, value)) {
+			return false;
+		}
+		this->payload.push_back(make_pair(key, value));
+	}
+	if (!read_spill_size(in, count)) {
+		return false;
+	}
+	for (size_t i = 0; i < count; i++) {
+		DataLinkType type = (DataLinkType)in.get();
+		if (!read_spill_string(in, value)) {
+			return false;
+		}
+		this->add_link(type, value);
+	}
+	if (!read_spill_size(in, count)) {
+		return false;
+	}
+	for (size_t i = 0; i < count; i++) {
+		if (!read_spill_string(in, value)) {
+			return false;
+		}
+		this->payload_comments.push_back(value);
+	}
+	return true;
+}
+
+size_t DataObject::memory_size() const {
+	size_t size = sizeof(DataObject);
+	for (const pair<MetaField, wstring>& slot : this->meta_delta.slots()) {
+		size += sizeof(slot) + string_memory(slot.second);
+	}
+	for (const pair<wstring, wstring>& field : this->meta_delta.overflow()) {
+		size += sizeof(field) + string_memory(field.first) + string_memory(field.second);
+	}
+	for (const pair<wstring, wstring>& field : this->payload) {
+		size += sizeof(field) + string_memory(field.first) + string_memory(field.second);
+	}
+	for (const DataLink& link : this->payload_links) {
+		size += sizeof(link) + string_memory(link.filename);
+	}
+	for (const wstring& comment : this->payload_comments) {
+		size += sizeof(comment) + string_memory(comment);
+	}
+	return size;
+}
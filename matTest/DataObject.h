@@ -0,0 +1,196 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <memory>
+#include <iostream>
+#include <stdexcept>
+#include "MetaFields.h"
+#include "MetaTemplate.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+/*************************************************************************************************************************************************************************
+* raw_data_link entry of the payload
+*************************************************************************************************************************************************************************/
+enum DataLinkType {
+	LINK_PNG,
+	LINK_MAT
+};
+
+struct DataLink {
+	DataLinkType type;
+	wstring filename;
+};
+
+// maximum depth of object + template chain (object, row, subset, run), a deeper chain throws runtime_error
+#define MAX_META_LAYERS 8
+
+#pragma once
+class DataObject
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* These functions set a metaData value of this object only (delta to its template)
+	*
+	* Input:
+	*		field / key		MetaField / wstring		slot or key name, keys without slot are kept in the overflow list
+	*		value			wstring					value, empty values are written as ""
+	*
+	*************************************************************************************************************************************************************************/
+	void set_meta(MetaField, const wstring&);
+	void set_meta(const wstring&, const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function sets the shared template providing all metaData not set on the object itself
+	*************************************************************************************************************************************************************************/
+	void set_template(const shared_ptr<const MetaTemplate>&);
+	const shared_ptr<const MetaTemplate>& meta_template() const;
+	const MetaFields& own_meta() const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function returns value of a slot from the object or its templates, NULL if not set
+	*************************************************************************************************************************************************************************/
+	const wstring* find_meta(MetaField) const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function expands object and template fields on the fly
+	*
+	* Input:
+	*		write			F(const wchar_t* key, const wstring& value)		called once per metaData key in key order
+	*
+	* A key set on several layers is taken from the nearest one (object, then row, subset, run template)
+	*
+	*************************************************************************************************************************************************************************/
+	template<class F> void for_each_meta(F) const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function sets a payload value (measurement value, limit fields), payload keys are kept sorted
+	*************************************************************************************************************************************************************************/
+	void set_payload(const wstring&, const wstring&);
+	const vector<pair<wstring, wstring>>& payload_fields() const;
+
+
+	/*************************************************************************************************************************************************************************
+	* These functions add raw_data_link entries and comments to the payload, order of insertion is kept
+	*************************************************************************************************************************************************************************/
+	void add_link(DataLinkType, const wstring&);
+	void add_comment(const wstring&);
+	const vector<DataLink>& links() const;
+	const vector<wstring>& comments() const;
+
+	/*************************************************************************************************************************************************************************
+	* These functions write the object to a spill file and read it back
+	*
+	* Input:
+	*		out / in		ostream / istream						binary stream of the spill run
+	*		shared_base		MetaTemplate / shared_ptr				template that stays in memory (subset template)
+	* Output:
+	*		res				bool									read_spill: object read or end of run
+	*
+	* metaData of the object and of all templates below shared_base are written as own fields, so per row
+	* templates do not stay in memory for spilled objects. After reading, shared_base is the template again
+	*
+	*************************************************************************************************************************************************************************/
+	void write_spill(ostream&, const MetaTemplate*) const;
+	bool read_spill(istream&, const shared_ptr<const MetaTemplate>&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function estimates the heap memory held by the object itself (shared templates not included)
+	*************************************************************************************************************************************************************************/
+	size_t memory_size() const;
+
+	DataObject();
+	~DataObject();
+	// data objects are moved between stages, never copied
+	DataObject(DataObject&&) = default;
+	DataObject& operator=(DataObject&&) = default;
+	DataObject(const DataObject&) = delete;
+	DataObject& operator=(const DataObject&) = delete;
+
+private:
+	// fields of this object only
+	MetaFields meta_delta;
+	shared_ptr<const MetaTemplate> meta_shared;
+	vector<pair<wstring, wstring>> payload;
+	vector<DataLink> payload_links;
+	vector<wstring> payload_comments;
+};
+
+template<class F> void DataObject::for_each_meta(F write) const {
+	// collect layers, nearest first
+	const MetaFields *layers[MAX_META_LAYERS];
+	int layer_count = 0;
+	layers[layer_count++] = &this->meta_delta;
+	for (const MetaTemplate *layer = this->meta_shared.get(); layer != NULL; layer = layer->parent().get()) {
+		if (layer_count == MAX_META_LAYERS) {
+			throw runtime_error("Couldn't collect meta data, template chain deeper than MAX_META_LAYERS");
+		}
+		layers[layer_count++] = &layer->own_fields();
+	}
+	size_t slot_cursor[MAX_META_LAYERS] = {};
+	size_t overflow_cursor[MAX_META_LAYERS] = {};
+
+	while (true) {
+		// smallest slot and smallest overflow key over all layers
+		int next_field = META_FIELD_COUNT;
+		const wstring *next_key = NULL;
+		for (int i = 0; i < layer_count; i++) {
+			const vector<pair<MetaField, wstring>>& slots = layers[i]->slots();
+			if (slot_cursor[i] < slots.size() && slots[slot_cursor[i]].first < next_field) {
+				next_field = slots[slot_cursor[i]].first;
+			}
+			const vector<pair<wstring, wstring>>& overflow = layers[i]->overflow();
+			if (overflow_cursor[i] < overflow.size() && (next_key == NULL || overflow[overflow_cursor[i]].first < *next_key)) {
+				next_key = &overflow[overflow_cursor[i]].first;
+			}
+		}
+		if (next_field == META_FIELD_COUNT && next_key == NULL) {
+			break;
+		}
+		if (next_field != META_FIELD_COUNT && (next_key == NULL || *next_key > META_FIELD_NAMES[next_field])) {
+			// write slot from nearest layer, skip it on all others
+			const wstring *value = NULL;
+			for (int i = 0; i < layer_count; i++) {
+				const vector<pair<MetaField, wstring>>& slots = layers[i]->slots();
+				if (slot_cursor[i] < slots.size() && slots[slot_cursor[i]].first == next_field) {
+					if (value == NULL) {
+						value = &slots[slot_cursor[i]].second;
+					}
+					slot_cursor[i]++;
+				}
+			}
+			write(META_FIELD_NAMES[next_field], *value);
+		}
+		else {
+			// write overflow key from nearest layer, skip it on all others
+			const wstring *key = next_key;
+			const wstring *value = NULL;
+			for (int i = 0; i < layer_count; i++) {
+				const vector<pair<wstring, wstring>>& overflow = layers[i]->overflow();
+				if (overflow_cursor[i] < overflow.size() && overflow[overflow_cursor[i]].first == *key) {
+					if (value == NULL) {
+						value = &overflow[overflow_cursor[i]].second;
+					}
+					overflow_cursor[i]++;
+				}
+			}
+			write(key->c_str(), *value);
+		}
+	}
+}
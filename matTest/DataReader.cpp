@@ -1,4 +1,6 @@
 #include "DataReader.h"
+#include "UnitScaling.h"
+#include "ConversionLog.h"
 
 /*************************************************************************************************************************************************************************
 * maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
@@ -23,10 +25,10 @@ map <wstring, wstring> DataReader::read_config_file(const wstring& config_file_p
 	map <wstring, wstring> configs_struct;
 	wifstream inf(config_file_path);
 	if (!inf) {
-		wcout << L"Couldn't read config file: " << config_file_path << endl;
+		LogLine() << L"Couldn't read config file: " << config_file_path;
 		exit(1);
 	}
-	cout << "CONFIG READER: " << endl;
+	LogLine() << "CONFIG READER: ";
 	while (inf) {
 		wstring strInp;
 		// read line
@@ -37,6 +39,11 @@ map <wstring, wstring> DataReader::read_config_file(const wstring& config_file_p
 		if (config_arr.size() < 1) {
 			continue;
 		}
+		// values may contain : themselves (e.g. staging_area: C:\staging), keep everything after the first :
+		if (config_arr.size() > 2) {
+			config_arr.resize(2);
+			config_arr[1] = strInp.substr(strInp.find(L":") + 1);
+		}
 		// convert project name to all lower case
 		if (config_arr[0] == L"Project") {
 			// convert project name to lower
@@ -64,6 +71,24 @@ map<wstring, wstring> DataReader::setup_configurations(map<wstring, wstring> con
 	wstring email = L"Jin.Xing@infineon.com"; // by default
 	wstring api_id_perl = L"";
 	wstring username = L"";
+	// memory for value objects of one subset before they are spilled to disk, 0 for no limit
+	wstring memory_budget_mb = L"0";
+	// root of the staging share, may be a local directory standing in for it
+	wstring staging_area = L"\\\\VIHSDV002.infineon.com\\tembo_staging_prod";
+	// off converts every subset again instead of taking unchanged ones from the subset cache
+	wstring subset_cache = L"on";
+	// on writes the subsets as sheets of an Excel workbook next to the JSON
+	wstring excel_export = L"off";
+	// on writes the limit and value objects of every subset as an Arrow file next to the JSON
+	wstring arrow_export = L"off";
+	// on adds summary objects with mean, sigma, min, max, Cpk and percentiles per parameter and condition group of every subset
+	wstring parameter_statistics = L"off";
+	// conditions whose values form the condition group of the statistics, comma separated
+	wstring statistics_conditions = L"tambient";
+	// percentiles of the summary objects, comma separated
+	wstring statistics_quantiles = L"0.1,50,99.9";
+	// on tags value objects with pass/fail against their limits and adds a summary object with the fail count per parameter
+	wstring limit_check = L"off";
 	bool default_email = true;
 	for (map<wstring, wstring>::value_type& config : configs_struct) {
 		wstring key = this->convert_to_lower(config.first);
@@ -86,10 +111,37 @@ map<wstring, wstring> DataReader::setup_configurations(map<wstring, wstring> con
 		else if (key == L"username") {
 			username = config.second;
 		}
+		else if (key == L"memory_budget_mb") {
+			memory_budget_mb = config.second;
+		}
+		else if (key == L"staging_area") {
+			staging_area = config.second;
+		}
+		else if (key == L"subset_cache") {
+			subset_cache = config.second;
+		}
+		else if (key == L"excel_export") {
+			excel_export = config.second;
+		}
+		else if (key == L"arrow_export") {
+			arrow_export = config.second;
+		}
+		else if (key == L"parameter_statistics") {
+			parameter_statistics = config.second;
+		}
+		else if (key == L"statistics_conditions") {
+			statistics_conditions = config.second;
+		}
+		else if (key == L"statistics_quantiles") {
+			statistics_quantiles = config.second;
+		}
+		else if (key == L"limit_check") {
+			limit_check = config.second;
+		}
 	}
 	if (default_email) {
-		wcout << endl << L"No configuration for email found in 'Config_Tembo.txt'" << endl;
-		wcout << L"Default email: " << email << endl;
+		LogLine() << L"No configuration for email found in 'Config_Tembo.txt'";
+		LogLine() << L"Default email: " << email;
 	}
 
 	// set variables in structure
@@ -98,22 +150,32 @@ map<wstring, wstring> DataReader::setup_configurations(map<wstring, wstring> con
 	final_configs[L"Email"] = email;
 	final_configs[L"api_id_perl"] = api_id_perl;
 	final_configs[L"Username"] = username;
+	final_configs[L"MemoryBudgetMB"] = memory_budget_mb;
+	final_configs[L"StagingArea"] = staging_area;
+	final_configs[L"SubsetCache"] = subset_cache;
+	final_configs[L"ExcelExport"] = excel_export;
+	final_configs[L"ArrowExport"] = arrow_export;
+	final_configs[L"ParameterStatistics"] = parameter_statistics;
+	final_configs[L"StatisticsConditions"] = statistics_conditions;
+	final_configs[L"StatisticsQuantiles"] = statistics_quantiles;
+	final_configs[L"LimitCheck"] = limit_check;
 	if (is_csv) {
 		final_configs[L"ReportName"] = report_name;
 		//wcout << endl << L"CSV Configurations" << endl;
-		wcout << L"Report name: " << report_name << endl;
+		LogLine() << L"Report name: " << report_name;
 	}
 	else {
-		wcout << endl << L"EFF Configurations" << endl;
+		LogLine() << L"EFF Configurations";
 	}
-	wcout << L"Project name: " << project_name << endl << L"Report template: " << report_template << endl;
-	wcout << L"Email: " << email << endl;
+	LogLine() << L"Project name: " << project_name;
+	LogLine() << L"Report template: " << report_template;
+	LogLine() << L"Email: " << email;
 
 	return final_configs;
 }
 
 bool DataReader::json_writer(map<wstring, wstring> header, map<wstring, wstring> common_meta_data,
-	vector<map<wstring, map<wstring, wstring>>> *data_objects, wstring json_path, wstring recipe_payload) {
+	vector<DataObject> *data_objects, wstring json_path, wstring recipe_payload) {
 	typedef std::chrono::high_resolution_clock clock;
 	typedef std::chrono::duration<float, std::milli> mil;
 	int c{};
@@ -123,9 +185,54 @@ bool DataReader::json_writer(map<wstring, wstring> header, map<wstring, wstring>
 	wstring json_chunk;
 	wofstream out(json_path);
 
-	//wcout << L"Writing JSON.." << endl;
-	printf("Start: Writing JSON ..................................................\n");
+	//LogLine() << L"Writing JSON..";
+	LogLine() << "Start: Writing JSON ..................................................";
+
+	// write header and common_meta_data
+	out << this->json_header_chunk(header, common_meta_data);
+
+	// calculate step size for progress bar
+	int progress_step{};
+	int initial_size = data_objects->size();
+	if (data_objects->size() < 100) {
+		progress_step = 1;
+	}
+	else {
+		progress_step = ceil(data_objects->size() / 100.0);
+	}
+	// write data objects
+	LogLine() << data_objects->size() << L" data objects";
+	while (!data_objects->empty()) {
+		// serialise record directly, then drop it
+		this->render_data_object(data_objects->back(), json_chunk);
+		data_objects->pop_back();
+
+		// write to file every 100 steps to prevent dealing with huge strings
+		if (++c % 100 == 0) {
+			out << json_chunk;
+			json_chunk = L"";
+		}
+		// update progress bar every {progress_steps}
+		if (c % progress_step == 0) {
+			LogLine() << this->progress_bar(c, initial_size, progress_step);
+		}
+	}
+	// update progress bar for final chunk
+	LogLine() << this->progress_bar(c, initial_size, progress_step);
+
+	// putting recipe and closing tags, write last chunk
+	json_chunk += this->json_closing_chunk(recipe_payload);
+	out << json_chunk;
 
+	out.close();
+	LogLine() << L"JSON is saved in ";
+	LogLine() << json_path;
+	LogLine() << "End: Writing JSON ..................................................";
+	return true;
+}
+
+wstring DataReader::json_header_chunk(map<wstring, wstring> header, map<wstring, wstring> common_meta_data) {
+	wstring json_chunk;
 	// open json {
 	json_chunk = L"{\n";
 	// write header
@@ -163,158 +270,13 @@ bool DataReader::json_writer(map<wstring, wstring> header, map<wstring, wstring>
 	// close commonMetaData tag
 	json_chunk += L"\n\t},\n";
 
-	// write to file and reset
-	out << json_chunk;
-	json_chunk = L"";
-
-	// calculate step size for progress bar
-	int progress_step{};
-	int initial_size = data_objects->size();
-	if (data_objects->size() < 100) {
-		progress_step = 1;
-	}
-	else {
-		progress_step = ceil(data_objects->size() / 100.0);
-	}
-	// write data objects
 	// open dataObjects tag
 	json_chunk += L"\"dataObjects\":[";
-	wcout << endl;
-	wcout << data_objects->size() << L" data objects" << endl;
-	while (!data_objects->empty()) {
-		map<wstring, map<wstring, wstring>> data_objects_element = data_objects->back();
-		data_objects->pop_back();
-		// open item tag {
-		json_chunk += L"\n\t{";
-		//json_chunk += "{";
-		for (map<wstring, map<wstring, wstring>>::value_type& data_object : data_objects_element) {
-			// open data_object tag (meta_data or payload)
-			json_chunk += L"\n\t\t";
-			json_chunk = json_chunk + L"\"" + data_object.first + L"\":\n\t\t\t{";
-			//json_chunk = json_chunk + "\"" + data_object.first + "\":{";
-			bool raw_data_link_opening_tag_created = false;
-			bool comment_opening_tag_created = false;
-
-			for (map<wstring, wstring>::value_type& field : data_object.second) {
-				// convert to integer wherever possible
-				// double second;
-				// wstring str_second;
-				// wistringstream iss(field.second);
-				// iss >> dec >> second;
-				json_chunk += L"\n\t\t\t\t";
-
-
-				// check if png filename
-				if (field.first.find(L"png_filename___") != wstring::npos) {
-					// if raw_data_link opening tag was created, then it's not the first 
-					// filename. Remove the last character \n\t\t\t\t], characters
-					if (raw_data_link_opening_tag_created) {
-						json_chunk = json_chunk.substr(0, json_chunk.size() - 7);
-						json_chunk += L",";	// close previous one
-					}
-					// check if raw_data_link tag was already created, if not create
-					if (!raw_data_link_opening_tag_created) {
-						json_chunk += L"\"raw_data_link\":[";
-						raw_data_link_opening_tag_created = true;
-					}
-					// populate raw_data_link
-					json_chunk += L"\n\t\t\t\t\t{";
-					json_chunk += L"\n\t\t\t\t\t\t\"type\":\"PNG\",";
-					json_chunk += L"\n\t\t\t\t\t\t\"filename\":\"" + field.second + L"\"";
-					json_chunk += L"\n\t\t\t\t\t}";
-					// close raw_data_link tag
-					json_chunk += L"\n\t\t\t\t],";
-				}
-				else if (field.first.find(L"mat_filename___") != wstring::npos) {
-					// if raw_data_link opening tag was created, then it's not the first 
-					// filename. Remove the last character \n\t\t\t\t], characters
-					if (raw_data_link_opening_tag_created) {
-						json_chunk = json_chunk.substr(0, json_chunk.size() - 7);
-						json_chunk += L",";	// close previous one
-					}
-					// check if raw_data_link tag was already created, if not create
-					if (!raw_data_link_opening_tag_created) {
-						json_chunk += L"\"raw_data_link\":[";
-						raw_data_link_opening_tag_created = true;
-					}
-					// populate raw_data_link
-					json_chunk += L"\n\t\t\t\t\t{";
-					json_chunk += L"\n\t\t\t\t\t\t\"type\":\"MAT\",";
-					json_chunk += L"\n\t\t\t\t\t\t\"filename\":\"" + field.second + L"\"";
-					json_chunk += L"\n\t\t\t\t\t}";
-					// close raw_data_link tag
-					json_chunk += L"\n\t\t\t\t],";
-				}
-				else if (field.first.find(L"comment___") != wstring::npos) {
-					// if comment_opening_tag was created then it's not the first comment
-					if (comment_opening_tag_created) {
-						json_chunk = json_chunk.substr(0, json_chunk.size() - 7);
-						json_chunk += L",";	// close previous one
-					}
-					// check if comment tag was already created, if not create
-					if (!comment_opening_tag_created) {
-						json_chunk += L"\"comments\":[";
-						comment_opening_tag_created = true;
-					}
-					// add comment
-					json_chunk += L"\n\t\t\t\t\t\"" + field.second + L"\"";
-					// close comments tag
-					json_chunk += L"\n\t\t\t\t],";
-				}
-				else {
-					json_chunk = json_chunk + L"\"" + field.first + L"\":\"" + field.second + L"\",";
-				}
-
-				// Writing everything as wstring to save precision for big number conversion to and from scientific version
-				// e.g. test_number = 12345678 as number becomes 1.23e6, which converts back to number as 1230000
-				/*
-				if (iss.fail() || field.first == "ts_data_created" || field.first == "dut_id" || field.first == "package" || field.first.find("cond_") != wstring::npos ||
-				field.first == "rddf_tc_id") {
-				// write inner object fields of meta or payload
-				json_chunk = json_chunk + "\"" + field.first + "\":\"" + field.second + "\",";
-				}
-				else {
-				if (second != 0) {
-				// 0 value is converted as empty
-				ostringstream strs;
-				strs << second;
-				str_second = strs.str();
-				str_second = this->strrep(str_second, ',', '.');
-				}
-				else {
-				// hardcode 0 wstring to avoid empty value
-				str_second = "0";
-				}
-				json_chunk = json_chunk + "\"" + field.first + "\":" + str_second + ",";
-				}
-				*/
-
-			}
-			// remove last ,
-			json_chunk = json_chunk.substr(0, json_chunk.size() - 1);
-			// close data_object tag }
-			json_chunk += L"\n\t\t\t},";
-			// json_chunk += "},";
-		}
-		// remove last ,
-		json_chunk = json_chunk.substr(0, json_chunk.size() - 1);
-		// close item tag
-		json_chunk += L"\n\t},";
-		// json_chunk += "},";
-
-		// write to file every 100 steps to prevent dealing with huge strings
-		if (++c % 100 == 0) {
-			out << json_chunk;
-			json_chunk = L"";
-		}
-		// update progress bar every {progress_steps}
-		if (c % progress_step == 0) {
-			wcout << '\r' << this->progress_bar(c, initial_size, progress_step);
-		}
-	}
-	// update progress bar for final chunk
-	wcout << '\r' << this->progress_bar(c, initial_size, progress_step);
+	return json_chunk;
+}
 
+wstring DataReader::json_closing_chunk(wstring recipe_payload) {
+	wstring json_chunk;
 	// putting recipe
 	json_chunk += L"\n\t{";
 	json_chunk += L"\n\t\t\"metaData\":\n\t\t\t{\n\t\t\t\t\"data_object_type\":\"recipe\"\n\t\t\t},";
@@ -327,14 +289,97 @@ bool DataReader::json_writer(map<wstring, wstring> header, map<wstring, wstring>
 
 	// close json }
 	json_chunk += L"\n}";
-	// wcout << json << endl;
-	// write last chunk
-	out << json_chunk;
+	return json_chunk;
+}
 
-	out.close();
-	wcout << endl << endl << L"JSON is saved in " << endl << json_path << endl;
-	printf("End: Writing JSON ..................................................\n");
-	return true;
+void DataReader::render_data_object(const DataObject& data_object, wstring& json_chunk) {
+	bool first_field = true;
+	// write "key":"value" of inner object, separated by ,
+	auto write_field = [&json_chunk, &first_field](const wchar_t* key, const wstring& value) {
+		json_chunk += first_field ? L"\n\t\t\t\t\"" : L",\n\t\t\t\t\"";
+		json_chunk += key;
+		json_chunk += L"\":\"" + value + L"\"";
+		first_field = false;
+	};
+
+	// open item tag {
+	json_chunk += L"\n\t{";
+
+	// open metaData tag, object fields and its templates are expanded in key order
+	json_chunk += L"\n\t\t\"metaData\":\n\t\t\t{";
+	data_object.for_each_meta(write_field);
+	// close metaData tag
+	json_chunk += L"\n\t\t\t},";
+
+	// open payload tag
+	json_chunk += L"\n\t\t\"payload\":\n\t\t\t{";
+	first_field = true;
+	const vector<DataLink>& links = data_object.links();
+	const vector<wstring>& comments = data_object.comments();
+	bool has_mat_link = false;
+	for (const DataLink& link : links) {
+		if (link.type == LINK_MAT) {
+			has_mat_link = true;
+		}
+	}
+	// comments and raw_data_link are placed where their former comment___N / mat_filename___N / png_filename___N keys were sorted
+	wstring comments_position = L"comment___";
+	wstring links_position = has_mat_link ? L"mat_filename___" : L"png_filename___";
+	bool comments_written = comments.empty();
+	bool links_written = links.empty();
+	auto write_comments = [&]() {
+		json_chunk += first_field ? L"\n\t\t\t\t" : L",\n\t\t\t\t";
+		json_chunk += L"\"comments\":[";
+		for (size_t i = 0; i < comments.size(); i++) {
+			json_chunk += (i == 0) ? L"\n\t\t\t\t\t\"" : L",\n\t\t\t\t\t\"";
+			json_chunk += comments[i] + L"\"";
+		}
+		json_chunk += L"\n\t\t\t\t]";
+		first_field = false;
+		comments_written = true;
+	};
+	auto write_links = [&]() {
+		json_chunk += first_field ? L"\n\t\t\t\t" : L",\n\t\t\t\t";
+		json_chunk += L"\"raw_data_link\":[";
+		bool first_link = true;
+		// MAT links first, then PNG links
+		for (int pass = 0; pass < 2; pass++) {
+			DataLinkType type = (pass == 0) ? LINK_MAT : LINK_PNG;
+			for (const DataLink& link : links) {
+				if (link.type != type) {
+					continue;
+				}
+				json_chunk += first_link ? L"\n\t\t\t\t\t{" : L",\n\t\t\t\t\t{";
+				json_chunk += (type == LINK_MAT) ? L"\n\t\t\t\t\t\t\"type\":\"MAT\"," : L"\n\t\t\t\t\t\t\"type\":\"PNG\",";
+				json_chunk += L"\n\t\t\t\t\t\t\"filename\":\"" + link.filename + L"\"";
+				json_chunk += L"\n\t\t\t\t\t}";
+				first_link = false;
+			}
+		}
+		json_chunk += L"\n\t\t\t\t]";
+		first_field = false;
+		links_written = true;
+	};
+	for (const pair<wstring, wstring>& field : data_object.payload_fields()) {
+		if (!comments_written && comments_position < field.first) {
+			write_comments();
+		}
+		if (!links_written && links_position < field.first) {
+			write_links();
+		}
+		write_field(field.first.c_str(), field.second);
+	}
+	if (!comments_written) {
+		write_comments();
+	}
+	if (!links_written) {
+		write_links();
+	}
+	// close payload tag
+	json_chunk += L"\n\t\t\t}";
+
+	// close item tag
+	json_chunk += L"\n\t},";
 }
 
 vector<wstring> DataReader::strsplit(wstring line, wstring delimiters, bool collapse_delimiters) {
@@ -404,23 +449,37 @@ map <wstring, wstring> DataReader::construct_common_meta_data(wstring basic_type
 	return common_meta_data;
 }
 
-map <wstring, wstring> DataReader::construct_limit_meta_data(map<wstring, wstring> common_meta_data, wstring req_id, wstring description, wstring typical, wstring test_number, wstring key_name) {
-	map <wstring, wstring> limit_meta_data;
-	// copy common meta_data into limit_meta_data, skip user_name
+shared_ptr<const MetaTemplate> DataReader::construct_limit_meta_template(map<wstring, wstring> common_meta_data) {
+	shared_ptr<MetaTemplate> limit_meta_template = MetaTemplate::derive(shared_ptr<const MetaTemplate>());
+	// copy common meta_data into limit template, skip user_name
 	for (map<wstring, wstring>::value_type& com_meta : common_meta_data) {
 		if (com_meta.first.compare(L"user_name") != 0) {
-			limit_meta_data[com_meta.first] = com_meta.second;
+			limit_meta_template->set_meta(com_meta.first, com_meta.second);
 		}
 	}
-	limit_meta_data[L"reqID"] = req_id;
-	limit_meta_data[L"description"] = description;
-	limit_meta_data[L"typical"] = typical;
-	limit_meta_data[L"test_number"] = test_number;
-	limit_meta_data[L"p_number"] = L"";
-	limit_meta_data[L"parameter_name"] = key_name;
-	limit_meta_data[L"data_object_type"] = L"limit";
-	limit_meta_data[L"limit_type"] = L"spec";
-	return limit_meta_data;
+	limit_meta_template->set_meta(META_P_NUMBER, L"");
+	limit_meta_template->set_meta(META_DATA_OBJECT_TYPE, L"limit");
+	limit_meta_template->set_meta(META_LIMIT_TYPE, L"spec");
+	return limit_meta_template;
+}
+
+shared_ptr<const MetaTemplate> DataReader::construct_summary_meta_template(map<wstring, wstring> common_meta_data) {
+	shared_ptr<MetaTemplate> summary_meta_template = MetaTemplate::derive(shared_ptr<const MetaTemplate>());
+	for (map<wstring, wstring>::value_type& com_meta : common_meta_data) {
+		if (com_meta.first.compare(L"user_name") != 0) {
+			summary_meta_template->set_meta(com_meta.first, com_meta.second);
+		}
+	}
+	summary_meta_template->set_meta(META_DATA_OBJECT_TYPE, L"summary");
+	return summary_meta_template;
+}
+
+void DataReader::set_limit_meta_data(DataObject& limit_data_object, wstring req_id, wstring description, wstring typical, wstring test_number, wstring key_name) {
+	limit_data_object.set_meta(META_REQ_ID, req_id);
+	limit_data_object.set_meta(META_DESCRIPTION, description);
+	limit_data_object.set_meta(META_TYPICAL, typical);
+	limit_data_object.set_meta(META_TEST_NUMBER, test_number);
+	limit_data_object.set_meta(META_PARAMETER_NAME, key_name);
 }
 
 wstring DataReader::construct_recipe(wstring report_template, wstring report_name, wstring project_name) {
@@ -447,16 +506,9 @@ wstring DataReader::construct_recipe(wstring report_template, wstring report_nam
 }
 
 wstring DataReader::scale_value(int scale, wstring value) {
-	wistringstream to_double2(value);
-	double current_value2;
-	to_double2 >> current_value2;
-	current_value2 = current_value2 * pow(10, -scale);
-	// convert back to wstring
-	wostringstream scaled_value;
-	scaled_value << current_value2;
-	wstring str_val = scaled_value.str();
-	str_val = this->strremove(str_val, ',');
-	return str_val;
+	// exact decimal scaling, no round trip through double
+	UnitScaling unit_scaling;
+	return unit_scaling.scale_value(scale, value);
 }
 
 wstring DataReader::generate_limit_from_test_value(wstring value, bool is_upper_limit) {
@@ -520,57 +572,9 @@ wstring DataReader::strtrim(wstring line) {
 }
 
 tuple<int, wstring> DataReader::get_unit_scale(const wstring& raw_unit) {
-	int scale{};
-	wstring unit;
-	if (raw_unit[0] == 'p') {
-		scale = 12;
-		unit = this->strremove(raw_unit, 'p');
-	}
-	else if (raw_unit[0] == 'n') {
-		scale = 9;
-		unit = this->strremove(raw_unit, 'n');
-	}
-	else if (raw_unit[0] == 'u') {
-		scale = 6;
-		unit = this->strremove(raw_unit, 'u');
-	}
-	else if (raw_unit[0] == 'm') {
-		scale = 3;
-		unit = this->strremove(raw_unit, 'm');
-	}
-	else if (raw_unit[0] == 'k') {
-		scale = -3;
-		unit = this->strremove(raw_unit, 'k');
-	}
-	else if (raw_unit[0] == 'K') {
-		scale = -3;
-		unit = this->strremove(raw_unit, 'K');
-	}
-	else if (raw_unit[0] == 'M') {
-		scale = -6;
-		unit = this->strremove(raw_unit, 'M');
-	}
-	else if (raw_unit[0] == 'G') {
-		scale = -9;
-		unit = this->strremove(raw_unit, 'G');
-	}
-	else if (raw_unit[0] == 'T') {
-		scale = -12;
-		unit = this->strremove(raw_unit, 'T');
-	}
-	else if (raw_unit[0] == ']' || raw_unit[0] == '[') {
-		// invalid unit scale occured
-		wcout << L"INVALID UNIT OCCURED IN LIMITS (testlimits.txt): " << unit << endl;
-		system("PAUSE");
-		exit(1);
-		// mark as invalid raw_unit occured
-		return make_tuple(42, raw_unit);
-	}
-	else {
-		scale = 0;
-		unit = raw_unit;
-	}
-	return make_tuple(scale, unit);
+	// prefix and unit registry lookup
+	UnitScaling unit_scaling;
+	return unit_scaling.get_unit_scale(raw_unit);
 }
 
 wstring DataReader::progress_bar(int curr, int total, int step) {
@@ -13,6 +13,8 @@
 
 #include <chrono>
 
+#include "DataObject.h"
+
 
 /*************************************************************************************************************************************************************************
 * maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
@@ -36,7 +38,7 @@ public:
 	* Input:
 	*		header				map<wstring, wstring>									header struct <key, value> - redundant for now, only 1 item
 	*		common_meta_data	map<wstring, wstring>									<key, value> mapping for common_meta_data
-	*		data_objects		map<wstring, map<wstring, map<wstring, wstring>>>		all data_objects
+	*		data_objects		vector<DataObject>										all data_objects, consumed while writing
 	*		json_path			wstring												where to store JSON file
 	*		recipe_payload		wstring												recipe for report generation
 	* Output:
@@ -48,7 +50,39 @@ public:
 	* Recipe is written as last object
 	*
 	*************************************************************************************************************************************************************************/
-	bool json_writer(map<wstring, wstring>, map<wstring, wstring>, vector<map<wstring, map<wstring, wstring>>>*, wstring, wstring);
+	bool json_writer(map<wstring, wstring>, map<wstring, wstring>, vector<DataObject>*, wstring, wstring);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function serialises one data object into the JSON chunk
+	*
+	* Input:
+	*		data_object			DataObject				object to write
+	*		json_chunk			wstring					chunk the object is appended to, followed by ,
+	*
+	* metaData slots and remaining keys are written in key order. Payload values are followed by
+	* raw_data_link (MAT, then PNG) and comments lists at the position of their former keys
+	*
+	*************************************************************************************************************************************************************************/
+	void render_data_object(const DataObject&, wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* These functions return the JSON text before and after the data objects
+	*
+	* Input:
+	*		header				map<wstring, wstring>		header struct <key, value>
+	*		common_meta_data	map<wstring, wstring>		<key, value> mapping for common_meta_data
+	*		recipe_payload		wstring						recipe for report generation
+	* Output:
+	*		json_chunk			wstring						header and commonMetaData up to the opening dataObjects tag,
+	*														respectively recipe object and closing tags
+	*
+	* Used by json_writer and by the conversion pipeline, which writes the objects of each subset in between
+	*
+	*************************************************************************************************************************************************************************/
+	wstring json_header_chunk(map<wstring, wstring>, map<wstring, wstring>);
+	wstring json_closing_chunk(wstring);
 
 
 	/*************************************************************************************************************************************************************************
@@ -69,7 +103,38 @@ public:
 
 
 	map <wstring, wstring> construct_common_meta_data(wstring, wstring, wstring, wstring, wstring);
-	map <wstring, wstring> construct_limit_meta_data(map<wstring, wstring>, wstring, wstring, wstring, wstring, wstring);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function creates the shared metaData template of all limit objects
+	*
+	* Input:
+	*		common_meta_data	map<wstring, wstring>				<key, value> mapping for common_meta_data
+	* Output:
+	*		limit_template		shared_ptr<const MetaTemplate>		common_meta_data without user_name, data_object_type limit, limit_type spec
+	*
+	*************************************************************************************************************************************************************************/
+	shared_ptr<const MetaTemplate> construct_limit_meta_template(map<wstring, wstring>);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function creates the shared metaData template of all summary objects (statistics of a parameter)
+	*
+	* Input:
+	*		common_meta_data	map<wstring, wstring>				<key, value> mapping for common_meta_data
+	* Output:
+	*		summary_template	shared_ptr<const MetaTemplate>		common_meta_data without user_name, data_object_type summary
+	*
+	*************************************************************************************************************************************************************************/
+	shared_ptr<const MetaTemplate> construct_summary_meta_template(map<wstring, wstring>);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function sets the limit specific metaData (reqID, description, typical, test_number, parameter_name)
+	* on a limit object using the limit template
+	*************************************************************************************************************************************************************************/
+	void set_limit_meta_data(DataObject&, wstring, wstring, wstring, wstring, wstring);
+
 	wstring construct_recipe(wstring, wstring, wstring);
 	wstring scale_value(int, wstring);
 	wstring generate_limit_from_test_value(wstring, bool);
@@ -130,7 +195,7 @@ public:
 	*		(scale, unit)	tuple(int, wstring)		corresponding scale and unit
 	*
 	* This function determines scale from first char of raw_unit and removes
-	* fist character
+	* fist character, see UnitScaling::get_unit_scale
 	*
 	*************************************************************************************************************************************************************************/
 	tuple<int, wstring>get_unit_scale(const wstring&);
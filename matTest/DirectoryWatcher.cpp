@@ -0,0 +1,250 @@
+#include "DirectoryWatcher.h"
+#include "ConversionLog.h"
+#include <system_error>
+#include <experimental\filesystem>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <codecvt>
+#include <locale>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+namespace filesys = std::experimental::filesystem;
+
+// large enough for a burst of captures, a full buffer is reported as WATCH_OVERFLOW
+static const size_t CHANGE_BUFFER_BYTES = 64 * 1024;
+
+#ifdef _WIN32
+DirectoryWatcher::DirectoryWatcher(const wstring& root) :
+	root(root), opened(false), directory_handle(INVALID_HANDLE_VALUE), event_handle(NULL),
+	overlapped(sizeof(OVERLAPPED)), buffer(CHANGE_BUFFER_BYTES / sizeof(unsigned long)) {
+	this->directory_handle = CreateFileW(root.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+		OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+	this->event_handle = CreateEventW(NULL, TRUE, FALSE, NULL);
+	this->opened = this->directory_handle != INVALID_HANDLE_VALUE && this->event_handle != NULL && start_read();
+	if (!this->opened) {
+		LogLine() << L"Couldn't watch directory: " << root;
+	}
+}
+
+DirectoryWatcher::~DirectoryWatcher() {
+	if (this->directory_handle != INVALID_HANDLE_VALUE) {
+		CancelIo(this->directory_handle);
+		CloseHandle(this->directory_handle);
+	}
+	if (this->event_handle != NULL) {
+		CloseHandle(this->event_handle);
+	}
+}
+
+bool DirectoryWatcher::start_read() {
+	OVERLAPPED *pending = reinterpret_cast<OVERLAPPED*>(&this->overlapped[0]);
+	ZeroMemory(pending, sizeof(OVERLAPPED));
+	pending->hEvent = this->event_handle;
+	ResetEvent(this->event_handle);
+	return ReadDirectoryChangesW(this->directory_handle, &this->buffer[0], (DWORD)(this->buffer.size() * sizeof(unsigned long)), TRUE,
+		FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE, NULL, pending, NULL) != 0;
+}
+
+bool DirectoryWatcher::wait(int timeout_ms, vector<WatchEvent>& events) {
+	if (!this->opened) {
+		return false;
+	}
+	if (WaitForSingleObject(this->event_handle, (DWORD)timeout_ms) != WAIT_OBJECT_0) {
+		return true;
+	}
+	DWORD bytes = 0;
+	if (!GetOverlappedResult(this->directory_handle, reinterpret_cast<OVERLAPPED*>(&this->overlapped[0]), &bytes, FALSE)) {
+		this->opened = false;
+		return false;
+	}
+	if (bytes == 0) {
+		// the changes did not fit into the buffer
+		WatchEvent overflow = { WATCH_OVERFLOW, L"" };
+		events.push_back(overflow);
+	}
+	else {
+		const char *record = reinterpret_cast<const char*>(&this->buffer[0]);
+		while (true) {
+			const FILE_NOTIFY_INFORMATION *change = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(record);
+			WatchEvent event;
+			event.path = this->root + L"\\" + wstring(change->FileName, change->FileNameLength / sizeof(WCHAR));
+			switch (change->Action) {
+			case FILE_ACTION_ADDED:
+				event.type = WATCH_CREATED;
+				break;
+			case FILE_ACTION_RENAMED_NEW_NAME:
+				event.type = WATCH_CLOSED;
+				break;
+			case FILE_ACTION_REMOVED:
+			case FILE_ACTION_RENAMED_OLD_NAME:
+				event.type = WATCH_REMOVED;
+				break;
+			default:
+				event.type = WATCH_MODIFIED;
+				break;
+			}
+			error_code error;
+			if (event.type == WATCH_REMOVED || !filesys::is_directory(event.path, error)) {
+				events.push_back(event);
+			}
+			if (change->NextEntryOffset == 0) {
+				break;
+			}
+			record += change->NextEntryOffset;
+		}
+	}
+	this->opened = start_read();
+	return this->opened;
+}
+
+bool DirectoryWatcher::is_released(const wstring& path) {
+	// fails with a sharing violation while the writer still has the file open
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	CloseHandle(file);
+	return true;
+}
+
+bool DirectoryWatcher::reports_close() const {
+	return false;
+}
+#else
+static string narrow_path(const wstring& path) {
+	return wstring_convert<codecvt_utf8<wchar_t>>().to_bytes(path);
+}
+
+static wstring wide_path(const string& path) {
+	return wstring_convert<codecvt_utf8<wchar_t>>().from_bytes(path);
+}
+
+DirectoryWatcher::DirectoryWatcher(const wstring& root) :
+	root(root), opened(false), inotify_descriptor(-1) {
+	this->inotify_descriptor = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+	if (this->inotify_descriptor >= 0) {
+		add_watches(root, NULL);
+	}
+	this->opened = !this->watched_directories.empty();
+	if (!this->opened) {
+		LogLine() << L"Couldn't watch directory: " << root;
+	}
+}
+
+DirectoryWatcher::~DirectoryWatcher() {
+	if (this->inotify_descriptor >= 0) {
+		close(this->inotify_descriptor);
+	}
+}
+
+void DirectoryWatcher::add_watches(const wstring& directory, vector<WatchEvent>* found_files) {
+	// files which landed in a new directory before its watch existed are reported as created
+	const uint32_t mask = IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_DELETE_SELF | IN_ONLYDIR;
+	int watch = inotify_add_watch(this->inotify_descriptor, narrow_path(directory).c_str(), mask);
+	if (watch < 0) {
+		return;
+	}
+	this->watched_directories[watch] = directory;
+	error_code error;
+	for (filesys::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+		error_code type_error;
+		if (filesys::is_directory(it->path(), type_error)) {
+			add_watches(it->path().wstring(), found_files);
+		}
+		else if (found_files != NULL) {
+			WatchEvent event = { WATCH_CREATED, it->path().wstring() };
+			found_files->push_back(event);
+		}
+	}
+}
+
+bool DirectoryWatcher::wait(int timeout_ms, vector<WatchEvent>& events) {
+	if (!this->opened) {
+		return false;
+	}
+	pollfd ready = { this->inotify_descriptor, POLLIN, 0 };
+	if (poll(&ready, 1, timeout_ms) <= 0) {
+		return true;
+	}
+	vector<char> buffer(CHANGE_BUFFER_BYTES);
+	while (true) {
+		ssize_t bytes = read(this->inotify_descriptor, &buffer[0], buffer.size());
+		if (bytes <= 0) {
+			break;
+		}
+		for (char *record = &buffer[0]; record < &buffer[0] + bytes; ) {
+			const inotify_event *change = reinterpret_cast<const inotify_event*>(record);
+			record += sizeof(inotify_event) + change->len;
+			if (change->mask & IN_Q_OVERFLOW) {
+				WatchEvent overflow = { WATCH_OVERFLOW, L"" };
+				events.push_back(overflow);
+				continue;
+			}
+			map<int, wstring>::iterator directory = this->watched_directories.find(change->wd);
+			if (directory == this->watched_directories.end()) {
+				continue;
+			}
+			if (change->mask & (IN_DELETE_SELF | IN_IGNORED)) {
+				this->watched_directories.erase(directory);
+				continue;
+			}
+			if (change->len == 0) {
+				continue;
+			}
+			wstring path = directory->second + L"/" + wide_path(change->name);
+			if (change->mask & IN_ISDIR) {
+				if (change->mask & (IN_CREATE | IN_MOVED_TO)) {
+					add_watches(path, &events);
+				}
+				continue;
+			}
+			WatchEvent event;
+			event.path = path;
+			if (change->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+				event.type = WATCH_CLOSED;
+			}
+			else if (change->mask & (IN_DELETE | IN_MOVED_FROM)) {
+				event.type = WATCH_REMOVED;
+			}
+			else if (change->mask & IN_CREATE) {
+				event.type = WATCH_CREATED;
+			}
+			else {
+				event.type = WATCH_MODIFIED;
+			}
+			events.push_back(event);
+		}
+	}
+	if (this->watched_directories.empty()) {
+		// the watched tree itself was removed
+		this->opened = false;
+	}
+	return this->opened;
+}
+
+bool DirectoryWatcher::is_released(const wstring& path) {
+	// without mandatory locks an open writer can't be detected, IN_CLOSE_WRITE tells instead
+	error_code error;
+	return filesys::is_regular_file(path, error);
+}
+
+bool DirectoryWatcher::reports_close() const {
+	return true;
+}
+#endif
+
+bool DirectoryWatcher::is_open() const {
+	return this->opened;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+enum WatchEventType {
+	WATCH_CREATED,
+	WATCH_MODIFIED,
+	// the writer closed the file (inotify only), or it was moved into the tree complete
+	WATCH_CLOSED,
+	WATCH_REMOVED,
+	// events were lost, the tree has to be scanned again
+	WATCH_OVERFLOW
+};
+
+struct WatchEvent {
+	WatchEventType type;
+	// absolute path of the file, empty for WATCH_OVERFLOW
+	wstring path;
+};
+
+#pragma once
+class DirectoryWatcher
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function starts watching a directory tree
+	*
+	* Input:
+	*		root				wstring				directory to watch including all subdirectories (e.g. 30_RawData)
+	*
+	* Uses ReadDirectoryChangesW on Windows and inotify elsewhere, subdirectories created later are watched as well
+	*
+	*************************************************************************************************************************************************************************/
+	DirectoryWatcher(const wstring&);
+	~DirectoryWatcher();
+
+
+	/*************************************************************************************************************************************************************************
+	* This function waits for changes of files in the tree
+	*
+	* Input:
+	*		timeout_ms			int					maximum time to wait
+	*		events				vector<WatchEvent>	receives the events, directories are not reported
+	* Output:
+	*		res					bool				false if the watch failed and no more events will come
+	*
+	*************************************************************************************************************************************************************************/
+	bool wait(int, vector<WatchEvent>&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function checks whether no writer has a file open anymore
+	*
+	* Input:
+	*		path				wstring				file to check
+	* Output:
+	*		res					bool				true if the file can be opened without sharing (always true without mandatory locks)
+	*
+	*************************************************************************************************************************************************************************/
+	static bool is_released(const wstring&);
+
+	bool is_open() const;
+	// true if WATCH_CLOSED is reported when a writer closes a file, otherwise completion is only known from a quiet period
+	bool reports_close() const;
+
+private:
+	DirectoryWatcher(const DirectoryWatcher&);
+	DirectoryWatcher& operator=(const DirectoryWatcher&);
+
+	wstring root;
+	bool opened;
+#ifdef _WIN32
+	void *directory_handle;
+	void *event_handle;
+	// OVERLAPPED and the change buffer of the pending ReadDirectoryChangesW
+	vector<char> overlapped;
+	vector<unsigned long> buffer;
+	bool start_read();
+#else
+	void add_watches(const wstring&, vector<WatchEvent>*);
+	int inotify_descriptor;
+	// watch descriptor -> watched directory
+	map<int, wstring> watched_directories;
+#endif
+};
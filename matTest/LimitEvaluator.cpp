@@ -0,0 +1,131 @@
+#include "LimitEvaluator.h"
+#include "UnitScaling.h"
+#include <map>
+#include <cmath>
+#include <cwchar>
+#include <limits>
+#include <emmintrin.h>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+const wchar_t* const LIMIT_RESULT_NAMES[] = { L"", L"pass", L"fail", L"invalid" };
+
+LimitEvaluator::LimitEvaluator() : first_row(0), failed_count(0)
+{
+}
+
+void LimitEvaluator::evaluate(const double* values, size_t count, double lower, double upper, unsigned char* results) {
+	// a side without limit is open
+	const __m128d lower_limit = _mm_set1_pd(std::isnan(lower) ? -numeric_limits<double>::infinity() : lower);
+	const __m128d upper_limit = _mm_set1_pd(std::isnan(upper) ? numeric_limits<double>::infinity() : upper);
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2) {
+		__m128d value = _mm_loadu_pd(values + i);
+		// ordered compares are false for NaN, so NaN never passes
+		int pass = _mm_movemask_pd(_mm_and_pd(_mm_cmpge_pd(value, lower_limit), _mm_cmple_pd(value, upper_limit)));
+		int invalid = _mm_movemask_pd(_mm_cmpunord_pd(value, value));
+		// fail 2, pass 2 - 1, NaN 2 + 1
+		results[i] = (unsigned char)(LIMIT_FAIL - (pass & 1) + (invalid & 1));
+		results[i + 1] = (unsigned char)(LIMIT_FAIL - (pass >> 1) + (invalid >> 1));
+	}
+	for (; i < count; i++) {
+		__m128d value = _mm_set_sd(values[i]);
+		int pass = _mm_movemask_pd(_mm_and_pd(_mm_cmpge_sd(value, lower_limit), _mm_cmple_sd(value, upper_limit)));
+		int invalid = _mm_movemask_pd(_mm_cmpunord_sd(value, value));
+		results[i] = (unsigned char)(LIMIT_FAIL - (pass & 1) + (invalid & 1));
+	}
+}
+
+void LimitEvaluator::evaluate_column(const SubsetTable& table, int first_row, int column, double lower_limit, double upper_limit) {
+	// a side with NaN is open
+	if (std::isnan(lower_limit) && std::isnan(upper_limit)) {
+		return;
+	}
+	this->first_row = first_row;
+	int row_count = table.row_count() - first_row;
+	if (row_count <= 0) {
+		return;
+	}
+	this->values.resize(row_count);
+	for (int row = 0; row < row_count; row++) {
+		size_t length = 0;
+		const wchar_t* text = NULL;
+		if (table.row_type(first_row + row) != ROW_HEADER && column < table.col_count(first_row + row)) {
+			text = table.cell(first_row + row, column, &length);
+		}
+		// cells which aren't numbers are NaN, LIMIT_INVALID
+		if (!UnitScaling::parse_double(text, length, &this->values[row])) {
+			this->values[row] = numeric_limits<double>::quiet_NaN();
+		}
+	}
+	vector<unsigned char>& results = this->column_results[column];
+	results.resize(row_count);
+	evaluate(this->values.data(), row_count, lower_limit, upper_limit, results.data());
+}
+
+LimitResult LimitEvaluator::result(int row, int column) const {
+	unordered_map<int, vector<unsigned char>>::const_iterator results = this->column_results.find(column);
+	if (results == this->column_results.end() || row < this->first_row || row - this->first_row >= (int)results->second.size()) {
+		return LIMIT_NOT_CHECKED;
+	}
+	return (LimitResult)results->second[row - this->first_row];
+}
+
+void LimitEvaluator::record(const wstring& test_name, const wstring& test_number, LimitResult result, const wstring& conditions, const wstring& idx) {
+	LimitCheckCounts& parameter = this->counts[test_name];
+	parameter.test_number = test_number;
+	if (result == LIMIT_PASS) {
+		parameter.pass_count++;
+	}
+	else if (result == LIMIT_FAIL) {
+		if (parameter.fail_count++ == 0) {
+			parameter.first_fail_conditions = conditions;
+			parameter.first_fail_idx = idx;
+		}
+		this->failed_count++;
+	}
+	else if (result == LIMIT_INVALID) {
+		parameter.invalid_count++;
+	}
+}
+
+void LimitEvaluator::append_summary_objects(vector<DataObject>& objects, const shared_ptr<const MetaTemplate>& summary_template, const wstring& subset_id) {
+	// sort parameters to get the same objects for the same input
+	map<wstring, const LimitCheckCounts*> sorted;
+	for (const unordered_map<wstring, LimitCheckCounts>::value_type& parameter : this->counts) {
+		sorted[parameter.first] = &parameter.second;
+	}
+	for (map<wstring, const LimitCheckCounts*>::value_type& parameter : sorted) {
+		DataObject summary_object;
+		summary_object.set_template(summary_template);
+		summary_object.set_meta(META_PARAMETER_NAME, parameter.first);
+		summary_object.set_meta(META_TEST_NUMBER, parameter.second->test_number);
+		summary_object.set_meta(META_SUBSET_ID, subset_id);
+		summary_object.set_meta(L"summary_type", L"limit_check");
+		summary_object.set_payload(L"pass_count", to_wstring(parameter.second->pass_count));
+		summary_object.set_payload(L"fail_count", to_wstring(parameter.second->fail_count));
+		summary_object.set_payload(L"invalid_count", to_wstring(parameter.second->invalid_count));
+		if (parameter.second->fail_count > 0) {
+			summary_object.set_payload(L"first_fail_conditions", parameter.second->first_fail_conditions);
+			summary_object.set_payload(L"first_fail_idx", parameter.second->first_fail_idx);
+		}
+		objects.push_back(move(summary_object));
+	}
+	this->clear();
+}
+
+void LimitEvaluator::clear() {
+	this->column_results.clear();
+	this->counts.clear();
+	this->first_row = 0;
+	this->failed_count = 0;
+}
+
+unsigned long long LimitEvaluator::failed_values() const {
+	return this->failed_count;
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include "DataObject.h"
+#include "MetaTemplate.h"
+#include "SubsetTable.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// result of a value against the limits of its parameter
+enum LimitResult {
+	LIMIT_NOT_CHECKED = 0,
+	LIMIT_PASS = 1,
+	LIMIT_FAIL = 2,
+	// NaN or text, neither pass nor fail
+	LIMIT_INVALID = 3
+};
+
+// limit_result of the value objects, indexed by LimitResult
+extern const wchar_t* const LIMIT_RESULT_NAMES[];
+
+// results of the value objects of one parameter
+struct LimitCheckCounts {
+	wstring test_number;
+	unsigned long long pass_count;
+	unsigned long long fail_count;
+	unsigned long long invalid_count;
+	// conditions and idx of the first failing value
+	wstring first_fail_conditions;
+	wstring first_fail_idx;
+
+	LimitCheckCounts() : pass_count(0), fail_count(0), invalid_count(0) {}
+};
+
+#pragma once
+class LimitEvaluator
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function compares values against a lower and an upper limit, two values per SSE2 compare
+	*
+	* Input:
+	*		values				double*				values of a column
+	*		count				size_t				number of values
+	*		lower / upper		double				limits, NaN for a side without limit
+	* Output:
+	*		results				unsigned char*		one LimitResult per value, NaN values are LIMIT_INVALID
+	*
+	*************************************************************************************************************************************************************************/
+	static void evaluate(const double*, size_t, double, double, unsigned char*);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function evaluates a column of the subset against the limits of its parameter
+	*
+	* Input:
+	*		table				SubsetTable			decoded subset
+	*		first_row			int					first test data row, header rows after it are skipped
+	*		column				int					out column
+	*		lower / upper		double				limits in the unit of the column (not the one of the limit object), NaN if not set
+	*
+	* The cells are parsed into one typed column which is then compared as a whole. A column without limits is not evaluated
+	*
+	*************************************************************************************************************************************************************************/
+	void evaluate_column(const SubsetTable&, int, int, double, double);
+
+	// result of a cell, LIMIT_NOT_CHECKED for columns which weren't evaluated
+	LimitResult result(int, int) const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function counts the result of a value object for the summary of its parameter
+	*
+	* Input:
+	*		test_name			wstring				name of the parameter
+	*		test_number			wstring				test number of the parameter
+	*		result				LimitResult			result of the value
+	*		conditions			wstring				readable conditions of the row (e.g. tambient=25, VIO=3.3)
+	*		idx					wstring				idx of the row
+	*
+	*************************************************************************************************************************************************************************/
+	void record(const wstring&, const wstring&, LimitResult, const wstring&, const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function appends one summary object (summary_type limit_check) per checked parameter
+	*
+	* Input:
+	*		summary_template	shared_ptr			template of all summary objects
+	*		subset_id			wstring				id of the subset
+	* Output:
+	*		objects				vector<DataObject>	summary objects are appended, sorted by test name
+	*
+	* Payload: pass_count, fail_count, invalid_count and first_fail_conditions, first_fail_idx if a value failed. The results are cleared afterwards
+	*
+	*************************************************************************************************************************************************************************/
+	void append_summary_objects(vector<DataObject>&, const shared_ptr<const MetaTemplate>&, const wstring&);
+
+	void clear();
+	// failed values of the subset so far
+	unsigned long long failed_values() const;
+
+	LimitEvaluator();
+
+private:
+	int first_row;
+	// column -> result per row from first_row on
+	unordered_map<int, vector<unsigned char>> column_results;
+	// typed column being evaluated, kept to reuse its memory
+	vector<double> values;
+	unordered_map<wstring, LimitCheckCounts> counts;
+	unsigned long long failed_count;
+};
@@ -0,0 +1,193 @@
+#include "LimitsCatalog.h"
+#include "MappedFile.h"
+#include "ContentHash.h"
+#include "ConversionLog.h"
+#include <locale>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+LimitsCatalog::LimitsCatalog() : content_fingerprint(0)
+{
+}
+
+
+LimitsCatalog::~LimitsCatalog()
+{
+}
+
+bool LimitsCatalog::load(const wstring& limits_path) {
+	DataReader dr;
+	MappedFile limits_file;
+	this->limits.clear();
+	this->reserved_test_numbers.clear();
+	this->limits_path = limits_path;
+	this->content_fingerprint = 0;
+
+	if (!limits_file.open(limits_path)) {
+		LogLine() << L"Couldn't read limits file: " << limits_path;
+		return false;
+	}
+	this->content_fingerprint = ContentHash::of(limits_file.data(), limits_file.size());
+	const char *begin = limits_file.data();
+	const char *end = begin + limits_file.size();
+	// skip UTF-8 BOM
+	if (limits_file.size() >= 3 && (unsigned char)begin[0] == 0xEF && (unsigned char)begin[1] == 0xBB && (unsigned char)begin[2] == 0xBF) {
+		begin += 3;
+	}
+
+	wstring_convert<codecvt_utf8<wchar_t>> converter;
+	wstring delimiter{};
+	// column index of each known column, -1 if not present
+	int col_param = -1, col_test_nr = -1, col_unit = -1, col_lsl = -1, col_usl = -1, col_req_id = -1, col_description = -1, col_typ = -1;
+	int line_count = 0;
+
+	const char *line_begin = begin;
+	while (line_begin < end) {
+		const char *line_end = line_begin;
+		while (line_end < end && *line_end != '\n') {
+			line_end++;
+		}
+		string raw_line(line_begin, line_end);
+		line_begin = line_end + 1;
+		line_count++;
+		if (!raw_line.empty() && raw_line[raw_line.size() - 1] == '\r') {
+			raw_line.erase(raw_line.size() - 1);
+		}
+		if (raw_line.empty() || raw_line[0] == '#') {
+			continue;
+		}
+		wstring line;
+		try {
+			line = converter.from_bytes(raw_line);
+		}
+		catch (range_error &) {
+			// not UTF-8, take bytes as they are (ANSI export)
+			line = wstring(raw_line.begin(), raw_line.end());
+		}
+
+		if (delimiter.empty()) {
+			// header line: find separator and known columns
+			delimiter = (line.find(L'\t') != wstring::npos) ? L"\t" : ((line.find(L';') != wstring::npos) ? L";" : L",");
+			vector<wstring> header = dr.strsplit(line, delimiter, false);
+			for (int i = 0; i < (int)header.size(); i++) {
+				wstring column = dr.convert_to_lower(dr.strtrim(header[i]));
+				if (column == L"parameter" || column == L"parameter_name" || column == L"name" || column == L"testname" || column == L"test_name") {
+					col_param = i;
+				}
+				else if (column == L"testnr" || column == L"test_number") {
+					col_test_nr = i;
+				}
+				else if (column == L"unit") {
+					col_unit = i;
+				}
+				else if (column == L"lsl") {
+					col_lsl = i;
+				}
+				else if (column == L"usl") {
+					col_usl = i;
+				}
+				else if (column == L"reqid") {
+					col_req_id = i;
+				}
+				else if (column == L"description") {
+					col_description = i;
+				}
+				else if (column == L"typ" || column == L"typical") {
+					col_typ = i;
+				}
+			}
+			// first column holds the parameter name if there is no explicit column
+			if (col_param == -1) {
+				col_param = 0;
+			}
+			continue;
+		}
+
+		vector<wstring> tokens = dr.strsplit(line, delimiter, false);
+		auto column_value = [&tokens, &dr](int col) -> wstring {
+			if (col < 0 || col >= (int)tokens.size()) {
+				return L"";
+			}
+			return dr.strtrim(tokens[col]);
+		};
+		wstring raw_param_name = column_value(col_param);
+		if (raw_param_name.empty()) {
+			continue;
+		}
+
+		LimitEntry entry;
+		entry.parameter_name = dr.validate_param_name(raw_param_name);
+		entry.test_number = column_value(col_test_nr);
+		entry.test_number_value = -1;
+		try {
+			size_t parsed = 0;
+			int value = stoi(entry.test_number, &parsed);
+			if (parsed == entry.test_number.size()) {
+				entry.test_number_value = value;
+			}
+		}
+		catch (logic_error &) {
+			// not numeric, test number is used as text only
+		}
+		entry.req_id = column_value(col_req_id);
+		entry.description = column_value(col_description);
+		entry.typical = column_value(col_typ);
+		entry.raw_unit = column_value(col_unit);
+		if (entry.raw_unit.empty()) {
+			entry.scale = 0;
+		}
+		else {
+			tie(entry.scale, entry.unit) = dr.get_unit_scale(entry.raw_unit);
+		}
+		// scale limits once, NaN or missing limit stays empty
+		wstring lsl = column_value(col_lsl);
+		wstring usl = column_value(col_usl);
+		entry.lower_limit = (lsl.empty() || lsl.find(L"NaN") == 0) ? L"" : dr.scale_value(entry.scale, lsl);
+		entry.upper_limit = (usl.empty() || usl.find(L"NaN") == 0) ? L"" : dr.scale_value(entry.scale, usl);
+
+		if (this->limits.find(entry.parameter_name) != this->limits.end()) {
+			LogLine() << L"Duplicate limit in line " << line_count << L" of testlimits.txt, keeping first: " << entry.parameter_name;
+			continue;
+		}
+		if (entry.test_number_value >= 0) {
+			this->reserved_test_numbers.push_back(entry.test_number_value);
+		}
+		this->limits[entry.parameter_name] = entry;
+	}
+
+	LogLine() << L"Limits loaded: " << this->limits.size() << L" from " << limits_path;
+	return true;
+}
+
+const LimitEntry* LimitsCatalog::find(const wstring& key_name) const {
+	unordered_map<wstring, LimitEntry>::const_iterator it = this->limits.find(key_name);
+	if (it == this->limits.end()) {
+		return NULL;
+	}
+	return &it->second;
+}
+
+const vector<int>& LimitsCatalog::test_numbers() const {
+	return this->reserved_test_numbers;
+}
+
+size_t LimitsCatalog::size() const {
+	return this->limits.size();
+}
+
+bool LimitsCatalog::empty() const {
+	return this->limits.empty();
+}
+
+const wstring& LimitsCatalog::source() const {
+	return this->limits_path;
+}
+
+unsigned long long LimitsCatalog::fingerprint() const {
+	return this->content_fingerprint;
+}
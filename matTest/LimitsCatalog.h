@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "DataReader.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+/*************************************************************************************************************************************************************************
+* Single limit of testlimits.txt, LSL/USL are already scaled with the unit prefix
+*************************************************************************************************************************************************************************/
+struct LimitEntry {
+	wstring parameter_name;			// sanitised parameter name (validate_param_name)
+	wstring test_number;			// TestNr as given in the file
+	int test_number_value;			// TestNr as integer, -1 if not numeric
+	wstring req_id;
+	wstring description;
+	wstring typical;
+	wstring raw_unit;				// unit as given in the file (e.g. mV)
+	wstring unit;					// unit without prefix (e.g. V)
+	int scale;						// scale of unit prefix (e.g. 3 for m)
+	wstring lower_limit;			// scaled LSL, empty if not given
+	wstring upper_limit;			// scaled USL, empty if not given
+};
+
+#pragma once
+class LimitsCatalog
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function loads testlimits.txt into the catalog
+	*
+	* Input:
+	*		limits_path			wstring				absolute path to testlimits.txt
+	* Output:
+	*		res					bool				success or not
+	*
+	* The file is memory mapped and read as a table: first non empty line holds the column names
+	* (Parameter/Name, TestNr, Unit, LSL, USL, ReqID, Description, Typ), columns are separated by tab
+	* (';' or ',' if the header contains no tab). Every line is split with DataReader::strsplit.
+	* Parameter names are sanitised with validate_param_name so they match test_name of the data objects.
+	* LSL/USL are scaled once while loading.
+	*
+	*************************************************************************************************************************************************************************/
+	bool load(const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function looks up limit of a parameter
+	*
+	* Input:
+	*		key_name			wstring				sanitised parameter name
+	* Output:
+	*		limit				LimitEntry*			limit of the parameter, NULL if there is none
+	*
+	*************************************************************************************************************************************************************************/
+	const LimitEntry* find(const wstring&) const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function returns all numeric test numbers of the catalog, used to seed TestNumberAllocator
+	*************************************************************************************************************************************************************************/
+	const vector<int>& test_numbers() const;
+
+	size_t size() const;
+	bool empty() const;
+	const wstring& source() const;
+	// content hash of the loaded file, changes whenever any limit changes
+	unsigned long long fingerprint() const;
+
+	LimitsCatalog();
+	~LimitsCatalog();
+
+private:
+	// sanitised parameter name -> limit
+	unordered_map<wstring, LimitEntry> limits;
+	vector<int> reserved_test_numbers;
+	wstring limits_path;
+	unsigned long long content_fingerprint;
+};
@@ -0,0 +1,126 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <codecvt>
+#include <locale>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+#ifdef _WIN32
+MappedFile::MappedFile() : file_handle(INVALID_HANDLE_VALUE), mapping_handle(NULL), view(NULL), view_size(0), opened(false)
+{
+}
+#else
+MappedFile::MappedFile() : file_descriptor(-1), view(NULL), view_size(0), opened(false)
+{
+}
+#endif
+
+
+MappedFile::~MappedFile()
+{
+	this->close();
+}
+
+bool MappedFile::open(const wstring& path) {
+	this->close();
+#ifdef _WIN32
+	this->file_handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (this->file_handle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(this->file_handle, &file_size)) {
+		this->close();
+		return false;
+	}
+	this->view_size = (size_t)file_size.QuadPart;
+	if (this->view_size > 0) {
+		// empty files can't be mapped
+		this->mapping_handle = CreateFileMappingW(this->file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (this->mapping_handle == NULL) {
+			this->close();
+			return false;
+		}
+		this->view = (const char*)MapViewOfFile(this->mapping_handle, FILE_MAP_READ, 0, 0, 0);
+		if (this->view == NULL) {
+			this->close();
+			return false;
+		}
+	}
+#else
+	string narrow_path = wstring_convert<codecvt_utf8<wchar_t>>().to_bytes(path);
+	this->file_descriptor = ::open(narrow_path.c_str(), O_RDONLY);
+	if (this->file_descriptor < 0) {
+		return false;
+	}
+	struct stat file_stat;
+	if (fstat(this->file_descriptor, &file_stat) != 0) {
+		this->close();
+		return false;
+	}
+	this->view_size = (size_t)file_stat.st_size;
+	if (this->view_size > 0) {
+		void *mapped = mmap(NULL, this->view_size, PROT_READ, MAP_PRIVATE, this->file_descriptor, 0);
+		if (mapped == MAP_FAILED) {
+			this->close();
+			return false;
+		}
+		madvise(mapped, this->view_size, MADV_SEQUENTIAL);
+		this->view = (const char*)mapped;
+	}
+#endif
+	this->opened = true;
+	return true;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+	if (this->view != NULL) {
+		UnmapViewOfFile(this->view);
+	}
+	if (this->mapping_handle != NULL) {
+		CloseHandle(this->mapping_handle);
+	}
+	if (this->file_handle != INVALID_HANDLE_VALUE) {
+		CloseHandle(this->file_handle);
+	}
+	this->mapping_handle = NULL;
+	this->file_handle = INVALID_HANDLE_VALUE;
+#else
+	if (this->view != NULL) {
+		munmap((void*)this->view, this->view_size);
+	}
+	if (this->file_descriptor >= 0) {
+		::close(this->file_descriptor);
+	}
+	this->file_descriptor = -1;
+#endif
+	this->view = NULL;
+	this->view_size = 0;
+	this->opened = false;
+}
+
+const char* MappedFile::data() const {
+	return this->view;
+}
+
+size_t MappedFile::size() const {
+	return this->view_size;
+}
+
+bool MappedFile::is_open() const {
+	return this->opened;
+}
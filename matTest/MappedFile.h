@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+#pragma once
+class MappedFile
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function maps a file read-only into memory
+	*
+	* Input:
+	*		path				wstring				absolute path of the file
+	* Output:
+	*		res					bool				success or not
+	*
+	* Empty files are opened successfully with size() 0 and data() NULL
+	*
+	*************************************************************************************************************************************************************************/
+	bool open(const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function unmaps the file, called by destructor as well
+	*************************************************************************************************************************************************************************/
+	void close();
+
+	const char* data() const;
+	size_t size() const;
+	bool is_open() const;
+
+	MappedFile();
+	~MappedFile();
+
+private:
+	// mapping must not be copied, it is released in the destructor
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+#ifdef _WIN32
+	void *file_handle;
+	void *mapping_handle;
+#else
+	int file_descriptor;
+#endif
+	const char *view;
+	size_t view_size;
+	bool opened;
+};
@@ -0,0 +1,112 @@
+#include "MetaFields.h"
+#include <algorithm>
+#include <cwchar>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+const wchar_t* const META_FIELD_NAMES[META_FIELD_COUNT] = {
+	L"basic_type",
+	L"cond_link_raw_data",
+	L"cond_link_screenshots",
+	L"data_object_type",
+	L"data_object_type_version",
+	L"description",
+	L"dut_id",
+	L"generator",
+	L"generator_domain",
+	L"generator_version",
+	L"idx",
+	L"limit_type",
+	L"netlist_label",
+	L"p_number",
+	L"package",
+	L"parameter_name",
+	L"product_design_step",
+	L"product_sales_code",
+	L"rddf_tc_id",
+	L"reqID",
+	L"simulation_type",
+	L"simulator_name",
+	L"subset_id",
+	L"test_name",
+	L"test_number",
+	L"test_program_name",
+	L"test_program_revision",
+	L"ts_data_created",
+	L"typical",
+	L"user_email_address",
+	L"user_name"
+};
+
+MetaFields::MetaFields()
+{
+}
+
+
+MetaFields::~MetaFields()
+{
+}
+
+MetaField MetaFields::field(const wstring& key) {
+	const wchar_t* const* begin = META_FIELD_NAMES;
+	const wchar_t* const* end = META_FIELD_NAMES + META_FIELD_COUNT;
+	const wchar_t* const* it = lower_bound(begin, end, key.c_str(),
+		[](const wchar_t* name, const wchar_t* k) { return wcscmp(name, k) < 0; });
+	if (it != end && key == *it) {
+		return (MetaField)(it - begin);
+	}
+	return META_FIELD_COUNT;
+}
+
+void MetaFields::set(MetaField field, const wstring& value) {
+	vector<pair<MetaField, wstring>>::iterator it = lower_bound(this->slot_values.begin(), this->slot_values.end(), field,
+		[](const pair<MetaField, wstring>& entry, MetaField f) { return entry.first < f; });
+	if (it != this->slot_values.end() && it->first == field) {
+		it->second = value;
+	}
+	else {
+		this->slot_values.insert(it, make_pair(field, value));
+	}
+}
+
+void MetaFields::set(const wstring& key, const wstring& value) {
+	MetaField slot = MetaFields::field(key);
+	if (slot != META_FIELD_COUNT) {
+		this->set(slot, value);
+		return;
+	}
+	vector<pair<wstring, wstring>>::iterator it = lower_bound(this->overflow_values.begin(), this->overflow_values.end(), key,
+		[](const pair<wstring, wstring>& entry, const wstring& k) { return entry.first < k; });
+	if (it != this->overflow_values.end() && it->first == key) {
+		it->second = value;
+	}
+	else {
+		this->overflow_values.insert(it, make_pair(key, value));
+	}
+}
+
+const wstring* MetaFields::find(MetaField field) const {
+	vector<pair<MetaField, wstring>>::const_iterator it = lower_bound(this->slot_values.begin(), this->slot_values.end(), field,
+		[](const pair<MetaField, wstring>& entry, MetaField f) { return entry.first < f; });
+	if (it != this->slot_values.end() && it->first == field) {
+		return &it->second;
+	}
+	return NULL;
+}
+
+const vector<pair<MetaField, wstring>>& MetaFields::slots() const {
+	return this->slot_values;
+}
+
+const vector<pair<wstring, wstring>>& MetaFields::overflow() const {
+	return this->overflow_values;
+}
+
+bool MetaFields::empty() const {
+	return this->slot_values.empty() && this->overflow_values.empty();
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+/*************************************************************************************************************************************************************************
+* Known metaData keys of value and limit objects. Order is the sort order of the key names,
+* so slots are serialised in the same order as the former map<wstring, wstring>
+*************************************************************************************************************************************************************************/
+enum MetaField {
+	META_BASIC_TYPE,
+	META_COND_LINK_RAW_DATA,
+	META_COND_LINK_SCREENSHOTS,
+	META_DATA_OBJECT_TYPE,
+	META_DATA_OBJECT_TYPE_VERSION,
+	META_DESCRIPTION,
+	META_DUT_ID,
+	META_GENERATOR,
+	META_GENERATOR_DOMAIN,
+	META_GENERATOR_VERSION,
+	META_IDX,
+	META_LIMIT_TYPE,
+	META_NETLIST_LABEL,
+	META_P_NUMBER,
+	META_PACKAGE,
+	META_PARAMETER_NAME,
+	META_PRODUCT_DESIGN_STEP,
+	META_PRODUCT_SALES_CODE,
+	META_RDDF_TC_ID,
+	META_REQ_ID,
+	META_SIMULATION_TYPE,
+	META_SIMULATOR_NAME,
+	META_SUBSET_ID,
+	META_TEST_NAME,
+	META_TEST_NUMBER,
+	META_TEST_PROGRAM_NAME,
+	META_TEST_PROGRAM_REVISION,
+	META_TS_DATA_CREATED,
+	META_TYPICAL,
+	META_USER_EMAIL_ADDRESS,
+	META_USER_NAME,
+	META_FIELD_COUNT
+};
+
+// key names of MetaField slots, sorted
+extern const wchar_t* const META_FIELD_NAMES[META_FIELD_COUNT];
+
+#pragma once
+class MetaFields
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function looks up the slot of a metaData key
+	*
+	* Input:
+	*		key				wstring				metaData key (e.g. test_name)
+	* Output:
+	*		field			MetaField			slot of key, META_FIELD_COUNT for keys without slot (e.g. cond_VIO)
+	*
+	*************************************************************************************************************************************************************************/
+	static MetaField field(const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* These functions set a metaData value
+	*
+	* Input:
+	*		field / key		MetaField / wstring		slot or key name, keys without slot are kept in the overflow list
+	*		value			wstring					value, empty values are written as ""
+	*
+	* Only assigned slots are stored, both lists are kept sorted by key
+	*
+	*************************************************************************************************************************************************************************/
+	void set(MetaField, const wstring&);
+	void set(const wstring&, const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function returns value of a slot, NULL if slot is not assigned
+	*************************************************************************************************************************************************************************/
+	const wstring* find(MetaField) const;
+
+	// assigned slots sorted by MetaField
+	const vector<pair<MetaField, wstring>>& slots() const;
+	// entries without slot sorted by key
+	const vector<pair<wstring, wstring>>& overflow() const;
+	bool empty() const;
+
+	MetaFields();
+	~MetaFields();
+
+private:
+	vector<pair<MetaField, wstring>> slot_values;
+	vector<pair<wstring, wstring>> overflow_values;
+};
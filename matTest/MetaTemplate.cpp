@@ -0,0 +1,49 @@
+#include "MetaTemplate.h"
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+MetaTemplate::MetaTemplate()
+{
+}
+
+
+MetaTemplate::~MetaTemplate()
+{
+}
+
+shared_ptr<MetaTemplate> MetaTemplate::derive(const shared_ptr<const MetaTemplate>& parent) {
+	shared_ptr<MetaTemplate> meta_template = make_shared<MetaTemplate>();
+	meta_template->parent_template = parent;
+	return meta_template;
+}
+
+void MetaTemplate::set_meta(MetaField field, const wstring& value) {
+	this->fields.set(field, value);
+}
+
+void MetaTemplate::set_meta(const wstring& key, const wstring& value) {
+	this->fields.set(key, value);
+}
+
+const wstring* MetaTemplate::find_meta(MetaField field) const {
+	for (const MetaTemplate *layer = this; layer != NULL; layer = layer->parent_template.get()) {
+		const wstring *value = layer->fields.find(field);
+		if (value != NULL) {
+			return value;
+		}
+	}
+	return NULL;
+}
+
+const MetaFields& MetaTemplate::own_fields() const {
+	return this->fields;
+}
+
+const shared_ptr<const MetaTemplate>& MetaTemplate::parent() const {
+	return this->parent_template;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <memory>
+#include "MetaFields.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+/*************************************************************************************************************************************************************************
+* Shared metaData template, e.g. per run (dut_id, package, user_name, ...), per subset (subset_id, cond_link_*)
+* or per row (cond_*, idx). Templates are chained: a field not set in a template is taken from its parent.
+* A template is filled once and then only shared as shared_ptr<const MetaTemplate>; changes are made by
+* deriving a new template from it (copy-on-write), so objects referring to it never see a change.
+*************************************************************************************************************************************************************************/
+#pragma once
+class MetaTemplate
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function creates a new template on top of parent
+	*
+	* Input:
+	*		parent			shared_ptr<const MetaTemplate>		template providing fields not set here, may be empty
+	* Output:
+	*		template		shared_ptr<MetaTemplate>			new template, to be filled before it is shared
+	*
+	*************************************************************************************************************************************************************************/
+	static shared_ptr<MetaTemplate> derive(const shared_ptr<const MetaTemplate>&);
+
+	void set_meta(MetaField, const wstring&);
+	void set_meta(const wstring&, const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function returns value of a slot from this template or its parents, NULL if not set
+	*************************************************************************************************************************************************************************/
+	const wstring* find_meta(MetaField) const;
+
+	const MetaFields& own_fields() const;
+	const shared_ptr<const MetaTemplate>& parent() const;
+
+	MetaTemplate();
+	~MetaTemplate();
+
+private:
+	MetaFields fields;
+	shared_ptr<const MetaTemplate> parent_template;
+};
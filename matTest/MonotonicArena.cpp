@@ -0,0 +1,105 @@
+#include "MonotonicArena.h"
+#include <cstdlib>
+#include <new>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+MonotonicArena::MonotonicArena(size_t initial_block_size) :
+	blocks(NULL), cursor(NULL), limit(NULL), next_block_size(initial_block_size),
+	bytes_in_use(0), allocations(0), high_water(0), heap_blocks(0), releases(0) {
+}
+
+MonotonicArena::~MonotonicArena() {
+	while (this->blocks != NULL) {
+		block_header *next = this->blocks->next;
+		free(this->blocks);
+		this->blocks = next;
+	}
+}
+
+void MonotonicArena::add_block(size_t min_size) {
+	size_t size = this->next_block_size;
+	while (size < min_size) {
+		size *= 2;
+	}
+	block_header *block = static_cast<block_header*>(malloc(sizeof(block_header) + size));
+	if (block == NULL) {
+		throw bad_alloc();
+	}
+	block->next = this->blocks;
+	block->size = size;
+	this->blocks = block;
+	this->cursor = reinterpret_cast<char*>(block + 1);
+	this->limit = this->cursor + size;
+	// grow geometrically so large subsets need only a few blocks
+	this->next_block_size = size * 2;
+	this->heap_blocks++;
+}
+
+void* MonotonicArena::allocate(size_t bytes, size_t alignment) {
+	if (bytes == 0) {
+		bytes = 1;
+	}
+	size_t padding = (alignment - (reinterpret_cast<size_t>(this->cursor) & (alignment - 1))) & (alignment - 1);
+	if (this->cursor == NULL || padding + bytes > (size_t)(this->limit - this->cursor)) {
+		add_block(bytes + alignment);
+		padding = (alignment - (reinterpret_cast<size_t>(this->cursor) & (alignment - 1))) & (alignment - 1);
+	}
+	void *memory = this->cursor + padding;
+	this->cursor += padding + bytes;
+	this->bytes_in_use += padding + bytes;
+	if (this->bytes_in_use > this->high_water) {
+		this->high_water = this->bytes_in_use;
+	}
+	this->allocations++;
+	return memory;
+}
+
+void MonotonicArena::release() {
+	if (this->blocks == NULL) {
+		return;
+	}
+	// newest block is the largest one, keep it
+	block_header *kept = this->blocks;
+	block_header *block = kept->next;
+	while (block != NULL) {
+		block_header *next = block->next;
+		free(block);
+		block = next;
+	}
+	kept->next = NULL;
+	this->cursor = reinterpret_cast<char*>(kept + 1);
+	this->limit = this->cursor + kept->size;
+	this->next_block_size = kept->size * 2;
+	this->bytes_in_use = 0;
+	this->releases++;
+}
+
+size_t MonotonicArena::allocation_count() const {
+	return this->allocations;
+}
+
+size_t MonotonicArena::high_water_mark() const {
+	return this->high_water;
+}
+
+size_t MonotonicArena::block_count() const {
+	return this->heap_blocks;
+}
+
+size_t MonotonicArena::release_count() const {
+	return this->releases;
+}
+
+void MonotonicArena::reset_statistics() {
+	this->allocations = 0;
+	this->high_water = this->bytes_in_use;
+	this->heap_blocks = 0;
+	this->releases = 0;
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <scoped_allocator>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+#pragma once
+class MonotonicArena
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function hands out memory from the current block, a new block is taken from the heap if it is full
+	*
+	* Input:
+	*		bytes				size_t				requested size
+	*		alignment			size_t				required alignment (power of 2)
+	* Output:
+	*		memory				void*				never NULL, bad_alloc is thrown if the heap is exhausted
+	*
+	* Memory is never given back one by one. All of it is reused at once with release()
+	*
+	*************************************************************************************************************************************************************************/
+	void* allocate(size_t, size_t);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function releases all allocations in one shot
+	*
+	* The largest block is kept for the next row batch, all other blocks are returned to the heap
+	* Containers using the arena must be destroyed before
+	*
+	*************************************************************************************************************************************************************************/
+	void release();
+
+	// number of allocate() calls since construction or reset_statistics()
+	size_t allocation_count() const;
+	// highest number of bytes in use between two releases
+	size_t high_water_mark() const;
+	// number of blocks taken from the heap
+	size_t block_count() const;
+	// number of release() calls
+	size_t release_count() const;
+	void reset_statistics();
+
+	template <class T>
+	class Allocator;
+
+	// allocator for containers of T using this arena
+	template <class T>
+	Allocator<T> allocator() {
+		return Allocator<T>(this);
+	}
+
+	explicit MonotonicArena(size_t initial_block_size = 64 * 1024);
+	~MonotonicArena();
+
+private:
+	// arena must not be copied, blocks are freed in the destructor
+	MonotonicArena(const MonotonicArena&);
+	MonotonicArena& operator=(const MonotonicArena&);
+
+	struct block_header {
+		block_header *next;
+		size_t size;
+	};
+
+	void add_block(size_t);
+
+	block_header *blocks;
+	char *cursor;
+	char *limit;
+	size_t next_block_size;
+	size_t bytes_in_use;
+	size_t allocations;
+	size_t high_water;
+	size_t heap_blocks;
+	size_t releases;
+};
+
+
+/*************************************************************************************************************************************************************************
+* Allocator for standard containers, deallocate is a no-op because the arena is released as a whole
+*************************************************************************************************************************************************************************/
+template <class T>
+class MonotonicArena::Allocator
+{
+
+public:
+	typedef T value_type;
+
+	template <class U>
+	struct rebind {
+		typedef MonotonicArena::Allocator<U> other;
+	};
+
+	explicit Allocator(MonotonicArena *arena) : arena(arena) {}
+
+	template <class U>
+	Allocator(const Allocator<U>& other) : arena(other.arena) {}
+
+	T* allocate(size_t n) {
+		return static_cast<T*>(this->arena->allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T*, size_t) {}
+
+	template <class U>
+	bool operator==(const Allocator<U>& other) const {
+		return this->arena == other.arena;
+	}
+
+	template <class U>
+	bool operator!=(const Allocator<U>& other) const {
+		return this->arena != other.arena;
+	}
+
+	MonotonicArena *arena;
+};
+
+// per row wstring living in a MonotonicArena
+typedef basic_string<wchar_t, char_traits<wchar_t>, MonotonicArena::Allocator<wchar_t>> arena_wstring;
+// per row list of wstrings, elements are allocated from the same arena as the vector
+typedef vector<arena_wstring, scoped_allocator_adaptor<MonotonicArena::Allocator<arena_wstring>>> arena_wstring_vector;
+
+// copies an arena_wstring into a normal wstring for objects outliving the row
+inline wstring from_arena(const arena_wstring& value) {
+	return wstring(value.data(), value.size());
+}
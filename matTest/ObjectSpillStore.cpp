@@ -0,0 +1,182 @@
+#include "ObjectSpillStore.h"
+#include <stdexcept>
+#include <system_error>
+#include <experimental\filesystem>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+namespace filesys = std::experimental::filesystem;
+
+// map node, key and object bookkeeping per entry
+static size_t entry_memory(const wstring& key, const DataObject& object) {
+	return 4 * sizeof(void*) + sizeof(wstring) + (key.capacity() + 1) * sizeof(wchar_t) + object.memory_size();
+}
+
+static void write_run_key(ostream& out, const wstring& key) {
+	unsigned int size = (unsigned int)key.size();
+	out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+	out.write(reinterpret_cast<const char*>(key.data()), key.size() * sizeof(wchar_t));
+}
+
+static bool read_run_key(istream& in, wstring& key) {
+	unsigned int size = 0;
+	in.read(reinterpret_cast<char*>(&size), sizeof(size));
+	if (!in.good()) {
+		return false;
+	}
+	key.resize(size);
+	if (size > 0) {
+		in.read(reinterpret_cast<char*>(&key[0]), size * sizeof(wchar_t));
+	}
+	return in.good();
+}
+
+ObjectSpillStore::ObjectSpillStore(size_t memory_budget, const wstring& spill_prefix, const shared_ptr<const MetaTemplate>& shared_base) :
+	memory_budget(memory_budget), spill_prefix(spill_prefix), shared_base(shared_base),
+	memory_in_use(0), memory_peak(0), runs_written(0), objects_spilled(0), bytes_spilled(0), merging(false) {
+}
+
+ObjectSpillStore::~ObjectSpillStore() {
+	remove_runs();
+}
+
+void ObjectSpillStore::put(const wstring& key, DataObject&& object) {
+	size_t added = entry_memory(key, object);
+	map<wstring, DataObject>::iterator it = this->objects.find(key);
+	if (it != this->objects.end()) {
+		this->memory_in_use -= entry_memory(it->first, it->second);
+		it->second = move(object);
+	}
+	else {
+		this->objects.emplace(key, move(object));
+	}
+	this->memory_in_use += added;
+	if (this->memory_in_use > this->memory_peak) {
+		this->memory_peak = this->memory_in_use;
+	}
+	if (this->memory_budget > 0 && this->memory_in_use > this->memory_budget) {
+		spill_run();
+	}
+}
+
+void ObjectSpillStore::spill_run() {
+	wstring run_path = this->spill_prefix + L"_" + to_wstring(this->run_paths.size()) + L".spill";
+	ofstream run_out(run_path, ios::binary | ios::trunc);
+	if (!run_out) {
+		throw runtime_error("Couldn't create spill file");
+	}
+	this->run_paths.push_back(run_path);
+	this->runs_written++;
+	// map is sorted, so every run is sorted by key
+	for (map<wstring, DataObject>::value_type& entry : this->objects) {
+		write_run_key(run_out, entry.first);
+		entry.second.write_spill(run_out, this->shared_base.get());
+	}
+	this->bytes_spilled += (size_t)run_out.tellp();
+	run_out.close();
+	if (run_out.fail()) {
+		throw runtime_error("Couldn't write spill file");
+	}
+	this->objects_spilled += this->objects.size();
+	this->objects.clear();
+	this->memory_in_use = 0;
+}
+
+void ObjectSpillStore::start_merge() {
+	this->merging = true;
+	for (const wstring& run_path : this->run_paths) {
+		unique_ptr<run_cursor> cursor(new run_cursor());
+		cursor->in.open(run_path, ios::binary);
+		if (!cursor->in) {
+			throw runtime_error("Couldn't open spill file");
+		}
+		cursor->valid = false;
+		this->cursors.push_back(move(cursor));
+		advance(this->cursors.size() - 1);
+	}
+	this->memory_cursor = this->objects.begin();
+}
+
+void ObjectSpillStore::advance(size_t run) {
+	run_cursor& cursor = *this->cursors[run];
+	cursor.valid = read_run_key(cursor.in, cursor.key) && cursor.object.read_spill(cursor.in, this->shared_base);
+}
+
+bool ObjectSpillStore::next(DataObject& object) {
+	if (!this->merging) {
+		start_merge();
+	}
+	// smallest key over all runs and the objects in memory
+	const wstring *next_key = NULL;
+	for (const unique_ptr<run_cursor>& cursor : this->cursors) {
+		if (cursor->valid && (next_key == NULL || cursor->key < *next_key)) {
+			next_key = &cursor->key;
+		}
+	}
+	bool from_memory = false;
+	if (this->memory_cursor != this->objects.end() && (next_key == NULL || this->memory_cursor->first <= *next_key)) {
+		next_key = &this->memory_cursor->first;
+		from_memory = true;
+	}
+	if (next_key == NULL) {
+		// all sources are done
+		this->objects.clear();
+		this->memory_cursor = this->objects.end();
+		remove_runs();
+		return false;
+	}
+	wstring key = *next_key;
+	// newest source wins for repeated keys: objects in memory, then the latest run
+	bool taken = false;
+	if (from_memory) {
+		object = move(this->memory_cursor->second);
+		++this->memory_cursor;
+		taken = true;
+	}
+	for (size_t run = this->cursors.size(); run-- > 0;) {
+		run_cursor& cursor = *this->cursors[run];
+		if (cursor.valid && cursor.key == key) {
+			if (!taken) {
+				object = move(cursor.object);
+				taken = true;
+			}
+			advance(run);
+		}
+	}
+	return true;
+}
+
+void ObjectSpillStore::remove_runs() {
+	this->cursors.clear();
+	for (const wstring& run_path : this->run_paths) {
+		error_code error;
+		filesys::remove(run_path, error);
+	}
+	this->run_paths.clear();
+}
+
+bool ObjectSpillStore::spilled() const {
+	return this->objects_spilled > 0;
+}
+
+size_t ObjectSpillStore::run_count() const {
+	return this->runs_written;
+}
+
+size_t ObjectSpillStore::spilled_objects() const {
+	return this->objects_spilled;
+}
+
+size_t ObjectSpillStore::spilled_bytes() const {
+	return this->bytes_spilled;
+}
+
+size_t ObjectSpillStore::peak_memory() const {
+	return this->memory_peak;
+}
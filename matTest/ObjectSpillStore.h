@@ -0,0 +1,106 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <fstream>
+#include "DataObject.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+#pragma once
+class ObjectSpillStore
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function creates the store for the value objects of one subset (former internal_json)
+	*
+	* Input:
+	*		memory_budget		size_t								bytes of objects kept in memory, 0 for no limit
+	*		spill_prefix		wstring								path prefix of the temporary run files
+	*		shared_base			shared_ptr<const MetaTemplate>		template staying in memory, objects are written without it
+	*
+	*************************************************************************************************************************************************************************/
+	ObjectSpillStore(size_t, const wstring&, const shared_ptr<const MetaTemplate>&);
+	~ObjectSpillStore();
+
+
+	/*************************************************************************************************************************************************************************
+	* This function stores an object under key, an object stored before under the same key is replaced
+	*
+	* Input:
+	*		key					wstring				key_cond_str of the object
+	*		object				DataObject			moved into the store
+	*
+	* Once the budget is exceeded, all objects in memory are written as one sorted run to a temporary file
+	*
+	*************************************************************************************************************************************************************************/
+	void put(const wstring&, DataObject&&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function returns the next object in key order, merging the runs on disk and the objects in memory
+	*
+	* Input:
+	*		object				DataObject			receives the object
+	* Output:
+	*		res					bool				false once all objects are returned, the store is empty then
+	*
+	* For keys stored more than once the last stored object is returned, the same as for the in memory map
+	* No put() is allowed after the first call
+	*
+	*************************************************************************************************************************************************************************/
+	bool next(DataObject&);
+
+	// true if at least one run was written to disk
+	bool spilled() const;
+	size_t run_count() const;
+	size_t spilled_objects() const;
+	size_t spilled_bytes() const;
+	size_t peak_memory() const;
+
+private:
+	ObjectSpillStore(const ObjectSpillStore&);
+	ObjectSpillStore& operator=(const ObjectSpillStore&);
+
+	// head entry of one run during the merge
+	struct run_cursor {
+		ifstream in;
+		wstring key;
+		DataObject object;
+		bool valid;
+	};
+
+	void spill_run();
+	void start_merge();
+	void advance(size_t);
+	void remove_runs();
+
+	size_t memory_budget;
+	wstring spill_prefix;
+	shared_ptr<const MetaTemplate> shared_base;
+
+	map<wstring, DataObject> objects;
+	size_t memory_in_use;
+	size_t memory_peak;
+
+	vector<wstring> run_paths;
+	size_t runs_written;
+	size_t objects_spilled;
+	size_t bytes_spilled;
+
+	// merge state, runs first, objects in memory are the newest source
+	bool merging;
+	vector<unique_ptr<run_cursor>> cursors;
+	map<wstring, DataObject>::iterator memory_cursor;
+};
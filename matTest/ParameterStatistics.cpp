@@ -0,0 +1,236 @@
+#include "ParameterStatistics.h"
+#include "UnitScaling.h"
+#include <algorithm>
+#include <cmath>
+#include <cwctype>
+#include <limits>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+static wstring lower_trimmed(const wstring& text) {
+	size_t begin = text.find_first_not_of(L" \t");
+	size_t end = text.find_last_not_of(L" \t");
+	if (begin == wstring::npos) {
+		return L"";
+	}
+	wstring lower = text.substr(begin, end - begin + 1);
+	for (wchar_t& c : lower) {
+		c = towlower(c);
+	}
+	return lower;
+}
+
+MomentAccumulator::MomentAccumulator() : count(0), mean(0), m2(0), min(numeric_limits<double>::infinity()), max(-numeric_limits<double>::infinity())
+{
+}
+
+void MomentAccumulator::add(const double* values, size_t value_count) {
+	if (value_count == 0) {
+		return;
+	}
+	// four independent lanes, so the compiler can keep them in vector registers
+	double sum[4] = { 0, 0, 0, 0 };
+	double lane_min[4] = { values[0], values[0], values[0], values[0] };
+	double lane_max[4] = { values[0], values[0], values[0], values[0] };
+	size_t i = 0;
+	for (; i + 4 <= value_count; i += 4) {
+		for (int lane = 0; lane < 4; lane++) {
+			sum[lane] += values[i + lane];
+			lane_min[lane] = values[i + lane] < lane_min[lane] ? values[i + lane] : lane_min[lane];
+			lane_max[lane] = values[i + lane] > lane_max[lane] ? values[i + lane] : lane_max[lane];
+		}
+	}
+	for (; i < value_count; i++) {
+		sum[0] += values[i];
+		lane_min[0] = values[i] < lane_min[0] ? values[i] : lane_min[0];
+		lane_max[0] = values[i] > lane_max[0] ? values[i] : lane_max[0];
+	}
+	MomentAccumulator block;
+	block.count = value_count;
+	block.mean = (sum[0] + sum[1] + sum[2] + sum[3]) / value_count;
+	block.min = std::min(std::min(lane_min[0], lane_min[1]), std::min(lane_min[2], lane_min[3]));
+	block.max = std::max(std::max(lane_max[0], lane_max[1]), std::max(lane_max[2], lane_max[3]));
+	// deviations from the block mean, no cancellation as with the sum of squares
+	double m2[4] = { 0, 0, 0, 0 };
+	i = 0;
+	for (; i + 4 <= value_count; i += 4) {
+		for (int lane = 0; lane < 4; lane++) {
+			double deviation = values[i + lane] - block.mean;
+			m2[lane] += deviation * deviation;
+		}
+	}
+	for (; i < value_count; i++) {
+		double deviation = values[i] - block.mean;
+		m2[0] += deviation * deviation;
+	}
+	block.m2 = m2[0] + m2[1] + m2[2] + m2[3];
+	this->merge(block);
+}
+
+void MomentAccumulator::merge(const MomentAccumulator& other) {
+	if (other.count == 0) {
+		return;
+	}
+	if (this->count == 0) {
+		*this = other;
+		return;
+	}
+	double total = (double)(this->count + other.count);
+	double delta = other.mean - this->mean;
+	this->mean += delta * other.count / total;
+	this->m2 += other.m2 + delta * delta * ((double)this->count * other.count / total);
+	this->count += other.count;
+	this->min = std::min(this->min, other.min);
+	this->max = std::max(this->max, other.max);
+}
+
+double MomentAccumulator::sigma() const {
+	if (this->count < 2) {
+		return 0;
+	}
+	return sqrt(this->m2 / (this->count - 1));
+}
+
+// entries of a comma separated list, trimmed and in lower case
+static vector<wstring> split_list(const wstring& list) {
+	vector<wstring> entries;
+	size_t start = 0;
+	while (start <= list.size()) {
+		size_t comma = list.find(L',', start);
+		if (comma == wstring::npos) {
+			comma = list.size();
+		}
+		wstring entry = lower_trimmed(list.substr(start, comma - start));
+		if (!entry.empty()) {
+			entries.push_back(entry);
+		}
+		start = comma + 1;
+	}
+	return entries;
+}
+
+ParameterStatistics::ParameterStatistics(const wstring& group_by, const wstring& quantiles) : group_by(split_list(group_by))
+{
+	for (const wstring& quantile : split_list(quantiles)) {
+		double percentile;
+		if (UnitScaling::parse_double(quantile, &percentile) && isfinite(percentile) && percentile >= 0 && percentile <= 100) {
+			wstring key = L"p" + quantile;
+			replace(key.begin(), key.end(), L'.', L'_');
+			this->quantiles.push_back(make_pair(percentile, key));
+		}
+	}
+}
+
+bool ParameterStatistics::groups_by(const wstring& condition) const {
+	return find(this->group_by.begin(), this->group_by.end(), lower_trimmed(condition)) != this->group_by.end();
+}
+
+void ParameterStatistics::set_row_conditions(const vector<pair<wstring, wstring>>& conditions) {
+	this->row_conditions = conditions;
+	this->row_key.clear();
+	for (const pair<wstring, wstring>& condition : conditions) {
+		this->row_key += condition.first + L"=" + condition.second + L";";
+	}
+}
+
+void ParameterStatistics::add(const wstring& test_name, const wstring& test_number, const wstring& value) {
+	ParameterGroup& group = this->groups[test_name + L"\n" + this->row_key];
+	if (group.test_name.empty()) {
+		group.test_name = test_name;
+		group.test_number = test_number;
+		group.conditions = this->row_conditions;
+		group.block.reserve(STATISTICS_BLOCK);
+	}
+	// empty text, text which isn't a number, NaN and inf are invalid
+	double number;
+	if (!UnitScaling::parse_double(value, &number) || !isfinite(number)) {
+		group.invalid_count++;
+		return;
+	}
+	group.block.push_back(number);
+	if (group.block.size() == STATISTICS_BLOCK) {
+		group.moments.add(group.block.data(), group.block.size());
+		group.digest.add(group.block.data(), group.block.size());
+		group.block.clear();
+	}
+}
+
+void ParameterStatistics::set_limits(const wstring& test_name, double lower, double upper) {
+	this->limits[test_name] = make_pair(lower, upper);
+}
+
+void ParameterStatistics::append_summary_objects(vector<DataObject>& objects, const shared_ptr<const MetaTemplate>& summary_template, const wstring& subset_id) {
+	// sort groups to get the same objects for the same input
+	map<wstring, ParameterGroup*> sorted;
+	for (unordered_map<wstring, ParameterGroup>::value_type& group : this->groups) {
+		sorted[group.first] = &group.second;
+	}
+	for (map<wstring, ParameterGroup*>::value_type& entry : sorted) {
+		ParameterGroup& group = *entry.second;
+		group.moments.add(group.block.data(), group.block.size());
+		group.digest.add(group.block.data(), group.block.size());
+		group.block.clear();
+
+		DataObject summary_object;
+		summary_object.set_template(summary_template);
+		summary_object.set_meta(META_PARAMETER_NAME, group.test_name);
+		summary_object.set_meta(META_TEST_NUMBER, group.test_number);
+		summary_object.set_meta(META_SUBSET_ID, subset_id);
+		summary_object.set_meta(L"summary_type", L"statistics");
+		for (const pair<wstring, wstring>& condition : group.conditions) {
+			summary_object.set_meta(condition.first, condition.second);
+		}
+		const MomentAccumulator& moments = group.moments;
+		summary_object.set_payload(L"count", to_wstring(moments.count));
+		summary_object.set_payload(L"invalid_count", to_wstring(group.invalid_count));
+		if (moments.count > 0) {
+			summary_object.set_payload(L"mean", UnitScaling::format_double(moments.mean));
+			summary_object.set_payload(L"sigma", UnitScaling::format_double(moments.sigma()));
+			summary_object.set_payload(L"min", UnitScaling::format_double(moments.min));
+			summary_object.set_payload(L"max", UnitScaling::format_double(moments.max));
+			for (const pair<double, wstring>& quantile : this->quantiles) {
+				summary_object.set_payload(quantile.second, UnitScaling::format_double(group.digest.quantile(quantile.first / 100)));
+			}
+			summary_object.set_payload(L"tdigest", group.digest.to_string());
+		}
+		// Cpk against the limits which are set, Cp needs both
+		map<wstring, pair<double, double>>::const_iterator limit = this->limits.find(group.test_name);
+		double sigma = moments.sigma();
+		if (limit != this->limits.end() && sigma > 0) {
+			double lower_limit = limit->second.first;
+			double upper_limit = limit->second.second;
+			double cpk = numeric_limits<double>::quiet_NaN();
+			if (!isnan(lower_limit)) {
+				cpk = (moments.mean - lower_limit) / (3 * sigma);
+			}
+			if (!isnan(upper_limit)) {
+				double cpu = (upper_limit - moments.mean) / (3 * sigma);
+				cpk = isnan(cpk) ? cpu : std::min(cpk, cpu);
+			}
+			if (!isnan(lower_limit) && !isnan(upper_limit)) {
+				summary_object.set_payload(L"cp", UnitScaling::format_double((upper_limit - lower_limit) / (6 * sigma)));
+			}
+			if (!isnan(cpk)) {
+				summary_object.set_payload(L"cpk", UnitScaling::format_double(cpk));
+			}
+		}
+		objects.push_back(move(summary_object));
+	}
+	this->clear();
+}
+
+void ParameterStatistics::clear() {
+	this->groups.clear();
+	this->limits.clear();
+	this->row_conditions.clear();
+	this->row_key.clear();
+}
+
+size_t ParameterStatistics::group_count() const {
+	return this->groups.size();
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <map>
+#include <memory>
+#include "DataObject.h"
+#include "MetaTemplate.h"
+#include "TDigest.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// values of a parameter are collected in blocks of this size and added to its moments block by block
+static const size_t STATISTICS_BLOCK = 256;
+
+// count, mean and sum of squared deviations from the mean (M2) of a set of values
+struct MomentAccumulator {
+	unsigned long long count;
+	double mean;
+	double m2;
+	double min;
+	double max;
+
+	MomentAccumulator();
+	// adds a block of values: mean and M2 of the block are taken in two passes, then merged
+	void add(const double*, size_t);
+	// merges the moments of another set of values (Chan et al.), the result is the same as adding its values
+	void merge(const MomentAccumulator&);
+	// sample standard deviation, 0 for less than 2 values
+	double sigma() const;
+};
+
+// statistics of one parameter in one condition group
+struct ParameterGroup {
+	wstring test_name;
+	wstring test_number;
+	// grouping conditions of the rows (meta key, value), e.g. cond_tambient, 25.000000
+	vector<pair<wstring, wstring>> conditions;
+	// numeric values not yet added to the moments
+	vector<double> block;
+	MomentAccumulator moments;
+	// distribution of the values for the quantiles
+	TDigest digest;
+	// values which aren't numbers (NaN, empty, text)
+	unsigned long long invalid_count;
+
+	ParameterGroup() : invalid_count(0) {}
+};
+
+#pragma once
+class ParameterStatistics
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function creates the statistics of the out parameters of a subset
+	*
+	* Input:
+	*		group_by			wstring				condition names (without cond_, any case) whose values form the condition group, comma separated
+	*		quantiles			wstring				percentiles of the summary objects, comma separated (e.g. 0.1,50,99.9)
+	*
+	* Values are kept per parameter and condition group of their row, an empty group_by keeps one group per parameter
+	*
+	*************************************************************************************************************************************************************************/
+	ParameterStatistics(const wstring&, const wstring&);
+
+	// true if the values of the condition column are part of the condition group
+	bool groups_by(const wstring&) const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function sets the condition group of the values added next (the conditions of the current row)
+	*
+	* Input:
+	*		conditions			vector<pair>		meta key and value of each grouping condition of the row
+	*
+	*************************************************************************************************************************************************************************/
+	void set_row_conditions(const vector<pair<wstring, wstring>>&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function adds a value to the statistics of its parameter in the current condition group
+	*
+	* Input:
+	*		test_name			wstring				name of the parameter
+	*		test_number			wstring				test number of the parameter
+	*		value				wstring				text of the value object payload
+	*
+	*************************************************************************************************************************************************************************/
+	void add(const wstring&, const wstring&, const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function sets the limits of a parameter for Cp and Cpk
+	*
+	* Input:
+	*		test_name			wstring				name of the parameter
+	*		lower / upper		double				limits in the unit of the values (not the one of the limit object), NaN if not set
+	*
+	*************************************************************************************************************************************************************************/
+	void set_limits(const wstring&, double, double);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function appends one summary object per parameter and condition group
+	*
+	* Input:
+	*		summary_template	shared_ptr			template of all summary objects (common meta data, data_object_type summary)
+	*		subset_id			wstring				id of the subset the statistics belong to
+	* Output:
+	*		objects				vector<DataObject>	summary objects are appended, sorted by test name and conditions
+	*
+	* Meta data: parameter_name, test_number, subset_id, summary_type statistics and the grouping conditions
+	* Payload: count, invalid_count, mean, sigma, min, max, cp and cpk if the parameter has limits, one p<percentile> per quantile (p99_9 for 99.9)
+	* and the t-digest of the values (tdigest), which merges with the ones of other subsets. The statistics are cleared afterwards
+	*
+	*************************************************************************************************************************************************************************/
+	void append_summary_objects(vector<DataObject>&, const shared_ptr<const MetaTemplate>&, const wstring&);
+
+	void clear();
+	size_t group_count() const;
+
+private:
+	// lowercase condition names of the group
+	vector<wstring> group_by;
+	// percentile and its payload key
+	vector<pair<double, wstring>> quantiles;
+	// conditions and key of the current row
+	vector<pair<wstring, wstring>> row_conditions;
+	wstring row_key;
+	// test_name + '\n' + row key -> statistics
+	unordered_map<wstring, ParameterGroup> groups;
+	// test_name -> lower and upper limit, NaN if not set
+	map<wstring, pair<double, double>> limits;
+};
@@ -0,0 +1,61 @@
+#include "RepetitionCounter.h"
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+RepetitionCounter::RepetitionCounter() : repeated_keys(0)
+{
+}
+
+
+RepetitionCounter::~RepetitionCounter()
+{
+}
+
+int RepetitionCounter::record(const wstring& key, const wstring& test_name, const wstring& label) {
+	repetition_entry& entry = this->repetitions[key];
+	if (entry.count == 0) {
+		// first occurence, keep names for the summary
+		entry.test_name = test_name;
+		entry.label = label;
+	}
+	else if (entry.count == 1) {
+		this->repeated_keys++;
+	}
+	return entry.count++;
+}
+
+int RepetitionCounter::count(const wstring& key) const {
+	unordered_map<wstring, repetition_entry>::const_iterator it = this->repetitions.find(key);
+	if (it == this->repetitions.end()) {
+		return 0;
+	}
+	return it->second.count;
+}
+
+vector<wstring> RepetitionCounter::summary_lines(const wstring& subset_id) const {
+	vector<wstring> lines;
+	if (this->repeated_keys == 0) {
+		return lines;
+	}
+	// sort repeated keys to get the same summary for the same input
+	map<wstring, const repetition_entry*> repeated;
+	for (const unordered_map<wstring, repetition_entry>::value_type& rep : this->repetitions) {
+		if (rep.second.count > 1) {
+			repeated[rep.first] = &rep.second;
+		}
+	}
+	for (map<wstring, const repetition_entry*>::value_type& rep : repeated) {
+		lines.push_back(subset_id + L"\t" + rep.second->test_name + L"\t" + rep.second->label + L"\t" + to_wstring(rep.second->count));
+	}
+	return lines;
+}
+
+void RepetitionCounter::clear() {
+	this->repetitions.clear();
+	this->repeated_keys = 0;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <map>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+#pragma once
+class RepetitionCounter
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function records one more occurence of a key
+	*
+	* Input:
+	*		key					wstring				internal key of the data object (test name + condition string)
+	*		test_name			wstring				test name of the data object
+	*		label				wstring				readable condition description used for the summary (e.g. tambient=25, VIO=3.3)
+	* Output:
+	*		rep					int					number of earlier occurences of key (0 for the first one)
+	*
+	* The counter is kept per key, so the _repN suffix of a repeated condition is known without
+	* scanning the already stored objects
+	*
+	*************************************************************************************************************************************************************************/
+	int record(const wstring&, const wstring&, const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function returns how often a key was recorded
+	*
+	* Input:
+	*		key					wstring				internal key of the data object
+	* Output:
+	*		count				int					number of occurences, 0 if key is unknown
+	*
+	*************************************************************************************************************************************************************************/
+	int count(const wstring&) const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function creates the repetition summary of all repeated keys
+	*
+	* Input:
+	*		subset_id			wstring				id of the subset the counter belongs to
+	* Output:
+	*		lines				vector<wstring>		one tab separated line per repeated key: subset_id, test_name, conditions, count
+	*
+	* Keys which occured only once are skipped. Lines are sorted by key to keep the report stable
+	*
+	*************************************************************************************************************************************************************************/
+	vector<wstring> summary_lines(const wstring&) const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function resets the counter, called when a new subset starts
+	*************************************************************************************************************************************************************************/
+	void clear();
+
+	RepetitionCounter();
+	~RepetitionCounter();
+
+private:
+	struct repetition_entry {
+		int count;
+		wstring test_name;
+		wstring label;
+	};
+	// key_cond_str -> number of occurences, test name and readable condition label
+	unordered_map<wstring, repetition_entry> repetitions;
+	// number of keys which occured more than once
+	int repeated_keys;
+};
@@ -0,0 +1,146 @@
+#include "ReportLease.h"
+#include "SpoolQueue.h"
+#include "ConversionLog.h"
+#include <fstream>
+#include <chrono>
+#include <codecvt>
+#include <locale>
+#include <system_error>
+#include <experimental\filesystem>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+namespace filesys = std::experimental::filesystem;
+
+static string to_utf8(const wstring& text) {
+	return wstring_convert<codecvt_utf8<wchar_t>>().to_bytes(text);
+}
+
+// holder written into the lease file, empty if it can't be read
+static string lease_owner(const wstring& lease_file) {
+	ifstream lease_in(lease_file, ios::binary);
+	string owner;
+	getline(lease_in, owner);
+	return owner;
+}
+
+ReportLease::ReportLease(const wstring& report_folder) :
+	lease_file((filesys::path(report_folder) / L"converting.lease").wstring()), held(false), released(false) {
+	error_code error;
+	filesys::create_directories(report_folder, error);
+	bool waiting = false;
+	while (true) {
+		CreateResult created = try_create();
+		if (created == LEASE_CREATED) {
+			this->held = true;
+			break;
+		}
+		if (created == LEASE_ERROR) {
+			LogLine() << L"Couldn't take the lease " << this->lease_file << L", converting without it";
+			return;
+		}
+		if (take_over_expired()) {
+			continue;
+		}
+		if (!waiting) {
+			LogLine() << L"Waiting for the conversion of " << lease_owner(this->lease_file).c_str() << L" in " << report_folder;
+			waiting = true;
+		}
+		this_thread::sleep_for(chrono::seconds(1));
+	}
+	this->lease_keeper = thread(&ReportLease::renew_until_released, this);
+}
+
+ReportLease::~ReportLease() {
+	if (this->lease_keeper.joinable()) {
+		{
+			lock_guard<mutex> lock(this->lease_mutex);
+			this->released = true;
+		}
+		this->lease_released.notify_all();
+		this->lease_keeper.join();
+	}
+	// a lease taken over by another host is left to it
+	if (this->held && lease_owner(this->lease_file) == to_utf8(SpoolQueue::local_owner())) {
+		error_code error;
+		filesys::remove(this->lease_file, error);
+	}
+}
+
+bool ReportLease::is_held() const {
+	lock_guard<mutex> lock(this->lease_mutex);
+	return this->held;
+}
+
+ReportLease::CreateResult ReportLease::try_create() {
+	string owner = to_utf8(SpoolQueue::local_owner()) + "\n";
+#ifdef _WIN32
+	HANDLE file = CreateFileW(this->lease_file.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		DWORD error = GetLastError();
+		// a lease file being removed gives access denied
+		error_code exists_error;
+		return (error == ERROR_FILE_EXISTS || (error == ERROR_ACCESS_DENIED && filesys::exists(this->lease_file, exists_error))) ? LEASE_EXISTS : LEASE_ERROR;
+	}
+	DWORD written = 0;
+	WriteFile(file, owner.data(), (DWORD)owner.size(), &written, NULL);
+	CloseHandle(file);
+#else
+	int file = open(to_utf8(this->lease_file).c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+	if (file < 0) {
+		return errno == EEXIST ? LEASE_EXISTS : LEASE_ERROR;
+	}
+	ssize_t written = write(file, owner.data(), owner.size());
+	(void)written;
+	close(file);
+#endif
+	return LEASE_CREATED;
+}
+
+bool ReportLease::take_over_expired() {
+	error_code error;
+	filesys::file_time_type renewed = filesys::last_write_time(this->lease_file, error);
+	if (error) {
+		// removed meanwhile, try again at once
+		return !filesys::exists(this->lease_file, error);
+	}
+	if (filesys::file_time_type::clock::now() - renewed < chrono::seconds(REPORT_LEASE_SECONDS)) {
+		return false;
+	}
+	// only one of several hosts moving the expired file succeeds, the others wait for the new holder
+	wstring expired_file = this->lease_file + L"." + SpoolQueue::local_owner() + L".expired";
+	filesys::rename(this->lease_file, expired_file, error);
+	if (error) {
+		return false;
+	}
+	LogLine() << L"Took over expired lease of " << lease_owner(expired_file).c_str() << L": " << this->lease_file;
+	filesys::remove(expired_file, error);
+	return true;
+}
+
+void ReportLease::renew_until_released() {
+	string owner = to_utf8(SpoolQueue::local_owner());
+	unique_lock<mutex> lock(this->lease_mutex);
+	while (!this->lease_released.wait_for(lock, chrono::seconds(REPORT_LEASE_SECONDS / 4), [this]() { return this->released; })) {
+		error_code error;
+		if (lease_owner(this->lease_file) != owner) {
+			LogLine() << L"Lease " << this->lease_file << L" lost while converting";
+			this->held = false;
+			return;
+		}
+		filesys::last_write_time(this->lease_file, filesys::file_time_type::clock::now(), error);
+	}
+}
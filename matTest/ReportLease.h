@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// a holder renews the lease every quarter of this time, as the jobs of the spool queue
+static const int REPORT_LEASE_SECONDS = 120;
+
+#pragma once
+class ReportLease
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function takes the lease of a 50_Report folder, it waits as long as a conversion on any host holds it
+	*
+	* Input:
+	*		report_folder		wstring				50_Report folder, the lease file converting.lease is created within it
+	*
+	* The lease file is created exclusively, its modification time is renewed while the lease is held and it is removed on destruction.
+	* A lease file which wasn't renewed for REPORT_LEASE_SECONDS belongs to a conversion which stopped and is taken over. The clocks of
+	* the hosts have to agree within a small part of the lease. If the file can't be created at all, the conversion goes on without lease
+	*
+	*************************************************************************************************************************************************************************/
+	ReportLease(const wstring&);
+	~ReportLease();
+
+	// false if the lease couldn't be taken or was taken over by another host meanwhile
+	bool is_held() const;
+
+private:
+	enum CreateResult { LEASE_CREATED, LEASE_EXISTS, LEASE_ERROR };
+	CreateResult try_create();
+	// removes a lease file which wasn't renewed in time, true if it was removed
+	bool take_over_expired();
+	void renew_until_released();
+
+	wstring lease_file;
+	bool held;
+	thread lease_keeper;
+	mutable mutex lease_mutex;
+	condition_variable lease_released;
+	bool released;
+};
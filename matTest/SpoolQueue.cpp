@@ -0,0 +1,248 @@
+#include "SpoolQueue.h"
+#include "ConversionLog.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <codecvt>
+#include <locale>
+#include <system_error>
+#include <experimental\filesystem>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+namespace filesys = std::experimental::filesystem;
+
+// a worker renews its lease every quarter of this time, a host may stall for the rest before its jobs are taken over
+static const int LEASE_SECONDS = 120;
+// a job whose worker disappeared this often is moved to failed instead of being tried again
+static const int MAX_ATTEMPTS = 3;
+static const wchar_t JOB_EXTENSION[] = L".job";
+
+static string to_utf8(const wstring& text) {
+	return wstring_convert<codecvt_utf8<wchar_t>>().to_bytes(text);
+}
+
+static wstring from_utf8(const string& text) {
+	try {
+		return wstring_convert<codecvt_utf8<wchar_t>>().from_bytes(text);
+	}
+	catch (const range_error&) {
+		return wstring(text.begin(), text.end());
+	}
+}
+
+// ~ and @ separate the parts of a claimed file name
+static wstring file_name_part(wstring text) {
+	for (wchar_t& c : text) {
+		if (c == L'~' || c == L'@' || c == L'\\' || c == L'/' || c == L':' || c == L'\t') {
+			c = L'_';
+		}
+	}
+	return text;
+}
+
+// <id>~<attempt>[@<owner>].job
+static bool parse_job_name(const wstring& file, wstring& id, int& attempt) {
+	wstring name = filesys::path(file).stem().wstring();
+	size_t tilde = name.find(L'~');
+	if (tilde == wstring::npos) {
+		return false;
+	}
+	id = name.substr(0, tilde);
+	size_t at = name.find(L'@', tilde);
+	try {
+		attempt = stoi(name.substr(tilde + 1, at == wstring::npos ? wstring::npos : at - tilde - 1));
+	}
+	catch (...) {
+		return false;
+	}
+	return true;
+}
+
+static bool touch(const wstring& file) {
+	error_code error;
+	filesys::last_write_time(file, filesys::file_time_type::clock::now(), error);
+	return !error;
+}
+
+static bool move_job(const wstring& from, const wstring& to) {
+	// only one of several workers moving the same file succeeds, the others find it gone
+	error_code error;
+	filesys::rename(from, to, error);
+	return !error;
+}
+
+SpoolQueue::SpoolQueue(const wstring& spool_folder, const wstring& owner) :
+	spool_folder(spool_folder), owner(file_name_part(owner)), opened(true), submitted(0) {
+	const wchar_t *states[] = { L"pending", L"claimed", L"done", L"failed" };
+	for (const wchar_t *state : states) {
+		error_code error;
+		filesys::create_directories(state_folder(state), error);
+		if (!filesys::is_directory(state_folder(state), error)) {
+			this->opened = false;
+		}
+	}
+	if (!this->opened) {
+		LogLine() << L"Couldn't open spool folder " << spool_folder;
+	}
+}
+
+bool SpoolQueue::is_open() const {
+	return this->opened;
+}
+
+wstring SpoolQueue::state_folder(const wstring& state) const {
+	return (filesys::path(this->spool_folder) / state).wstring();
+}
+
+vector<wstring> SpoolQueue::job_files(const wstring& state) const {
+	vector<wstring> files;
+	error_code error;
+	for (filesys::directory_iterator it(state_folder(state), error), end; !error && it != end; it.increment(error)) {
+		if (it->path().extension().wstring() == JOB_EXTENSION) {
+			files.push_back(it->path().wstring());
+		}
+	}
+	// ids start with the time of submission, so name order is the order of submission
+	sort(files.begin(), files.end());
+	return files;
+}
+
+wstring SpoolQueue::submit(const wstring& request) {
+	unsigned long long now_ms = chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now().time_since_epoch()).count();
+	wstringstream id_stream;
+	id_stream << setw(14) << setfill(L'0') << now_ms << L"-" << this->owner << L"-" << this->submitted++;
+	wstring id = id_stream.str();
+	// written under a name workers don't take, then published at once
+	wstring temp_file = (filesys::path(state_folder(L"pending")) / (id + L".tmp")).wstring();
+	{
+		ofstream job_out(temp_file, ios::binary);
+		job_out << to_utf8(request) << "\n";
+		if (!job_out) {
+			LogLine() << L"Couldn't write job " << temp_file;
+			return L"";
+		}
+	}
+	if (!move_job(temp_file, (filesys::path(state_folder(L"pending")) / (id + L"~0" + JOB_EXTENSION)).wstring())) {
+		LogLine() << L"Couldn't publish job " << temp_file;
+		return L"";
+	}
+	return id;
+}
+
+bool SpoolQueue::claim(SpoolClaim& claim) {
+	for (const wstring& pending_file : job_files(L"pending")) {
+		wstring id;
+		int attempt;
+		if (!parse_job_name(pending_file, id, attempt)) {
+			continue;
+		}
+		// renaming keeps the modification time, the lease has to be fresh before the job shows up in claimed
+		if (!touch(pending_file)) {
+			continue;
+		}
+		wstring claim_file = (filesys::path(state_folder(L"claimed")) / (id + L"~" + to_wstring(attempt + 1) + L"@" + this->owner + JOB_EXTENSION)).wstring();
+		if (!move_job(pending_file, claim_file)) {
+			continue;
+		}
+		ifstream job_in(claim_file, ios::binary);
+		string request;
+		getline(job_in, request);
+		if (!request.empty() && request.back() == '\r') {
+			request.pop_back();
+		}
+		claim.id = id;
+		claim.attempt = attempt + 1;
+		claim.claim_file = claim_file;
+		claim.request = from_utf8(request);
+		return true;
+	}
+	return false;
+}
+
+bool SpoolQueue::renew(const SpoolClaim& claim) {
+	return touch(claim.claim_file);
+}
+
+bool SpoolQueue::finish(const SpoolClaim& claim, bool ok, const wstring& outcome) {
+	wstring finished_file = (filesys::path(state_folder(ok ? L"done" : L"failed")) / (claim.id + JOB_EXTENSION)).wstring();
+	if (!move_job(claim.claim_file, finished_file)) {
+		LogLine() << L"Lease of job " << claim.id << L" was lost, it is handled by another worker";
+		return false;
+	}
+	// the file only gets written once it left claimed, so no write can recreate a job taken over meanwhile
+	ofstream job_out(finished_file, ios::binary | ios::app);
+	job_out << "# " << to_utf8(this->owner) << "\tattempt " << claim.attempt << "\t" << to_utf8(outcome) << "\n";
+	return true;
+}
+
+size_t SpoolQueue::recover_expired() {
+	size_t recovered = 0;
+	filesys::file_time_type now = filesys::file_time_type::clock::now();
+	for (const wstring& claim_file : job_files(L"claimed")) {
+		error_code error;
+		filesys::file_time_type renewed = filesys::last_write_time(claim_file, error);
+		if (error || now - renewed < chrono::seconds(LEASE_SECONDS)) {
+			continue;
+		}
+		wstring id;
+		int attempt;
+		if (!parse_job_name(claim_file, id, attempt)) {
+			continue;
+		}
+		if (attempt >= MAX_ATTEMPTS) {
+			wstring failed_file = (filesys::path(state_folder(L"failed")) / (id + JOB_EXTENSION)).wstring();
+			if (move_job(claim_file, failed_file)) {
+				ofstream job_out(failed_file, ios::binary | ios::app);
+				job_out << "# " << to_utf8(this->owner) << "\tlease expired " << attempt << " times\n";
+				LogLine() << L"Job " << id << L" failed, its worker disappeared " << attempt << L" times";
+				recovered++;
+			}
+			continue;
+		}
+		if (move_job(claim_file, (filesys::path(state_folder(L"pending")) / (id + L"~" + to_wstring(attempt) + JOB_EXTENSION)).wstring())) {
+			LogLine() << L"Job " << id << L" recovered from " << filesys::path(claim_file).filename().wstring();
+			recovered++;
+		}
+	}
+	return recovered;
+}
+
+size_t SpoolQueue::pending_jobs() const {
+	return job_files(L"pending").size();
+}
+
+size_t SpoolQueue::claimed_jobs() const {
+	return job_files(L"claimed").size();
+}
+
+int SpoolQueue::lease_seconds() const {
+	return LEASE_SECONDS;
+}
+
+wstring SpoolQueue::local_owner() {
+#ifdef _WIN32
+	wchar_t host[MAX_COMPUTERNAME_LENGTH + 1];
+	DWORD host_length = MAX_COMPUTERNAME_LENGTH + 1;
+	wstring host_name = GetComputerNameW(host, &host_length) ? wstring(host, host_length) : L"host";
+	return host_name + L"-" + to_wstring(_getpid());
+#else
+	char host[256] = { 0 };
+	wstring host_name = gethostname(host, sizeof(host) - 1) == 0 ? from_utf8(host) : L"host";
+	return host_name + L"-" + to_wstring(getpid());
+#endif
+}
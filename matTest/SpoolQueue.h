@@ -0,0 +1,107 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// a job taken from the spool folder, see SpoolQueue::claim
+struct SpoolClaim {
+	wstring id;
+	// number of times the job was claimed, including this one
+	int attempt;
+	// file of the job in claimed, it exists as long as the lease is held
+	wstring claim_file;
+	// 30_RawData folder followed by key=value options, separated by tabs like a convert request of the conversion service
+	wstring request;
+};
+
+#pragma once
+class SpoolQueue
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function opens a queue of conversion jobs in a folder shared by all workers, on a local disk or a network share
+	*
+	* Input:
+	*		spool_folder		wstring				folder of the queue, pending, claimed, done and failed are created within it
+	*		owner				wstring				name of the worker, unique among all workers of the queue, see local_owner
+	*
+	* A job is a file. It is claimed by renaming it from pending to claimed, which only one worker can do. The modification time of the
+	* claimed file is the lease of the worker, it has to be renewed within lease_seconds(), otherwise any worker moves the job back to
+	* pending, or to failed after MAX_ATTEMPTS claims. The clocks of the hosts have to agree within a small part of the lease.
+	*
+	*************************************************************************************************************************************************************************/
+	SpoolQueue(const wstring&, const wstring&);
+
+	bool is_open() const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function adds a job to the queue
+	*
+	* Input:
+	*		request				wstring				30_RawData folder, optionally followed by tab separated options config=, stage=, resume= and priority=
+	* Output:
+	*		res					wstring				id of the job, empty if it couldn't be added
+	*
+	*************************************************************************************************************************************************************************/
+	wstring submit(const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function takes the oldest pending job
+	*
+	* Input:
+	*		claim				SpoolClaim			receives the job
+	* Output:
+	*		res					bool				false if no job is pending
+	*
+	*************************************************************************************************************************************************************************/
+	bool claim(SpoolClaim&);
+
+	// extends the lease, false if the job was taken away meanwhile
+	bool renew(const SpoolClaim&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function moves a claimed job to done or failed and adds the outcome to its file
+	*
+	* Input:
+	*		claim				SpoolClaim			job claimed by this worker
+	*		ok					bool				the conversion succeeded
+	*		outcome				wstring				line appended to the job file, e.g. the report folder
+	* Output:
+	*		res					bool				false if the lease was lost, the job is then handled by another worker
+	*
+	*************************************************************************************************************************************************************************/
+	bool finish(const SpoolClaim&, bool, const wstring&);
+
+	// moves the jobs of workers which stopped renewing their lease back to pending, returns the number of jobs moved
+	size_t recover_expired();
+
+	size_t pending_jobs() const;
+	size_t claimed_jobs() const;
+	int lease_seconds() const;
+
+	// host name and process id
+	static wstring local_owner();
+
+private:
+	wstring state_folder(const wstring&) const;
+	vector<wstring> job_files(const wstring&) const;
+
+	wstring spool_folder;
+	wstring owner;
+	bool opened;
+	unsigned long long submitted;
+};
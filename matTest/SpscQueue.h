@@ -0,0 +1,157 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// depth and stall statistics of one queue, stall times in ms
+struct QueueStats {
+	size_t capacity;
+	size_t pushed;
+	size_t max_depth;
+	size_t producer_stalls;
+	double producer_stall_ms;
+	size_t consumer_stalls;
+	double consumer_stall_ms;
+};
+
+#pragma once
+/*************************************************************************************************************************************************************************
+* Bounded lock-free queue between exactly one producer thread and one consumer thread
+*
+* push() waits while the queue is full (back-pressure), pop() waits while it is empty.
+* The producer calls close() after the last item, pop() returns false once everything is consumed.
+* cancel() is called by either side on errors, afterwards push() and pop() return false immediately.
+*
+*************************************************************************************************************************************************************************/
+template <class T>
+class SpscQueue
+{
+
+public:
+	explicit SpscQueue(size_t capacity) :
+		slots(capacity + 1), head(0), tail(0), closed(false), cancelled(false),
+		pushed(0), max_depth(0), producer_stalls(0), consumer_stalls(0), producer_stall_ns(0), consumer_stall_ns(0) {
+	}
+
+	bool push(T item) {
+		size_t current_tail = this->tail.load(memory_order_relaxed);
+		size_t next_tail = (current_tail + 1) % this->slots.size();
+		if (next_tail == this->head.load(memory_order_acquire)) {
+			// full, wait for the consumer
+			chrono::steady_clock::time_point stall_start = chrono::steady_clock::now();
+			int spins = 0;
+			while (next_tail == this->head.load(memory_order_acquire)) {
+				if (this->cancelled.load(memory_order_acquire)) {
+					return false;
+				}
+				backoff(spins++);
+			}
+			this->producer_stalls++;
+			this->producer_stall_ns += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - stall_start).count();
+		}
+		if (this->cancelled.load(memory_order_acquire)) {
+			return false;
+		}
+		this->slots[current_tail] = move(item);
+		this->tail.store(next_tail, memory_order_release);
+		this->pushed++;
+		size_t depth = (next_tail + this->slots.size() - this->head.load(memory_order_acquire)) % this->slots.size();
+		if (depth > this->max_depth) {
+			this->max_depth = depth;
+		}
+		return true;
+	}
+
+	bool pop(T& item) {
+		size_t current_head = this->head.load(memory_order_relaxed);
+		if (current_head == this->tail.load(memory_order_acquire)) {
+			// empty, wait for the producer
+			chrono::steady_clock::time_point stall_start = chrono::steady_clock::now();
+			int spins = 0;
+			while (current_head == this->tail.load(memory_order_acquire)) {
+				if (this->cancelled.load(memory_order_acquire)) {
+					return false;
+				}
+				// closed is set after the last tail store, check tail once more before giving up
+				if (this->closed.load(memory_order_acquire) && current_head == this->tail.load(memory_order_acquire)) {
+					return false;
+				}
+				backoff(spins++);
+			}
+			this->consumer_stalls++;
+			this->consumer_stall_ns += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - stall_start).count();
+		}
+		if (this->cancelled.load(memory_order_acquire)) {
+			return false;
+		}
+		item = move(this->slots[current_head]);
+		this->slots[current_head] = T();
+		this->head.store((current_head + 1) % this->slots.size(), memory_order_release);
+		return true;
+	}
+
+	void close() {
+		this->closed.store(true, memory_order_release);
+	}
+
+	void cancel() {
+		this->cancelled.store(true, memory_order_release);
+	}
+
+	// only valid after both threads finished
+	QueueStats stats() const {
+		QueueStats result;
+		result.capacity = this->slots.size() - 1;
+		result.pushed = this->pushed;
+		result.max_depth = this->max_depth;
+		result.producer_stalls = this->producer_stalls;
+		result.producer_stall_ms = this->producer_stall_ns / 1e6;
+		result.consumer_stalls = this->consumer_stalls;
+		result.consumer_stall_ms = this->consumer_stall_ns / 1e6;
+		return result;
+	}
+
+private:
+	SpscQueue(const SpscQueue&);
+	SpscQueue& operator=(const SpscQueue&);
+
+	// spin shortly, then yield, then sleep to not burn a core while a stage is slow
+	static void backoff(int spins) {
+		if (spins < 64) {
+			return;
+		}
+		if (spins < 128) {
+			this_thread::yield();
+			return;
+		}
+		this_thread::sleep_for(chrono::microseconds(200));
+	}
+
+	vector<T> slots;
+	// next slot to read, written by the consumer only
+	atomic<size_t> head;
+	// next slot to write, written by the producer only
+	atomic<size_t> tail;
+	atomic<bool> closed;
+	atomic<bool> cancelled;
+	// producer side statistics
+	size_t pushed;
+	size_t max_depth;
+	size_t producer_stalls;
+	// consumer side statistics
+	size_t consumer_stalls;
+	long long producer_stall_ns;
+	long long consumer_stall_ns;
+};
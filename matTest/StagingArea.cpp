@@ -0,0 +1,270 @@
+#include "StagingArea.h"
+#include "ConversionLog.h"
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <system_error>
+#include <experimental\filesystem>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <codecvt>
+#include <locale>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#include <linux/fs.h>
+#endif
+#endif
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+namespace filesys = std::experimental::filesystem;
+
+#ifdef _WIN32
+static const wchar_t PATH_SEPARATOR = L'\\';
+
+static wstring volume_of(const wstring& path) {
+	wchar_t volume[MAX_PATH];
+	if (!GetVolumePathNameW(path.c_str(), volume, MAX_PATH)) {
+		return L"";
+	}
+	wstring result = volume;
+	transform(result.begin(), result.end(), result.begin(), ::towlower);
+	return result;
+}
+#else
+static const wchar_t PATH_SEPARATOR = L'/';
+
+static string narrow_path(const wstring& path) {
+	return wstring_convert<codecvt_utf8<wchar_t>>().to_bytes(path);
+}
+
+static bool device_of(const wstring& path, dev_t* device) {
+	struct stat info;
+	if (stat(narrow_path(path).c_str(), &info) != 0) {
+		return false;
+	}
+	*device = info.st_dev;
+	return true;
+}
+#endif
+
+StagingArea::StagingArea(const wstring& job_directory, int worker_count) :
+	job_directory(job_directory), worker_count(max(1, worker_count)), available(false),
+	staged_files(0), failed_files(0), staged_bytes(0), elapsed_ms(0) {
+	fill(this->method_counts, this->method_counts + STAGED_BUFFERED_COPY + 1, 0);
+	error_code error;
+	if (!filesys::is_directory(job_directory, error)) {
+		filesys::create_directories(job_directory, error);
+	}
+	this->available = filesys::is_directory(job_directory, error);
+	if (!this->available) {
+		LogLine() << L"Staging area not reachable: " << job_directory;
+	}
+}
+
+bool StagingArea::is_available() const {
+	return this->available;
+}
+
+wstring StagingArea::staged_path(const wstring& file) const {
+	wstring file_name = file.substr(file.find_last_of(L"/\\") + 1);
+	return this->job_directory + PATH_SEPARATOR + file_name;
+}
+
+bool StagingArea::same_filesystem(const wstring& path) const {
+	if (!this->available) {
+		return false;
+	}
+#ifdef _WIN32
+	wstring volume = volume_of(path);
+	return !volume.empty() && volume == volume_of(this->job_directory);
+#else
+	dev_t path_device;
+	dev_t staging_device;
+	return device_of(path, &path_device) && device_of(this->job_directory, &staging_device) && path_device == staging_device;
+#endif
+}
+
+#ifdef _WIN32
+StagingMethod StagingArea::stage_file(const wstring& source, const wstring& destination, bool same_fs, unsigned long long* bytes) {
+	WIN32_FILE_ATTRIBUTE_DATA attributes;
+	if (!GetFileAttributesExW(source.c_str(), GetFileExInfoStandard, &attributes)) {
+		return STAGED_FAILED;
+	}
+	*bytes = ((unsigned long long)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+	// an existing file may be a link to the source from an earlier run, it must not be written through
+	DeleteFileW(destination.c_str());
+	if (same_fs) {
+		if (CreateHardLinkW(destination.c_str(), source.c_str(), NULL)) {
+			return STAGED_HARDLINK;
+		}
+	}
+	// copied by the file system (server side copy on shares, block cloning on ReFS)
+	if (CopyFileExW(source.c_str(), destination.c_str(), NULL, NULL, NULL, 0)) {
+		return STAGED_KERNEL_COPY;
+	}
+	return STAGED_FAILED;
+}
+#else
+StagingMethod StagingArea::stage_file(const wstring& source, const wstring& destination, bool same_fs, unsigned long long* bytes) {
+	string source_path = narrow_path(source);
+	string destination_path = narrow_path(destination);
+	int in = open(source_path.c_str(), O_RDONLY);
+	if (in < 0) {
+		return STAGED_FAILED;
+	}
+	struct stat info;
+	if (fstat(in, &info) != 0) {
+		close(in);
+		return STAGED_FAILED;
+	}
+	*bytes = info.st_size;
+	// an existing file may be a link to the source from an earlier run, it must not be truncated through
+	unlink(destination_path.c_str());
+	if (same_fs) {
+#ifdef FICLONE
+		// copy on write clone, the data is shared until one side changes
+		int clone = open(destination_path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+		if (clone >= 0 && ioctl(clone, FICLONE, in) == 0 && close(clone) == 0) {
+			close(in);
+			return STAGED_REFLINK;
+		}
+		if (clone >= 0) {
+			close(clone);
+		}
+#endif
+		unlink(destination_path.c_str());
+		if (link(source_path.c_str(), destination_path.c_str()) == 0) {
+			close(in);
+			return STAGED_HARDLINK;
+		}
+	}
+	int out = open(destination_path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+	if (out < 0) {
+		close(in);
+		return STAGED_FAILED;
+	}
+	StagingMethod method = STAGED_KERNEL_COPY;
+	off_t remaining = info.st_size;
+#ifdef __linux__
+	// both calls continue at the current file offsets, so a partial copy can be finished by the next method
+	while (remaining > 0) {
+		ssize_t copied = copy_file_range(in, NULL, out, NULL, remaining, 0);
+		if (copied <= 0) {
+			break;
+		}
+		remaining -= copied;
+	}
+	while (remaining > 0) {
+		ssize_t copied = sendfile(out, in, NULL, remaining);
+		if (copied <= 0) {
+			break;
+		}
+		remaining -= copied;
+	}
+#endif
+	if (remaining > 0) {
+		method = STAGED_BUFFERED_COPY;
+		char buffer[1 << 16];
+		ssize_t count;
+		while (remaining > 0 && (count = read(in, buffer, sizeof(buffer))) > 0) {
+			for (ssize_t written = 0; written < count;) {
+				ssize_t result = write(out, buffer + written, count - written);
+				if (result <= 0) {
+					close(in);
+					close(out);
+					return STAGED_FAILED;
+				}
+				written += result;
+			}
+			remaining -= count;
+		}
+	}
+	close(in);
+	if (close(out) != 0 || remaining > 0) {
+		return STAGED_FAILED;
+	}
+	return method;
+}
+#endif
+
+bool StagingArea::stage_files(const vector<wstring>& files, vector<bool>* staged) {
+	if (staged != NULL) {
+		staged->assign(files.size(), false);
+	}
+	if (files.empty()) {
+		return true;
+	}
+	if (!this->available) {
+		this->failed_files += files.size();
+		return false;
+	}
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	vector<StagingMethod> methods(files.size(), STAGED_FAILED);
+	vector<unsigned long long> bytes(files.size(), 0);
+	// workers take the next file until all are done
+	atomic<size_t> next_file(0);
+	auto worker = [&]() {
+		for (size_t i = next_file++; i < files.size(); i = next_file++) {
+			try {
+				wstring destination = staged_path(files[i]);
+				if (destination == files[i]) {
+					// already in the staging area, linking it onto itself would remove it
+					methods[i] = STAGED_HARDLINK;
+					continue;
+				}
+				methods[i] = stage_file(files[i], destination, same_filesystem(files[i]), &bytes[i]);
+			}
+			catch (...) {
+				methods[i] = STAGED_FAILED;
+			}
+		}
+	};
+	vector<thread> workers;
+	int thread_count = (int)min((size_t)this->worker_count, files.size());
+	for (int i = 1; i < thread_count; i++) {
+		workers.push_back(thread(worker));
+	}
+	worker();
+	for (thread& t : workers) {
+		t.join();
+	}
+
+	bool res = true;
+	for (size_t i = 0; i < files.size(); i++) {
+		this->method_counts[methods[i]]++;
+		if (methods[i] == STAGED_FAILED) {
+			LogLine() << L"Couldn't copy file to staging area: " << files[i];
+			this->failed_files++;
+			res = false;
+		}
+		else {
+			if (staged != NULL) {
+				(*staged)[i] = true;
+			}
+			this->staged_files++;
+			this->staged_bytes += bytes[i];
+		}
+	}
+	this->elapsed_ms += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	return res;
+}
+
+void StagingArea::print_summary() const {
+	LogLine() << L"Staged " << this->staged_files << L" files (" << this->staged_bytes << L" bytes) in " << this->elapsed_ms << L" ms: " <<
+		this->method_counts[STAGED_REFLINK] << L" reflink, " << this->method_counts[STAGED_HARDLINK] << L" hardlink, " <<
+		this->method_counts[STAGED_KERNEL_COPY] << L" kernel copy, " << this->method_counts[STAGED_BUFFERED_COPY] << L" buffered copy, " <<
+		this->failed_files << L" failed";
+}
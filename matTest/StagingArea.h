@@ -0,0 +1,89 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// how a file reached the staging area
+enum StagingMethod {
+	STAGED_FAILED,
+	STAGED_REFLINK,
+	STAGED_HARDLINK,
+	STAGED_KERNEL_COPY,
+	STAGED_BUFFERED_COPY
+};
+
+#pragma once
+class StagingArea
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function prepares the staging job directory
+	*
+	* Input:
+	*		job_directory		wstring				staging job directory, a network share or a local directory standing in for it
+	*		worker_count		int					number of files copied at the same time
+	*
+	* The directory is created if it does not exist (local stand-in)
+	*
+	*************************************************************************************************************************************************************************/
+	StagingArea(const wstring&, int);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function stages files concurrently, existing files in the staging area are overwritten
+	*
+	* Input:
+	*		files				vector<wstring>		absolute paths of the files to stage
+	*		staged				vector<bool>		optional, receives per file whether it was staged
+	* Output:
+	*		res					bool				all files staged
+	*
+	* If source and staging area share a filesystem the file is cloned (reflink), or hard linked if cloning
+	* is not supported. Otherwise the kernel copies it (CopyFileExW, copy_file_range, sendfile) without
+	* passing the data through user space, a buffered copy is the last resort
+	*
+	*************************************************************************************************************************************************************************/
+	bool stage_files(const vector<wstring>&, vector<bool>* = NULL);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function checks whether a path is on the same filesystem as the staging area
+	*
+	* Input:
+	*		path				wstring				existing file or directory
+	* Output:
+	*		res					bool				true if files can be linked into the staging area
+	*
+	*************************************************************************************************************************************************************************/
+	bool same_filesystem(const wstring&) const;
+
+	// path a file gets in the staging area
+	wstring staged_path(const wstring&) const;
+	bool is_available() const;
+	// prints files, bytes and methods of all stage_files calls
+	void print_summary() const;
+
+private:
+	StagingMethod stage_file(const wstring&, const wstring&, bool, unsigned long long*);
+
+	wstring job_directory;
+	int worker_count;
+	bool available;
+
+	size_t staged_files;
+	size_t failed_files;
+	unsigned long long staged_bytes;
+	size_t method_counts[STAGED_BUFFERED_COPY + 1];
+	double elapsed_ms;
+};
@@ -0,0 +1,213 @@
+#include "StagingManifest.h"
+#include "ContentHash.h"
+#include "MappedFile.h"
+#include "ConversionLog.h"
+#include <fstream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <codecvt>
+#include <locale>
+#include <system_error>
+#include <experimental\filesystem>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+namespace filesys = std::experimental::filesystem;
+
+// paths may contain any character, the manifest is kept in UTF-8
+static locale utf8_locale() {
+	return locale(locale(), new codecvt_utf8<wchar_t>);
+}
+
+static vector<wstring> split_tabs(const wstring& line) {
+	vector<wstring> fields;
+	size_t start = 0;
+	size_t tab;
+	while ((tab = line.find(L'\t', start)) != wstring::npos) {
+		fields.push_back(line.substr(start, tab - start));
+		start = tab + 1;
+	}
+	fields.push_back(line.substr(start));
+	return fields;
+}
+
+StagingManifest::StagingManifest(const wstring& manifest_path, int worker_count) :
+	manifest_path(manifest_path), worker_count(max(1, worker_count)),
+	unchanged_files(0), changed_files(0), hashed_files(0), hashed_bytes(0), hash_ms(0) {
+	wifstream manifest_in(manifest_path);
+	if (!manifest_in) {
+		return;
+	}
+	manifest_in.imbue(utf8_locale());
+	wstring line;
+	while (getline(manifest_in, line)) {
+		vector<wstring> fields = split_tabs(line);
+		ManifestEntry entry;
+		if (fields.size() != 5 || !ContentHash::from_hex(fields[0], &entry.hash)) {
+			// damaged lines only cost a new copy of the file
+			continue;
+		}
+		try {
+			entry.size = stoull(fields[1]);
+			entry.modified = stoll(fields[2]);
+		}
+		catch (...) {
+			continue;
+		}
+		entry.staged_path = fields[4];
+		this->entries[fields[3]] = entry;
+	}
+}
+
+bool StagingManifest::hash_files(const vector<wstring>& files, vector<unsigned long long>& hashes, vector<bool>& hashed) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	hashes.assign(files.size(), 0);
+	hashed.assign(files.size(), false);
+	vector<unsigned long long> bytes(files.size(), 0);
+	// workers take the next file until all are done
+	atomic<size_t> next_file(0);
+	auto worker = [&]() {
+		for (size_t i = next_file++; i < files.size(); i = next_file++) {
+			MappedFile mapped;
+			if (mapped.open(files[i])) {
+				hashes[i] = ContentHash::of(mapped.data(), mapped.size());
+				bytes[i] = mapped.size();
+				hashed[i] = true;
+			}
+		}
+	};
+	vector<thread> workers;
+	int thread_count = (int)min((size_t)this->worker_count, files.size());
+	for (int i = 1; i < thread_count; i++) {
+		workers.push_back(thread(worker));
+	}
+	worker();
+	for (thread& t : workers) {
+		t.join();
+	}
+	bool res = true;
+	for (size_t i = 0; i < files.size(); i++) {
+		if (hashed[i]) {
+			this->hashed_files++;
+			this->hashed_bytes += bytes[i];
+		}
+		else {
+			res = false;
+		}
+	}
+	this->hash_ms += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	return res;
+}
+
+bool StagingManifest::sync(const vector<wstring>& files, StagingArea& staging) {
+	vector<ManifestEntry> current(files.size());
+	// recorded entry still valid for the staged copy, only the content decides then
+	vector<bool> staged_copy_valid(files.size(), false);
+	vector<size_t> unknown;
+	vector<size_t> unchanged;
+	for (size_t i = 0; i < files.size(); i++) {
+		ManifestEntry& entry = current[i];
+		error_code error;
+		entry.size = filesys::file_size(files[i], error);
+		entry.modified = error ? 0 : (long long)filesys::last_write_time(files[i], error).time_since_epoch().count();
+		entry.hash = 0;
+		entry.staged_path = staging.staged_path(files[i]);
+		if (error) {
+			// staging reports the file
+			unknown.push_back(i);
+			continue;
+		}
+		map<wstring, ManifestEntry>::const_iterator recorded = this->entries.find(files[i]);
+		if (recorded != this->entries.end() && recorded->second.staged_path == entry.staged_path && recorded->second.size == entry.size) {
+			// the staging area may have been emptied since the last run
+			error_code staged_error;
+			staged_copy_valid[i] = filesys::file_size(entry.staged_path, staged_error) == entry.size && !staged_error;
+		}
+		if (staged_copy_valid[i] && recorded->second.modified == entry.modified) {
+			entry.hash = recorded->second.hash;
+			unchanged.push_back(i);
+		}
+		else {
+			unknown.push_back(i);
+		}
+	}
+
+	vector<wstring> hash_paths;
+	for (size_t i : unknown) {
+		hash_paths.push_back(files[i]);
+	}
+	vector<unsigned long long> hashes;
+	vector<bool> hashed;
+	hash_files(hash_paths, hashes, hashed);
+	vector<wstring> stage_paths;
+	vector<size_t> stage_indices;
+	for (size_t k = 0; k < unknown.size(); k++) {
+		size_t i = unknown[k];
+		current[i].hash = hashes[k];
+		if (hashed[k] && staged_copy_valid[i] && this->entries[files[i]].hash == hashes[k]) {
+			// touched or copied again, but the staged content is the same
+			unchanged.push_back(i);
+		}
+		else {
+			stage_paths.push_back(files[i]);
+			stage_indices.push_back(hashed[k] ? i : files.size());
+		}
+	}
+
+	vector<bool> staged;
+	bool res = staging.stage_files(stage_paths, &staged);
+	for (size_t i : unchanged) {
+		this->entries[files[i]] = current[i];
+	}
+	for (size_t k = 0; k < stage_paths.size(); k++) {
+		size_t i = stage_indices[k];
+		if (i < files.size() && staged[k]) {
+			this->entries[files[i]] = current[i];
+		}
+		else {
+			// not recorded, so the next run tries again
+			this->entries.erase(stage_paths[k]);
+		}
+	}
+	this->unchanged_files += unchanged.size();
+	this->changed_files += stage_paths.size();
+	return res;
+}
+
+bool StagingManifest::save() const {
+	wstring part_path = this->manifest_path + L".part";
+	wofstream manifest_out(part_path, ios::out | ios::trunc);
+	if (!manifest_out) {
+		LogLine() << L"Couldn't write staging manifest: " << this->manifest_path;
+		return false;
+	}
+	manifest_out.imbue(utf8_locale());
+	for (const map<wstring, ManifestEntry>::value_type& entry : this->entries) {
+		manifest_out << ContentHash::to_hex(entry.second.hash) << L"\t" << entry.second.size << L"\t" << entry.second.modified << L"\t" <<
+			entry.first << L"\t" << entry.second.staged_path << L"\n";
+	}
+	manifest_out.close();
+	error_code error;
+	if (!manifest_out.fail()) {
+		filesys::rename(part_path, this->manifest_path, error);
+	}
+	if (manifest_out.fail() || error) {
+		filesys::remove(part_path, error);
+		LogLine() << L"Couldn't write staging manifest: " << this->manifest_path;
+		return false;
+	}
+	return true;
+}
+
+void StagingManifest::print_summary() const {
+	LogLine() << L"Staging manifest: " << this->unchanged_files << L" files unchanged, " << this->changed_files << L" new or changed, " <<
+		this->hashed_files << L" hashed (" << this->hashed_bytes << L" bytes) in " << this->hash_ms << L" ms";
+}
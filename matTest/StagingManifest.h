@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include "StagingArea.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// state of one file when it was staged last
+struct ManifestEntry {
+	unsigned long long size;
+	long long modified;
+	unsigned long long hash;
+	wstring staged_path;
+};
+
+#pragma once
+class StagingManifest
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function loads the manifest of the files staged by earlier runs
+	*
+	* Input:
+	*		manifest_path		wstring				manifest file next to 50_Report, missing on the first run
+	*		worker_count		int					number of files hashed at the same time
+	*
+	* One tab separated line per file: hash, size, modification time, source path, staged path
+	*
+	*************************************************************************************************************************************************************************/
+	StagingManifest(const wstring&, int);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function stages only new or changed files and records them in the manifest
+	*
+	* Input:
+	*		files				vector<wstring>		absolute paths of the candidate files
+	*		staging				StagingArea			target of the files
+	* Output:
+	*		res					bool				all new or changed files staged
+	*
+	* A file is unchanged if it is still in the staging area with its size and either has the size and
+	* modification time of the manifest, or (touched or copied again) the same content hash.
+	* Hashes are computed in parallel on memory mapped files
+	*
+	*************************************************************************************************************************************************************************/
+	bool sync(const vector<wstring>&, StagingArea&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function writes the manifest, replacing the file only once it is complete
+	*
+	* Output:
+	*		res					bool				success or not
+	*
+	*************************************************************************************************************************************************************************/
+	bool save() const;
+
+	// prints skipped, staged and hashed files of all sync calls
+	void print_summary() const;
+
+private:
+	bool hash_files(const vector<wstring>&, vector<unsigned long long>&, vector<bool>&);
+
+	wstring manifest_path;
+	int worker_count;
+	map<wstring, ManifestEntry> entries;
+
+	size_t unchanged_files;
+	size_t changed_files;
+	size_t hashed_files;
+	unsigned long long hashed_bytes;
+	double hash_ms;
+};
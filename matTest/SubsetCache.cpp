@@ -0,0 +1,215 @@
+#include "SubsetCache.h"
+#include "MappedFile.h"
+#include "ConversionLog.h"
+#include <cstring>
+#include <cwchar>
+#include <system_error>
+#include <experimental\filesystem>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+namespace filesys = std::experimental::filesystem;
+
+// entry file: header, JSON chars, repetition lines (length + chars each), trailer
+// the trailer is written last, so the JSON can be streamed before its length is known
+static const unsigned int ENTRY_MAGIC = 0x43534D54;
+static const unsigned int ENTRY_VERSION = 1;
+static const size_t ENTRY_HEADER_SIZE = 2 * sizeof(unsigned int) + sizeof(unsigned int) + sizeof(unsigned long long);
+static const size_t ENTRY_TRAILER_SIZE = sizeof(unsigned int) + 2 * sizeof(unsigned long long);
+
+template <typename T>
+static void write_value(ofstream& out, T value) {
+	out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+static T read_value(const char* data) {
+	T value;
+	memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+SubsetCache::SubsetCache(const wstring& cache_directory, bool enabled) :
+	cache_directory(cache_directory), enabled(enabled), entry_key(0), entry_chars(0),
+	hits(0), misses(0), stored(0), bytes_reused(0) {
+	if (!this->enabled) {
+		return;
+	}
+	error_code error;
+	if (!filesys::is_directory(cache_directory, error)) {
+		filesys::create_directories(cache_directory, error);
+	}
+	if (!filesys::is_directory(cache_directory, error)) {
+		LogLine() << L"Subset cache not available: " << cache_directory;
+		this->enabled = false;
+	}
+}
+
+bool SubsetCache::is_enabled() const {
+	return this->enabled;
+}
+
+wstring SubsetCache::entry_path(unsigned long long key) const {
+	return this->cache_directory + L"\\" + ContentHash::to_hex(key) + L".subset";
+}
+
+bool SubsetCache::lookup(unsigned long long key, wstring& fragment, vector<wstring>& repetition_lines) {
+	if (!this->enabled) {
+		return false;
+	}
+	MappedFile entry;
+	bool hit = false;
+	if (entry.open(entry_path(key)) && entry.size() >= ENTRY_HEADER_SIZE + ENTRY_TRAILER_SIZE) {
+		const char *data = entry.data();
+		const char *trailer = data + entry.size() - ENTRY_TRAILER_SIZE;
+		unsigned int line_count = read_value<unsigned int>(trailer);
+		unsigned long long chars = read_value<unsigned long long>(trailer + sizeof(unsigned int));
+		unsigned long long stored_hash = read_value<unsigned long long>(trailer + sizeof(unsigned int) + sizeof(unsigned long long));
+		const char *cursor = data + ENTRY_HEADER_SIZE;
+		hit = read_value<unsigned int>(data) == ENTRY_MAGIC && read_value<unsigned int>(data + sizeof(unsigned int)) == ENTRY_VERSION &&
+			read_value<unsigned int>(data + 2 * sizeof(unsigned int)) == sizeof(wchar_t) && read_value<unsigned long long>(data + 3 * sizeof(unsigned int)) == key &&
+			chars <= (unsigned long long)(trailer - cursor) / sizeof(wchar_t);
+		if (hit) {
+			ContentHash hash;
+			fragment.resize((size_t)chars);
+			if (chars > 0) {
+				memcpy(&fragment[0], cursor, (size_t)chars * sizeof(wchar_t));
+			}
+			hash.update(cursor, (size_t)chars * sizeof(wchar_t));
+			cursor += chars * sizeof(wchar_t);
+			repetition_lines.clear();
+			for (unsigned int i = 0; i < line_count && hit; i++) {
+				hit = trailer - cursor >= (ptrdiff_t)sizeof(unsigned int);
+				if (hit) {
+					unsigned int length = read_value<unsigned int>(cursor);
+					cursor += sizeof(unsigned int);
+					hit = length <= (size_t)(trailer - cursor) / sizeof(wchar_t);
+					if (hit) {
+						repetition_lines.push_back(wstring(reinterpret_cast<const wchar_t*>(cursor), length));
+						cursor += length * sizeof(wchar_t);
+						hash.update(repetition_lines.back());
+					}
+				}
+			}
+			hit = hit && cursor == trailer && hash.digest() == stored_hash;
+		}
+	}
+	lock_guard<mutex> lock(this->cache_mutex);
+	if (hit) {
+		this->hits++;
+		this->bytes_reused += entry.size();
+		this->used_keys.insert(key);
+	}
+	else {
+		this->misses++;
+		fragment.clear();
+		repetition_lines.clear();
+	}
+	return hit;
+}
+
+void SubsetCache::begin(unsigned long long key) {
+	if (!this->enabled) {
+		return;
+	}
+	abort_entry();
+	this->entry_key = key;
+	this->entry_chars = 0;
+	this->entry_hash = ContentHash();
+	this->entry_part_path = entry_path(key) + L".part";
+	this->entry_out.open(this->entry_part_path, ios::binary | ios::trunc);
+	write_value(this->entry_out, ENTRY_MAGIC);
+	write_value(this->entry_out, ENTRY_VERSION);
+	write_value(this->entry_out, (unsigned int)sizeof(wchar_t));
+	write_value(this->entry_out, key);
+}
+
+void SubsetCache::append(const wstring& json_chunk) {
+	if (!this->entry_out.is_open()) {
+		return;
+	}
+	this->entry_out.write(reinterpret_cast<const char*>(json_chunk.data()), json_chunk.size() * sizeof(wchar_t));
+	this->entry_hash.update(json_chunk.data(), json_chunk.size() * sizeof(wchar_t));
+	this->entry_chars += json_chunk.size();
+}
+
+void SubsetCache::commit(const vector<wstring>& repetition_lines) {
+	if (!this->entry_out.is_open()) {
+		return;
+	}
+	for (const wstring& line : repetition_lines) {
+		write_value(this->entry_out, (unsigned int)line.size());
+		this->entry_out.write(reinterpret_cast<const char*>(line.data()), line.size() * sizeof(wchar_t));
+		this->entry_hash.update(line);
+	}
+	write_value(this->entry_out, (unsigned int)repetition_lines.size());
+	write_value(this->entry_out, this->entry_chars);
+	write_value(this->entry_out, this->entry_hash.digest());
+	this->entry_out.close();
+	error_code error;
+	if (!this->entry_out.fail()) {
+		filesys::rename(this->entry_part_path, entry_path(this->entry_key), error);
+	}
+	if (this->entry_out.fail() || error) {
+		// the subset is converted again next time
+		filesys::remove(this->entry_part_path, error);
+		LogLine() << L"Couldn't write subset cache entry: " << entry_path(this->entry_key);
+		return;
+	}
+	lock_guard<mutex> lock(this->cache_mutex);
+	this->stored++;
+	this->used_keys.insert(this->entry_key);
+}
+
+void SubsetCache::abort_entry() {
+	if (this->entry_out.is_open()) {
+		this->entry_out.close();
+		error_code error;
+		filesys::remove(this->entry_part_path, error);
+	}
+	this->entry_out.clear();
+}
+
+void SubsetCache::prune() {
+	if (!this->enabled) {
+		return;
+	}
+	abort_entry();
+	lock_guard<mutex> lock(this->cache_mutex);
+	error_code error;
+	vector<filesys::path> unused_entries;
+	for (filesys::directory_iterator it(this->cache_directory, error), end; !error && it != end; it.increment(error)) {
+		wstring file_name = it->path().filename().wstring();
+		unsigned long long key;
+		bool used = file_name.size() == 16 + wcslen(L".subset") && file_name.compare(16, wstring::npos, L".subset") == 0 &&
+			ContentHash::from_hex(file_name.substr(0, 16), &key) && this->used_keys.count(key) > 0;
+		if (!used) {
+			unused_entries.push_back(it->path());
+		}
+	}
+	size_t removed = 0;
+	for (const filesys::path& entry : unused_entries) {
+		error_code remove_error;
+		if (filesys::remove(entry, remove_error)) {
+			removed++;
+		}
+	}
+	if (removed > 0) {
+		LogLine() << L"Subset cache: removed " << removed << L" entries not used by this run";
+	}
+}
+
+void SubsetCache::print_summary() const {
+	if (!this->enabled) {
+		return;
+	}
+	lock_guard<mutex> lock(this->cache_mutex);
+	LogLine() << L"Subset cache: " << this->hits << L" hits, " << this->misses << L" misses, " << this->bytes_reused << L" bytes reused, " <<
+		this->stored << L" entries stored";
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <set>
+#include <mutex>
+#include <fstream>
+#include "ContentHash.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+#pragma once
+class SubsetCache
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function opens the cache of rendered subsets kept between runs
+	*
+	* Input:
+	*		cache_directory		wstring				directory of the capture next to 50_Report (50_Report_cache\<capture key>), one file per subset
+	*		enabled				bool				false to convert every subset (config subset_cache: off)
+	*
+	*************************************************************************************************************************************************************************/
+	SubsetCache(const wstring&, bool);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function looks up the rendered JSON of a subset
+	*
+	* Input:
+	*		key					unsigned long long	hash of the subset content and everything its JSON depends on
+	*		fragment			wstring				receives the JSON of all objects of the subset
+	*		repetition_lines	vector<wstring>		receives the repetition summary lines of the subset
+	* Output:
+	*		res					bool				true on a hit, damaged entries are misses
+	*
+	*************************************************************************************************************************************************************************/
+	bool lookup(unsigned long long, wstring&, vector<wstring>&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function writes the entry of a subset, the JSON is appended chunk by chunk as it is rendered
+	*
+	* Input:
+	*		key					unsigned long long	key given to lookup
+	*		json_chunk			wstring				next rendered chunk of the subset
+	*		repetition_lines	vector<wstring>		repetition summary lines of the subset
+	*
+	* The entry only becomes visible with commit(), a failed write leaves no entry and does not fail the run
+	*
+	*************************************************************************************************************************************************************************/
+	void begin(unsigned long long);
+	void append(const wstring&);
+	void commit(const vector<wstring>&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function removes all entries of the capture which were not used by this run, so the cache only keeps the latest data
+	*************************************************************************************************************************************************************************/
+	void prune();
+
+	bool is_enabled() const;
+	// prints hits, misses and bytes taken from the cache
+	void print_summary() const;
+
+private:
+	wstring entry_path(unsigned long long) const;
+	void abort_entry();
+
+	wstring cache_directory;
+	bool enabled;
+	// lookup runs in the build stage, writing in the render stage
+	mutable mutex cache_mutex;
+	set<unsigned long long> used_keys;
+
+	// entry being written
+	ofstream entry_out;
+	wstring entry_part_path;
+	unsigned long long entry_key;
+	unsigned long long entry_chars;
+	// hash of everything written, stored with the entry to detect damaged files
+	ContentHash entry_hash;
+
+	size_t hits;
+	size_t misses;
+	size_t stored;
+	unsigned long long bytes_reused;
+};
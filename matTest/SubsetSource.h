@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <map>
+#include <memory>
+#include "SubsetTable.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+#pragma once
+// capture whose subsets are converted, a .mat file (MatCapture) or the CSV files of an older test bench (CsvCapture)
+class SubsetSource
+{
+
+public:
+	virtual ~SubsetSource() {}
+
+	virtual bool is_open() const = 0;
+	// file of the capture, pictures and waveforms are matched against its folder
+	virtual const wstring& path() const = 0;
+	// meta data of the capture, test_program_name is the folder of the capture
+	virtual const map<wstring, wstring>& meta_data() const = 0;
+	virtual int subset_count() const = 0;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function decodes one subset
+	*
+	* Input:
+	*		subset_index		int					0 ... subset_count() - 1
+	* Output:
+	*		res					SubsetTable			header rows, limit rows and test data of the subset
+	*
+	* Cells are formatted the same for every kind of capture, so the JSON does not depend on where the subsets came from
+	*
+	*************************************************************************************************************************************************************************/
+	virtual shared_ptr<SubsetTable> read_subset(int) const = 0;
+};
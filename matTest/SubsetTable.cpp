@@ -0,0 +1,71 @@
+#include "SubsetTable.h"
+#include "ContentHash.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+SubsetTable::SubsetTable() {
+	this->cell_offsets.push_back(0);
+	this->row_offsets.push_back(0);
+}
+
+void SubsetTable::add_cell(const wchar_t* text, size_t length) {
+	this->text.append(text, length);
+	this->cell_offsets.push_back(this->text.size());
+}
+
+void SubsetTable::add_cell(const wstring& text) {
+	add_cell(text.data(), text.size());
+}
+
+void SubsetTable::end_row(SubsetRowType type) {
+	this->row_offsets.push_back(this->cell_offsets.size() - 1);
+	this->row_types.push_back(type);
+}
+
+int SubsetTable::row_count() const {
+	return (int)this->row_types.size();
+}
+
+int SubsetTable::col_count(int row) const {
+	return (int)(this->row_offsets[row + 1] - this->row_offsets[row]);
+}
+
+SubsetRowType SubsetTable::row_type(int row) const {
+	return this->row_types[row];
+}
+
+const wchar_t* SubsetTable::cell(int row, int col, size_t* length) const {
+	size_t index = this->row_offsets[row] + col;
+	*length = this->cell_offsets[index + 1] - this->cell_offsets[index];
+	return this->text.data() + this->cell_offsets[index];
+}
+
+wstring SubsetTable::cell_string(int row, int col) const {
+	size_t length;
+	const wchar_t* text = cell(row, col, &length);
+	return wstring(text, length);
+}
+
+void SubsetTable::append_row(int row, vector<wstring>& single_row) const {
+	int cols = col_count(row);
+	for (int col = 0; col < cols; col++) {
+		single_row.push_back(cell_string(row, col));
+	}
+}
+
+unsigned long long SubsetTable::content_hash() const {
+	ContentHash hash;
+	hash.update(this->id);
+	hash.update(this->text);
+	// offsets separate the cells, the same text may be split differently
+	hash.update(this->cell_offsets.data(), this->cell_offsets.size() * sizeof(size_t));
+	hash.update(this->row_offsets.data(), this->row_offsets.size() * sizeof(size_t));
+	hash.update(this->row_types.data(), this->row_types.size() * sizeof(SubsetRowType));
+	return hash.digest();
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// row type, same values as check_data_type of the first cell
+enum SubsetRowType {
+	ROW_EMPTY = 1,
+	ROW_HEADER = 2,
+	ROW_NAN = 3,
+	ROW_VALUE = 4
+};
+
+#pragma once
+class SubsetTable
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function appends one cell to the current row
+	*
+	* Input:
+	*		text				wchar_t*			cell text, already formatted like the reader expects it
+	*		length				size_t				number of chars
+	*
+	* All cells of a subset share one text buffer, so decoding a subset needs only a few allocations
+	*
+	*************************************************************************************************************************************************************************/
+	void add_cell(const wchar_t*, size_t);
+	void add_cell(const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function closes the current row
+	*
+	* Input:
+	*		type				SubsetRowType		type of the first cell (header row or test data row)
+	*
+	*************************************************************************************************************************************************************************/
+	void end_row(SubsetRowType);
+
+	int row_count() const;
+	// number of cells of the given row
+	int col_count(int) const;
+	SubsetRowType row_type(int) const;
+
+	// cell text without copy, length is returned through the last parameter
+	const wchar_t* cell(int, int, size_t*) const;
+	wstring cell_string(int, int) const;
+
+	// appends all cells of the row to the vector (same as get_whole_row_test_data)
+	void append_row(int, vector<wstring>&) const;
+
+	// hash of id, cells and row types, equal for equal subsets
+	unsigned long long content_hash() const;
+
+	wstring id;
+
+	SubsetTable();
+
+private:
+	// cells of all rows one after another
+	wstring text;
+	// start of every cell in text, one more entry than cells
+	vector<size_t> cell_offsets;
+	// first cell index of every row, one more entry than rows
+	vector<size_t> row_offsets;
+	vector<SubsetRowType> row_types;
+};
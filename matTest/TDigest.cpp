@@ -0,0 +1,202 @@
+#include "TDigest.h"
+#include <algorithm>
+#include <cmath>
+#include <cwchar>
+#include <limits>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+static const double TDIGEST_PI = 3.14159265358979323846;
+
+// scale function k1 and its inverse: centroid i covers the quantiles between k^-1(i) and k^-1(i + 1)
+static double tdigest_k(double q, double compression) {
+	return compression / (2 * TDIGEST_PI) * asin(2 * q - 1);
+}
+
+static double tdigest_q(double k, double compression) {
+	if (k >= compression / 4) {
+		return 1;
+	}
+	if (k <= -compression / 4) {
+		return 0;
+	}
+	return (sin(k * 2 * TDIGEST_PI / compression) + 1) / 2;
+}
+
+// value between x1 and x2, weighted by the distance to each end
+static double tdigest_interpolate(double x1, double w1, double x2, double w2) {
+	double value = (x1 * w1 + x2 * w2) / (w1 + w2);
+	return std::max(std::min(x1, x2), std::min(value, std::max(x1, x2)));
+}
+
+TDigest::TDigest(double compression) : compression(compression), total_weight(0), merge_descending(false), min(numeric_limits<double>::infinity()),
+	max(-numeric_limits<double>::infinity())
+{
+}
+
+void TDigest::add(double value) {
+	TDigestCentroid centroid = { value, 1 };
+	this->buffer.push_back(centroid);
+	this->total_weight += 1;
+	this->min = std::min(this->min, value);
+	this->max = std::max(this->max, value);
+	if (this->buffer.size() >= (size_t)(this->compression * 5)) {
+		this->compress();
+	}
+}
+
+void TDigest::add(const double* values, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		this->add(values[i]);
+	}
+}
+
+void TDigest::merge(const TDigest& other) {
+	if (other.total_weight == 0) {
+		return;
+	}
+	this->buffer.insert(this->buffer.end(), other.centroids.begin(), other.centroids.end());
+	this->buffer.insert(this->buffer.end(), other.buffer.begin(), other.buffer.end());
+	this->total_weight += other.total_weight;
+	this->min = std::min(this->min, other.min);
+	this->max = std::max(this->max, other.max);
+	this->compress();
+}
+
+void TDigest::compress() {
+	if (this->buffer.empty()) {
+		return;
+	}
+	this->buffer.insert(this->buffer.end(), this->centroids.begin(), this->centroids.end());
+	sort(this->buffer.begin(), this->buffer.end(), [](const TDigestCentroid& a, const TDigestCentroid& b) { return a.mean < b.mean; });
+	// every other merge runs from the largest value down, otherwise the centroids drift to one side (k1 is symmetric)
+	this->merge_descending = !this->merge_descending;
+	if (this->merge_descending) {
+		reverse(this->buffer.begin(), this->buffer.end());
+	}
+	this->centroids.clear();
+	// merge neighbours as long as the centroid stays within one unit of k
+	double weight_so_far = 0;
+	double weight_limit = this->total_weight * tdigest_q(tdigest_k(0, this->compression) + 1, this->compression);
+	TDigestCentroid current = this->buffer[0];
+	for (size_t i = 1; i < this->buffer.size(); i++) {
+		const TDigestCentroid& next = this->buffer[i];
+		if (weight_so_far + current.weight + next.weight <= weight_limit) {
+			current.weight += next.weight;
+			current.mean += (next.mean - current.mean) * next.weight / current.weight;
+		}
+		else {
+			weight_so_far += current.weight;
+			this->centroids.push_back(current);
+			weight_limit = this->total_weight * tdigest_q(tdigest_k(weight_so_far / this->total_weight, this->compression) + 1, this->compression);
+			current = next;
+		}
+	}
+	this->centroids.push_back(current);
+	if (this->merge_descending) {
+		reverse(this->centroids.begin(), this->centroids.end());
+	}
+	this->buffer.clear();
+}
+
+double TDigest::quantile(double q) {
+	this->compress();
+	if (this->centroids.empty()) {
+		return numeric_limits<double>::quiet_NaN();
+	}
+	if (this->centroids.size() == 1) {
+		return this->centroids[0].mean;
+	}
+	// the centroids are taken as centred at their cumulative weight, min and max are the ends
+	double index = q * this->total_weight;
+	const TDigestCentroid& first = this->centroids.front();
+	const TDigestCentroid& last = this->centroids.back();
+	if (index < 1) {
+		return this->min;
+	}
+	if (first.weight > 1 && index < first.weight / 2) {
+		return this->min + (index - 1) / (first.weight / 2 - 1) * (first.mean - this->min);
+	}
+	if (index > this->total_weight - 1) {
+		return this->max;
+	}
+	if (last.weight > 1 && this->total_weight - index <= last.weight / 2) {
+		return this->max - (this->total_weight - index - 1) / (last.weight / 2 - 1) * (this->max - last.mean);
+	}
+	double weight_so_far = first.weight / 2;
+	for (size_t i = 0; i + 1 < this->centroids.size(); i++) {
+		const TDigestCentroid& left = this->centroids[i];
+		const TDigestCentroid& right = this->centroids[i + 1];
+		double span = (left.weight + right.weight) / 2;
+		if (weight_so_far + span > index) {
+			// a single value is exact, it isn't spread over the span
+			double left_unit = 0;
+			if (left.weight == 1) {
+				if (index - weight_so_far < 0.5) {
+					return left.mean;
+				}
+				left_unit = 0.5;
+			}
+			double right_unit = 0;
+			if (right.weight == 1) {
+				if (weight_so_far + span - index <= 0.5) {
+					return right.mean;
+				}
+				right_unit = 0.5;
+			}
+			double to_left = index - weight_so_far - left_unit;
+			double to_right = weight_so_far + span - index - right_unit;
+			return tdigest_interpolate(left.mean, to_right, right.mean, to_left);
+		}
+		weight_so_far += span;
+	}
+	double to_last = index - this->total_weight + last.weight / 2;
+	return tdigest_interpolate(last.mean, last.weight / 2 - to_last, this->max, to_last);
+}
+
+double TDigest::count() {
+	return this->total_weight;
+}
+
+wstring TDigest::to_string() {
+	this->compress();
+	wchar_t number[64];
+	swprintf(number, 64, L"%g;%.17g;%.17g", this->compression, this->min, this->max);
+	wstring text = number;
+	for (const TDigestCentroid& centroid : this->centroids) {
+		// 10 digits are plenty for a centroid, the sketch is an estimate anyway
+		swprintf(number, 64, L";%.10g:%.17g", centroid.mean, centroid.weight);
+		text += number;
+	}
+	return text;
+}
+
+bool TDigest::parse(const wstring& text, TDigest& digest) {
+	const wchar_t* cursor = text.c_str();
+	wchar_t* end = NULL;
+	digest = TDigest(wcstod(cursor, &end));
+	if (end == cursor || *end != L';' || !(digest.compression > 0)) {
+		return false;
+	}
+	digest.min = wcstod(end + 1, &end);
+	if (*end != L';') {
+		return false;
+	}
+	digest.max = wcstod(end + 1, &end);
+	while (*end == L';') {
+		TDigestCentroid centroid;
+		centroid.mean = wcstod(end + 1, &end);
+		if (*end != L':') {
+			return false;
+		}
+		centroid.weight = wcstod(end + 1, &end);
+		digest.centroids.push_back(centroid);
+		digest.total_weight += centroid.weight;
+	}
+	return *end == L'\0';
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// a compression of 200 keeps around 100 centroids (about 2 KB as text), P99.9 stays within 1e-4 of its rank
+static const double TDIGEST_COMPRESSION = 200;
+
+// mean and number of values of one centroid
+struct TDigestCentroid {
+	double mean;
+	double weight;
+};
+
+#pragma once
+class TDigest
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function creates an empty quantile sketch (merging t-digest, Dunning)
+	*
+	* Input:
+	*		compression			double				size of the sketch, more centroids give more accurate quantiles
+	*
+	* Values are buffered and merged into the centroids in batches, centroids near the tails take fewer values than the ones in the
+	* middle, so P0.1 and P99.9 stay accurate. Sketches merge: the merged sketch is like the sketch of all values
+	*
+	*************************************************************************************************************************************************************************/
+	TDigest(double = TDIGEST_COMPRESSION);
+
+	void add(double);
+	void add(const double*, size_t);
+	void merge(const TDigest&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function estimates a quantile
+	*
+	* Input:
+	*		q					double				quantile in [0, 1]
+	* Output:
+	*		value				double				NaN if the sketch is empty, min and max are exact
+	*
+	*************************************************************************************************************************************************************************/
+	double quantile(double);
+
+	double count();
+
+
+	/*************************************************************************************************************************************************************************
+	* These functions write the sketch as text and read it back
+	*
+	* Format: compression;min;max;mean:weight;mean:weight;... with the centroids in order of their means
+	*
+	*************************************************************************************************************************************************************************/
+	wstring to_string();
+	static bool parse(const wstring&, TDigest&);
+
+private:
+	void compress();
+
+	double compression;
+	vector<TDigestCentroid> centroids;
+	// values and centroids of merged sketches not yet merged into the centroids
+	vector<TDigestCentroid> buffer;
+	double total_weight;
+	bool merge_descending;
+	double min;
+	double max;
+};
@@ -0,0 +1,64 @@
+#include "TestNumberAllocator.h"
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+TestNumberAllocator::TestNumberAllocator() : counter(1)
+{
+}
+
+
+TestNumberAllocator::~TestNumberAllocator()
+{
+}
+
+static void mark(vector<bool>& numbers, int test_number) {
+	if (test_number < 0) {
+		return;
+	}
+	if (test_number >= (int)numbers.size()) {
+		// grow in steps to keep resizing amortised
+		numbers.resize(max((size_t)test_number + 1, numbers.size() * 2), false);
+	}
+	numbers[test_number] = true;
+}
+
+void TestNumberAllocator::reserve(int test_number) {
+	mark(this->used, test_number);
+}
+
+void TestNumberAllocator::reserve_catalog(int test_number) {
+	mark(this->catalog, test_number);
+}
+
+bool TestNumberAllocator::is_used(int test_number) const {
+	return test_number >= 0 && test_number < (int)this->used.size() && this->used[test_number];
+}
+
+int TestNumberAllocator::current() const {
+	return this->counter;
+}
+
+int TestNumberAllocator::skip_catalog() {
+	while (this->counter < (int)this->catalog.size() && this->catalog[this->counter]) {
+		this->counter++;
+	}
+	return this->counter;
+}
+
+int TestNumberAllocator::advance() {
+	while (this->is_used(this->counter)) {
+		this->counter++;
+	}
+	this->counter++;
+	return this->skip_catalog();
+}
+
+int TestNumberAllocator::take() {
+	this->reserve(this->counter);
+	return this->counter++;
+}
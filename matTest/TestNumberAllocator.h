@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+#pragma once
+class TestNumberAllocator
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function marks a test number as used, e.g. test numbers given by the limits
+	*
+	* Input:
+	*		test_number			int					test number which must not be handed out
+	*
+	*************************************************************************************************************************************************************************/
+	void reserve(int);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function marks a test number of the limits catalog, which is never handed out to another parameter
+	*
+	* Input:
+	*		test_number			int					test number of the limits catalog
+	*
+	* Unlike reserve, a catalog number doesn't change the numbering of the other parameters, the counter only steps over it
+	* where it would be handed out. Without catalog the numbering is the same as before.
+	*
+	*************************************************************************************************************************************************************************/
+	void reserve_catalog(int);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function checks whether test number is already used
+	*
+	* Input:
+	*		test_number			int					test number to check
+	* Output:
+	*		used				bool				true if number was taken or reserved
+	*
+	*************************************************************************************************************************************************************************/
+	bool is_used(int) const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function returns the current counter value without changing it
+	*************************************************************************************************************************************************************************/
+	int current() const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function moves the counter past test numbers of the limits catalog
+	*
+	* Output:
+	*		test_number			int					new counter value, the counter itself if it isn't a catalog number
+	*
+	*************************************************************************************************************************************************************************/
+	int skip_catalog();
+
+
+	/*************************************************************************************************************************************************************************
+	* This function moves the counter to the next free test number
+	*
+	* Output:
+	*		test_number			int					new counter value
+	*
+	* Skips all used numbers starting at the counter and then steps the counter once more,
+	* which is the numbering the former search over unique_params produced. If that number belongs to
+	* the limits catalog, the counter moves on past the catalog numbers.
+	* The counter only moves forward, so each number is checked once per subset (amortised O(1))
+	*
+	*************************************************************************************************************************************************************************/
+	int advance();
+
+
+	/*************************************************************************************************************************************************************************
+	* This function hands out the current counter value, marks it as used and increments the counter
+	*
+	* Output:
+	*		test_number			int					assigned test number
+	*
+	*************************************************************************************************************************************************************************/
+	int take();
+
+	TestNumberAllocator();
+	~TestNumberAllocator();
+
+private:
+	// used[n] is true if test number n was taken or reserved
+	vector<bool> used;
+	// catalog[n] is true if test number n is given by the limits catalog
+	vector<bool> catalog;
+	int counter;
+};
@@ -0,0 +1,248 @@
+#include "UnitScaling.h"
+#include "ConversionLog.h"
+#include <cwchar>
+#include <cstdio>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+UnitScaling::UnitScaling()
+{
+}
+
+
+UnitScaling::~UnitScaling()
+{
+}
+
+bool UnitScaling::is_known_unit(const wstring& unit) {
+	for (int i = 0; i < KNOWN_UNIT_COUNT; i++) {
+		if (unit == KNOWN_UNITS[i]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+tuple<int, wstring> UnitScaling::get_unit_scale(const wstring& raw_unit) {
+	// remove blanks and enclosing brackets, e.g. [mV]
+	size_t first = raw_unit.find_first_not_of(L" \t[");
+	size_t last = raw_unit.find_last_not_of(L" \t]");
+	if (first == wstring::npos || last < first) {
+		if (raw_unit.find_first_of(L"[]") != wstring::npos) {
+			LogLine() << L"INVALID UNIT OCCURED IN LIMITS (testlimits.txt): " << raw_unit;
+		}
+		return make_tuple(0, wstring());
+	}
+	wstring unit = raw_unit.substr(first, last - first + 1);
+	if (unit.find_first_of(L"[]") != wstring::npos) {
+		LogLine() << L"INVALID UNIT OCCURED IN LIMITS (testlimits.txt): " << raw_unit;
+	}
+
+	// units like m, min or ppm start with a prefix symbol but have no prefix
+	if (this->is_known_unit(unit)) {
+		return make_tuple(0, unit);
+	}
+	int prefix = si_prefix_index(unit[0]);
+	if (prefix >= 0 && unit.size() > 1) {
+		return make_tuple(SI_PREFIXES[prefix].scale, unit.substr(1));
+	}
+	return make_tuple(0, unit);
+}
+
+DecimalValue UnitScaling::parse_decimal(const wstring& value) {
+	DecimalValue decimal = { false, false, 0, 0 };
+	size_t i = value.find_first_not_of(L" \t");
+	size_t end = value.find_last_not_of(L" \t");
+	if (i == wstring::npos) {
+		return decimal;
+	}
+	end++;
+	if (value[i] == L'+' || value[i] == L'-') {
+		decimal.negative = (value[i] == L'-');
+		i++;
+	}
+	// ',' is taken as decimal symbol only if there is no '.'
+	wchar_t decimal_symbol = (value.find(L'.') == wstring::npos && value.find(L',') != wstring::npos) ? L',' : L'.';
+	int digits = 0;
+	int significant_digits = 0;
+	bool seen_decimal_symbol = false;
+	for (; i < end; i++) {
+		wchar_t c = value[i];
+		if (c >= L'0' && c <= L'9') {
+			digits++;
+			if (decimal.mantissa == 0 && c == L'0') {
+				// leading zeros only move the exponent after the decimal symbol
+				if (seen_decimal_symbol) {
+					decimal.exponent--;
+				}
+				continue;
+			}
+			if (significant_digits < 19) {
+				decimal.mantissa = decimal.mantissa * 10 + (uint64_t)(c - L'0');
+				significant_digits++;
+				if (seen_decimal_symbol) {
+					decimal.exponent--;
+				}
+			}
+			else if (!seen_decimal_symbol) {
+				// digits beyond precision before decimal symbol still count as powers of ten
+				decimal.exponent++;
+			}
+		}
+		else if (c == decimal_symbol && !seen_decimal_symbol) {
+			seen_decimal_symbol = true;
+		}
+		else {
+			break;
+		}
+	}
+	if (digits == 0) {
+		return decimal;
+	}
+	if (i < end && (value[i] == L'e' || value[i] == L'E')) {
+		i++;
+		bool exponent_negative = false;
+		if (i < end && (value[i] == L'+' || value[i] == L'-')) {
+			exponent_negative = (value[i] == L'-');
+			i++;
+		}
+		int exponent = 0;
+		int exponent_digits = 0;
+		for (; i < end && value[i] >= L'0' && value[i] <= L'9'; i++) {
+			if (exponent < 100000) {
+				exponent = exponent * 10 + (value[i] - L'0');
+			}
+			exponent_digits++;
+		}
+		if (exponent_digits == 0) {
+			return decimal;
+		}
+		decimal.exponent += exponent_negative ? -exponent : exponent;
+	}
+	if (i != end) {
+		return decimal;
+	}
+	if (decimal.mantissa == 0) {
+		decimal.exponent = 0;
+		decimal.negative = false;
+	}
+	// normalise: no trailing zeros in mantissa
+	while (decimal.mantissa != 0 && decimal.mantissa % 10 == 0) {
+		decimal.mantissa /= 10;
+		decimal.exponent++;
+	}
+	decimal.valid = true;
+	return decimal;
+}
+
+wstring UnitScaling::format_decimal(const DecimalValue& decimal) {
+	if (!decimal.valid) {
+		return L"";
+	}
+	if (decimal.mantissa == 0) {
+		return L"0";
+	}
+	wstring digits = to_wstring(decimal.mantissa);
+	int n = (int)digits.size();
+	// exponent of the leading digit
+	int x = decimal.exponent + n - 1;
+	wstring res = decimal.negative ? L"-" : L"";
+	if (x < -4 || x >= max(6, n)) {
+		// scientific layout, e.g. 1.5e-12
+		res += digits[0];
+		if (n > 1) {
+			res += L"." + digits.substr(1);
+		}
+		wstring exponent = to_wstring(x < 0 ? -x : x);
+		if (exponent.size() < 2) {
+			exponent = L"0" + exponent;
+		}
+		res += (x < 0 ? L"e-" : L"e+") + exponent;
+	}
+	else if (decimal.exponent >= 0) {
+		res += digits + wstring(decimal.exponent, L'0');
+	}
+	else if (x >= 0) {
+		res += digits.substr(0, x + 1) + L"." + digits.substr(x + 1);
+	}
+	else {
+		res += L"0." + wstring(-x - 1, L'0') + digits;
+	}
+	return res;
+}
+
+wstring UnitScaling::scale_value(int scale, const wstring& value) {
+	if (value.empty() || value.find(L"NaN") == 0) {
+		return L"";
+	}
+	DecimalValue decimal = this->parse_decimal(value);
+	if (!decimal.valid) {
+		LogLine() << L"Couldn't scale value: " << value;
+		return value;
+	}
+	if (decimal.mantissa != 0) {
+		decimal.exponent -= scale;
+	}
+	return this->format_decimal(decimal);
+}
+
+void UnitScaling::get_unit_scale_column(const vector<wstring>& raw_units, vector<int>* scales, vector<wstring>* units) {
+	scales->assign(raw_units.size(), 0);
+	units->assign(raw_units.size(), L"");
+	for (size_t col = 0; col < raw_units.size(); col++) {
+		if (raw_units[col].empty()) {
+			continue;
+		}
+		tie((*scales)[col], (*units)[col]) = this->get_unit_scale(raw_units[col]);
+	}
+}
+
+bool UnitScaling::parse_double(const wchar_t* text, size_t length, double* value) {
+	if (length == 0) {
+		return false;
+	}
+	// cells aren't terminated, numbers are short
+	wchar_t buffer[64];
+	wstring long_text;
+	const wchar_t* number = buffer;
+	if (length < 64) {
+		wmemcpy(buffer, text, length);
+		buffer[length] = L'\0';
+	}
+	else {
+		long_text.assign(text, length);
+		number = long_text.c_str();
+	}
+	wchar_t* end = NULL;
+	*value = wcstod(number, &end);
+	return end == number + length;
+}
+
+bool UnitScaling::parse_double(const wstring& text, double* value) {
+	return parse_double(text.data(), text.size(), value);
+}
+
+wstring UnitScaling::format_double(double value) {
+	wchar_t buffer[32];
+	for (int precision = 15; precision <= 17; precision++) {
+		swprintf(buffer, 32, L"%.*g", precision, value);
+		if (wcstod(buffer, NULL) == value) {
+			break;
+		}
+	}
+	return wstring(buffer);
+}
+
+vector<wstring> UnitScaling::scale_column(const vector<wstring>& values, const vector<int>& scales) {
+	vector<wstring> scaled_values(values.size());
+	for (size_t col = 0; col < values.size(); col++) {
+		int scale = (col < scales.size()) ? scales[col] : 0;
+		scaled_values[col] = this->scale_value(scale, values[col]);
+	}
+	return scaled_values;
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <cstdint>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+/*************************************************************************************************************************************************************************
+* SI prefix registry: prefix symbol and the scale used by get_unit_scale (value * 10^-scale gives base unit)
+*************************************************************************************************************************************************************************/
+struct SiPrefix {
+	wchar_t symbol;
+	int scale;
+};
+
+static constexpr SiPrefix SI_PREFIXES[] = {
+	{ L'p', 12 },
+	{ L'n', 9 },
+	{ L'u', 6 },
+	{ L'\x00B5', 6 },	// micro sign
+	{ L'm', 3 },
+	{ L'k', -3 },
+	{ L'K', -3 },
+	{ L'M', -6 },
+	{ L'G', -9 },
+	{ L'T', -12 }
+};
+static constexpr int SI_PREFIX_COUNT = sizeof(SI_PREFIXES) / sizeof(SI_PREFIXES[0]);
+
+// index of prefix symbol in SI_PREFIXES, -1 if symbol is no prefix
+constexpr int si_prefix_index(wchar_t symbol, int i = 0) {
+	return (i >= SI_PREFIX_COUNT) ? -1 : ((SI_PREFIXES[i].symbol == symbol) ? i : si_prefix_index(symbol, i + 1));
+}
+
+static_assert(SI_PREFIXES[si_prefix_index(L'm')].scale == 3, "milli must scale by 10^-3");
+static_assert(si_prefix_index(L'V') == -1, "V is no prefix");
+
+/*************************************************************************************************************************************************************************
+* Unit registry: units which are taken as they are even though they start with a prefix symbol (m, min, ppm, T, K, ...)
+* and the units for which a leading prefix is split off
+*************************************************************************************************************************************************************************/
+static constexpr const wchar_t* KNOWN_UNITS[] = {
+	L"V", L"A", L"W", L"Ohm", L"ohm", L"\x03A9", L"F", L"H", L"Hz", L"s", L"S", L"C", L"J", L"K", L"T", L"m", L"g", L"Pa",
+	L"mol", L"min", L"h", L"ppm", L"ppb", L"ppt", L"%", L"dB", L"dBm", L"dBV", L"degC", L"LSB", L"bit"
+};
+static constexpr int KNOWN_UNIT_COUNT = sizeof(KNOWN_UNITS) / sizeof(KNOWN_UNITS[0]);
+
+/*************************************************************************************************************************************************************************
+* Decimal number as integer mantissa and power of ten exponent, value = (-1)^negative * mantissa * 10^exponent
+*************************************************************************************************************************************************************************/
+struct DecimalValue {
+	bool valid;
+	bool negative;
+	uint64_t mantissa;
+	int exponent;
+};
+
+#pragma once
+class UnitScaling
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function converts raw_unit to scale and unit without prefix
+	*
+	* Input:
+	*		raw_unit		wstring					original unit value (e.g. mV, [mA], mm, ppm)
+	* Output:
+	*		(scale, unit)	tuple(int, wstring)		corresponding scale and unit
+	*
+	* Enclosing brackets and blanks are removed. Units of the registry are kept as they are, otherwise
+	* only the first character is split off if it is a SI prefix and a unit remains (mV -> (3, V), mm -> (3, m))
+	*
+	*************************************************************************************************************************************************************************/
+	tuple<int, wstring> get_unit_scale(const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function parses a decimal number without going through double
+	*
+	* Input:
+	*		value			wstring					number as text (e.g. -1.25e-3, 3300, 0,5)
+	* Output:
+	*		decimal			DecimalValue			mantissa/exponent pair, valid=false if text is no number
+	*
+	* Up to 19 significant digits are kept exactly, trailing zeros are moved into the exponent
+	*
+	*************************************************************************************************************************************************************************/
+	DecimalValue parse_decimal(const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function formats a decimal number
+	*
+	* Input:
+	*		decimal			DecimalValue			number to format
+	* Output:
+	*		value			wstring					number as text
+	*
+	* Same layout as stream output of double (fixed for exponents -5 < X < max(6, digits), otherwise 1.5e-12),
+	* but with all significant digits of the mantissa
+	*
+	*************************************************************************************************************************************************************************/
+	wstring format_decimal(const DecimalValue&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function scales single value exactly: value * 10^-scale
+	*
+	* Input:
+	*		scale			int						scale from get_unit_scale
+	*		value			wstring					value in prefixed unit
+	* Output:
+	*		scaled_value	wstring					value in base unit, empty for empty or NaN value
+	*
+	*************************************************************************************************************************************************************************/
+	wstring scale_value(int, const wstring&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function determines scale and unit of a whole #unit row
+	*
+	* Input:
+	*		raw_units		vector<wstring>			#unit row
+	*		scales			vector<int>*			resulting scale per column
+	*		units			vector<wstring>*		resulting unit without prefix per column
+	*
+	*************************************************************************************************************************************************************************/
+	void get_unit_scale_column(const vector<wstring>&, vector<int>*, vector<wstring>*);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function scales a whole limit row (#usl or #lsl) in one pass
+	*
+	* Input:
+	*		values			vector<wstring>			limit row
+	*		scales			vector<int>				scale per column from get_unit_scale_column
+	* Output:
+	*		scaled_values	vector<wstring>			scaled limit row, empty entries for empty or NaN limits
+	*
+	* Columns without scale (row longer than #unit row) are scaled with 0
+	*
+	*************************************************************************************************************************************************************************/
+	vector<wstring> scale_column(const vector<wstring>&, const vector<int>&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function reads a cell or field as double
+	*
+	* Input:
+	*		text / length	wchar_t* / size_t		text, doesn't have to be terminated
+	*		value			double*					resulting number
+	* Output:
+	*		res				bool					true if the whole text is a number, false for empty text. NaN and inf are numbers, callers
+	*												which take only finite values check for them
+	*
+	*************************************************************************************************************************************************************************/
+	static bool parse_double(const wchar_t*, size_t, double*);
+	static bool parse_double(const wstring&, double*);
+
+	// shortest text which reads back to the same double (%.15g to %.17g), keeps all digits of limits and statistics
+	static wstring format_double(double);
+
+	UnitScaling();
+	~UnitScaling();
+
+private:
+	bool is_known_unit(const wstring&);
+};
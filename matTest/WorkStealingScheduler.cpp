@@ -0,0 +1,116 @@
+#include "WorkStealingScheduler.h"
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+// a worker waiting for a group slot looks for stealable jobs again after this time at the latest
+static const int GROUP_WAIT_MS = 100;
+
+WorkStealingScheduler::WorkStealingScheduler(int worker_count) :
+	worker_count(max(1, worker_count)), submitted(0), remaining(0), stolen(0) {
+	for (int i = 0; i < this->worker_count; i++) {
+		this->queues.push_back(unique_ptr<WorkerQueue>(new WorkerQueue()));
+	}
+}
+
+int WorkStealingScheduler::add_group(int limit) {
+	this->group_slots.push_back(max(1, limit));
+	return (int)this->group_slots.size() - 1;
+}
+
+void WorkStealingScheduler::submit(const function<void(int)>& job, const vector<int>& groups) {
+	Job queued = { job, groups };
+	this->queues[this->submitted % this->worker_count]->jobs.push_back(queued);
+	this->submitted++;
+	this->remaining++;
+}
+
+bool WorkStealingScheduler::acquire_groups(const vector<int>& groups) {
+	lock_guard<mutex> lock(this->group_mutex);
+	for (int group : groups) {
+		if (this->group_slots[group] <= 0) {
+			return false;
+		}
+	}
+	for (int group : groups) {
+		this->group_slots[group]--;
+	}
+	return true;
+}
+
+void WorkStealingScheduler::release_groups(const vector<int>& groups) {
+	{
+		lock_guard<mutex> lock(this->group_mutex);
+		for (int group : groups) {
+			this->group_slots[group]++;
+		}
+	}
+	this->group_released.notify_all();
+}
+
+bool WorkStealingScheduler::take_job(int worker_index, Job& job, bool& blocked) {
+	// own queue first, then the others starting with the next worker
+	for (int i = 0; i < this->worker_count; i++) {
+		WorkerQueue& queue = *this->queues[(worker_index + i) % this->worker_count];
+		lock_guard<mutex> lock(queue.queue_mutex);
+		// the first job whose groups have a free slot, jobs behind a full group are not held up
+		for (deque<Job>::iterator it = queue.jobs.begin(); it != queue.jobs.end(); ++it) {
+			if (!acquire_groups(it->groups)) {
+				blocked = true;
+				continue;
+			}
+			job = *it;
+			queue.jobs.erase(it);
+			if (i > 0) {
+				this->stolen++;
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+void WorkStealingScheduler::worker(int worker_index) {
+	while (this->remaining > 0) {
+		Job job;
+		bool blocked = false;
+		if (take_job(worker_index, job, blocked)) {
+			job.run(worker_index);
+			this->remaining--;
+			release_groups(job.groups);
+			continue;
+		}
+		if (!blocked) {
+			// every queue is empty, the jobs left are running on other workers
+			break;
+		}
+		unique_lock<mutex> lock(this->group_mutex);
+		this->group_released.wait_for(lock, chrono::milliseconds(GROUP_WAIT_MS));
+	}
+}
+
+void WorkStealingScheduler::run() {
+	vector<thread> threads;
+	for (int i = 0; i < this->worker_count; i++) {
+		threads.push_back(thread(&WorkStealingScheduler::worker, this, i));
+	}
+	for (thread& worker_thread : threads) {
+		worker_thread.join();
+	}
+}
+
+int WorkStealingScheduler::workers() const {
+	return this->worker_count;
+}
+
+size_t WorkStealingScheduler::steals() const {
+	return this->stolen;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <atomic>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+#pragma once
+class WorkStealingScheduler
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function creates a scheduler which runs jobs on a fixed number of worker threads
+	*
+	* Input:
+	*		worker_count		int					number of jobs running at the same time
+	*
+	*************************************************************************************************************************************************************************/
+	WorkStealingScheduler(int);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function adds a group of jobs which may only run a limited number at a time
+	*
+	* Input:
+	*		limit				int					maximum number of jobs of the group running at the same time
+	* Output:
+	*		res					int					group index given to submit
+	*
+	*************************************************************************************************************************************************************************/
+	int add_group(int);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function adds a job, jobs have to be submitted before run()
+	*
+	* Input:
+	*		job					function<void(int)>	the job, called with the index of the worker running it, must not throw
+	*		groups				vector<int>			groups the job belongs to, it only starts when all of them have a free slot
+	*
+	* Jobs are dealt to the workers in the order of submission, so submitting the largest first makes every worker start with its largest job
+	*
+	*************************************************************************************************************************************************************************/
+	void submit(const function<void(int)>&, const vector<int>&);
+
+
+	/*************************************************************************************************************************************************************************
+	* This function runs all submitted jobs and returns when all of them are done
+	*
+	* Each worker takes the jobs of its own queue from the front. A worker with an empty queue steals the next job from the front of
+	* another queue, so the largest remaining job is always started first and no worker idles while jobs are left.
+	*
+	*************************************************************************************************************************************************************************/
+	void run();
+
+	int workers() const;
+	// number of jobs a worker took from another worker's queue
+	size_t steals() const;
+
+private:
+	struct Job {
+		function<void(int)> run;
+		vector<int> groups;
+	};
+	struct WorkerQueue {
+		mutex queue_mutex;
+		deque<Job> jobs;
+	};
+
+	bool take_job(int, Job&, bool&);
+	bool acquire_groups(const vector<int>&);
+	void release_groups(const vector<int>&);
+	void worker(int);
+
+	int worker_count;
+	vector<unique_ptr<WorkerQueue>> queues;
+	size_t submitted;
+
+	// free slots per group, protected by group_mutex, group_released is notified whenever a job finishes
+	mutex group_mutex;
+	condition_variable group_released;
+	vector<int> group_slots;
+	atomic<size_t> remaining;
+	atomic<size_t> stolen;
+};
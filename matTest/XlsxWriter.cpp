@@ -0,0 +1,347 @@
+#include "XlsxWriter.h"
+#include "DataReader.h"
+#include "UnitScaling.h"
+#include <cmath>
+#include <cwchar>
+#include <cwctype>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+// text kept for the shared strings table, beyond it texts are written into their cells
+static const size_t SHARED_STRINGS_BYTES = 16 * 1024 * 1024;
+// a cell longer than this is no number
+static const size_t MAX_NUMBER_CHARS = 64;
+static const size_t MAX_SHEET_NAME = 31;
+
+static const char XML_DECLARATION[] = "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n";
+static const string MAIN_NAMESPACE = "http://schemas.openxmlformats.org/spreadsheetml/2006/main";
+static const string RELATIONSHIPS = "http://schemas.openxmlformats.org/officeDocument/2006/relationships";
+static const string PACKAGE_RELATIONSHIPS = "http://schemas.openxmlformats.org/package/2006/relationships";
+static const string CONTENT_TYPE = "application/vnd.openxmlformats-officedocument.spreadsheetml.";
+
+// appends text as UTF-8 with XML escapes, chars XML 1.0 doesn't allow are dropped
+static void append_xml(string& out, const wchar_t *text, size_t length) {
+	for (size_t i = 0; i < length; i++) {
+		unsigned int c = (unsigned int)text[i];
+		if (c >= 0xD800 && c <= 0xDFFF) {
+			// surrogate pair of a UTF-16 wchar_t
+			if (c <= 0xDBFF && i + 1 < length && (unsigned int)text[i + 1] >= 0xDC00 && (unsigned int)text[i + 1] <= 0xDFFF) {
+				c = 0x10000 + ((c - 0xD800) << 10) + ((unsigned int)text[i + 1] - 0xDC00);
+				i++;
+			}
+			else {
+				continue;
+			}
+		}
+		if (c == '&') {
+			out += "&amp;";
+		}
+		else if (c == '<') {
+			out += "&lt;";
+		}
+		else if (c == '>') {
+			out += "&gt;";
+		}
+		else if (c == '"') {
+			out += "&quot;";
+		}
+		else if ((c < 0x20 && c != '\t' && c != '\n' && c != '\r') || c == 0xFFFE || c == 0xFFFF || c > 0x10FFFF) {
+			continue;
+		}
+		else if (c < 0x80) {
+			out += (char)c;
+		}
+		else if (c < 0x800) {
+			out += (char)(0xC0 | (c >> 6));
+			out += (char)(0x80 | (c & 0x3F));
+		}
+		else if (c < 0x10000) {
+			out += (char)(0xE0 | (c >> 12));
+			out += (char)(0x80 | ((c >> 6) & 0x3F));
+			out += (char)(0x80 | (c & 0x3F));
+		}
+		else {
+			out += (char)(0xF0 | (c >> 18));
+			out += (char)(0x80 | ((c >> 12) & 0x3F));
+			out += (char)(0x80 | ((c >> 6) & 0x3F));
+			out += (char)(0x80 | (c & 0x3F));
+		}
+	}
+}
+
+static void append_xml(string& out, const wstring& text) {
+	append_xml(out, text.data(), text.size());
+}
+
+// plain decimal number (1.500000, -3, 2e-05), written as it is into <v>
+static bool is_number(const wchar_t *text, size_t length) {
+	if (length == 0 || length >= MAX_NUMBER_CHARS) {
+		return false;
+	}
+	bool digit = false;
+	for (size_t i = 0; i < length; i++) {
+		wchar_t c = text[i];
+		if (c >= L'0' && c <= L'9') {
+			digit = true;
+		}
+		else if (c != L'.' && c != L'-' && c != L'+' && c != L'e' && c != L'E') {
+			return false;
+		}
+	}
+	double value;
+	return digit && UnitScaling::parse_double(text, length, &value) && std::isfinite(value);
+}
+
+// Excel takes no []:*?/\ in sheet names and no ' at either end
+static wstring sheet_name_part(const wstring& name) {
+	wstring part = name.substr(0, MAX_SHEET_NAME);
+	for (wchar_t& c : part) {
+		if (c == L'[' || c == L']' || c == L':' || c == L'*' || c == L'?' || c == L'/' || c == L'\\' || c < 0x20) {
+			c = L'_';
+		}
+	}
+	if (!part.empty() && part.front() == L'\'') {
+		part.front() = L'_';
+	}
+	if (!part.empty() && part.back() == L'\'') {
+		part.back() = L'_';
+	}
+	return part.empty() ? L"Sheet" : part;
+}
+
+static wstring lower_case(wstring text) {
+	for (wchar_t& c : text) {
+		c = towlower(c);
+	}
+	return text;
+}
+
+XlsxWriter::XlsxWriter(const wstring& xlsx_file) :
+	zip(xlsx_file), in_sheet(false), row(0), column(0), sheet_bytes(0), shared_strings_bytes(0), shared_string_cells(0) {
+}
+
+bool XlsxWriter::is_open() const {
+	return this->zip.is_open();
+}
+
+void XlsxWriter::begin_sheet(const wstring& name, int frozen_rows) {
+	end_sheet();
+	// sheet names are unique regardless of case
+	wstring base = sheet_name_part(name);
+	wstring sheet_name = base;
+	for (int copy = 2; ; copy++) {
+		bool taken = false;
+		for (const wstring& other : this->sheet_names) {
+			taken = taken || lower_case(other) == lower_case(sheet_name);
+		}
+		if (!taken) {
+			break;
+		}
+		wstring suffix = L" (" + to_wstring(copy) + L")";
+		sheet_name = base.substr(0, MAX_SHEET_NAME - suffix.size()) + suffix;
+	}
+	this->sheet_names.push_back(sheet_name);
+	this->zip.begin_entry("xl/worksheets/sheet" + to_string(this->sheet_names.size()) + ".xml");
+	string xml = XML_DECLARATION;
+	xml += "<worksheet xmlns=\"" + MAIN_NAMESPACE + "\" xmlns:r=\"" + RELATIONSHIPS + "\"><sheetViews><sheetView workbookViewId=\"0\">";
+	if (frozen_rows > 0) {
+		xml += "<pane ySplit=\"" + to_string(frozen_rows) + "\" topLeftCell=\"A" + to_string(frozen_rows + 1) + "\" activePane=\"bottomLeft\" state=\"frozen\"/>";
+	}
+	xml += "</sheetView></sheetViews><sheetData>";
+	this->zip.write(xml);
+	this->in_sheet = true;
+	this->sheet_bytes = xml.size();
+	this->row = 0;
+	this->column = 0;
+}
+
+void XlsxWriter::end_sheet() {
+	if (!this->in_sheet) {
+		return;
+	}
+	if (this->column > 0) {
+		end_row();
+	}
+	this->zip.write(string("</sheetData></worksheet>"));
+	this->zip.end_entry();
+	this->in_sheet = false;
+}
+
+const string& XlsxWriter::column_name(int index) {
+	DataReader dr;
+	while ((int)this->column_names.size() <= index) {
+		wstring name = dr.get_excel_col_name((int)this->column_names.size() + 1);
+		this->column_names.push_back(string(name.begin(), name.end()));
+	}
+	return this->column_names[index];
+}
+
+void XlsxWriter::begin_cell(const char *type) {
+	if (this->row_xml.empty()) {
+		this->row_xml = "<row r=\"" + to_string(this->row + 1) + "\">";
+	}
+	this->row_xml += "<c r=\"";
+	this->row_xml += column_name(this->column);
+	this->row_xml += to_string(this->row + 1);
+	this->row_xml += '"';
+	if (type != NULL) {
+		this->row_xml += " t=\"";
+		this->row_xml += type;
+		this->row_xml += '"';
+	}
+	this->row_xml += '>';
+}
+
+void XlsxWriter::add_cell(const wchar_t *text, size_t length) {
+	if (!is_number(text, length)) {
+		add_text(wstring(text, length));
+		return;
+	}
+	if (this->column < XLSX_MAX_COLUMNS) {
+		begin_cell(NULL);
+		this->row_xml += "<v>";
+		append_xml(this->row_xml, text, length);
+		this->row_xml += "</v></c>";
+	}
+	this->column++;
+}
+
+void XlsxWriter::add_text(const wstring& text) {
+	if (text.empty() || this->column >= XLSX_MAX_COLUMNS) {
+		this->column++;
+		return;
+	}
+	unordered_map<wstring, unsigned int>::iterator shared = this->shared_strings.find(text);
+	if (shared == this->shared_strings.end() && this->shared_strings_bytes + text.size() * sizeof(wchar_t) <= SHARED_STRINGS_BYTES) {
+		shared = this->shared_strings.insert(make_pair(text, (unsigned int)this->shared_strings.size())).first;
+		this->shared_strings_bytes += text.size() * sizeof(wchar_t);
+	}
+	if (shared != this->shared_strings.end()) {
+		begin_cell("s");
+		this->row_xml += "<v>" + to_string(shared->second) + "</v></c>";
+		this->shared_string_cells++;
+	}
+	else {
+		// the table is full, the text goes into the cell
+		begin_cell("inlineStr");
+		this->row_xml += "<is><t xml:space=\"preserve\">";
+		append_xml(this->row_xml, text);
+		this->row_xml += "</t></is></c>";
+	}
+	this->column++;
+}
+
+void XlsxWriter::end_row() {
+	if (!this->row_xml.empty()) {
+		this->row_xml += "</row>";
+		this->zip.write(this->row_xml);
+		this->sheet_bytes += this->row_xml.size();
+		this->row_xml.clear();
+	}
+	this->row++;
+	this->column = 0;
+}
+
+int XlsxWriter::sheet_rows() const {
+	return this->row;
+}
+
+bool XlsxWriter::sheet_full() const {
+	return this->row >= XLSX_MAX_ROWS || this->sheet_bytes >= XLSX_MAX_SHEET_BYTES;
+}
+
+int XlsxWriter::sheet_count() const {
+	return (int)this->sheet_names.size();
+}
+
+bool XlsxWriter::close() {
+	end_sheet();
+	// a workbook has at least one sheet
+	if (this->sheet_names.empty()) {
+		begin_sheet(L"Sheet1", 0);
+		end_sheet();
+	}
+
+	// shared strings in order of their index
+	vector<const wstring*> ordered_strings(this->shared_strings.size());
+	for (unordered_map<wstring, unsigned int>::value_type& shared : this->shared_strings) {
+		ordered_strings[shared.second] = &shared.first;
+	}
+	this->zip.begin_entry("xl/sharedStrings.xml");
+	string xml = XML_DECLARATION;
+	xml += "<sst xmlns=\"" + MAIN_NAMESPACE + "\" count=\"" + to_string(this->shared_string_cells) + "\" uniqueCount=\"" + to_string(ordered_strings.size()) + "\">";
+	for (const wstring *text : ordered_strings) {
+		xml += "<si><t xml:space=\"preserve\">";
+		append_xml(xml, *text);
+		xml += "</t></si>";
+		if (xml.size() >= 64 * 1024) {
+			this->zip.write(xml);
+			xml.clear();
+		}
+	}
+	xml += "</sst>";
+	this->zip.write(xml);
+	this->zip.end_entry();
+	this->shared_strings.clear();
+
+	this->zip.begin_entry("xl/styles.xml");
+	this->zip.write(XML_DECLARATION + string("<styleSheet xmlns=\"") + MAIN_NAMESPACE + "\">"
+		"<fonts count=\"1\"><font><sz val=\"11\"/><name val=\"Calibri\"/></font></fonts>"
+		"<fills count=\"2\"><fill><patternFill patternType=\"none\"/></fill><fill><patternFill patternType=\"gray125\"/></fill></fills>"
+		"<borders count=\"1\"><border><left/><right/><top/><bottom/><diagonal/></border></borders>"
+		"<cellStyleXfs count=\"1\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\"/></cellStyleXfs>"
+		"<cellXfs count=\"1\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\"/></cellXfs>"
+		"</styleSheet>");
+	this->zip.end_entry();
+
+	string sheets;
+	string sheet_relations;
+	string sheet_types;
+	for (size_t i = 0; i < this->sheet_names.size(); i++) {
+		string number = to_string(i + 1);
+		sheets += "<sheet name=\"";
+		append_xml(sheets, this->sheet_names[i]);
+		sheets += "\" sheetId=\"" + number + "\" r:id=\"rId" + number + "\"/>";
+		sheet_relations += "<Relationship Id=\"rId" + number + "\" Type=\"" + RELATIONSHIPS + "/worksheet\" Target=\"worksheets/sheet" + number + ".xml\"/>";
+		sheet_types += "<Override PartName=\"/xl/worksheets/sheet" + number + ".xml\" ContentType=\"" + CONTENT_TYPE + "worksheet+xml\"/>";
+	}
+	this->zip.begin_entry("xl/workbook.xml");
+	this->zip.write(XML_DECLARATION + string("<workbook xmlns=\"") + MAIN_NAMESPACE + "\" xmlns:r=\"" + RELATIONSHIPS + "\">"
+		"<bookViews><workbookView/></bookViews><sheets>" + sheets + "</sheets></workbook>");
+	this->zip.end_entry();
+
+	this->zip.begin_entry("xl/_rels/workbook.xml.rels");
+	this->zip.write(XML_DECLARATION + string("<Relationships xmlns=\"") + PACKAGE_RELATIONSHIPS + "\">" + sheet_relations +
+		"<Relationship Id=\"rId" + to_string(this->sheet_names.size() + 1) + "\" Type=\"" + RELATIONSHIPS + "/styles\" Target=\"styles.xml\"/>"
+		"<Relationship Id=\"rId" + to_string(this->sheet_names.size() + 2) + "\" Type=\"" + RELATIONSHIPS + "/sharedStrings\" Target=\"sharedStrings.xml\"/>"
+		"</Relationships>");
+	this->zip.end_entry();
+
+	this->zip.begin_entry("_rels/.rels");
+	this->zip.write(XML_DECLARATION + string("<Relationships xmlns=\"") + PACKAGE_RELATIONSHIPS + "\">"
+		"<Relationship Id=\"rId1\" Type=\"" + RELATIONSHIPS + "/officeDocument\" Target=\"xl/workbook.xml\"/></Relationships>");
+	this->zip.end_entry();
+
+	this->zip.begin_entry("[Content_Types].xml");
+	this->zip.write(XML_DECLARATION + string("<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+		"<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+		"<Default Extension=\"xml\" ContentType=\"application/xml\"/>"
+		"<Override PartName=\"/xl/workbook.xml\" ContentType=\"") + CONTENT_TYPE + "sheet.main+xml\"/>" + sheet_types +
+		"<Override PartName=\"/xl/styles.xml\" ContentType=\"" + CONTENT_TYPE + "styles+xml\"/>"
+		"<Override PartName=\"/xl/sharedStrings.xml\" ContentType=\"" + CONTENT_TYPE + "sharedStrings+xml\"/></Types>");
+	this->zip.end_entry();
+	return this->zip.close();
+}
+
+unsigned long long XlsxWriter::xml_bytes() const {
+	return this->zip.total_bytes();
+}
+
+unsigned long long XlsxWriter::compressed_bytes() const {
+	return this->zip.total_compressed_bytes();
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "ZipStreamWriter.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// limits of an Excel sheet
+static const int XLSX_MAX_ROWS = 1048576;
+static const int XLSX_MAX_COLUMNS = 16384;
+// a sheet is continued in the next one before its XML gets near the 4 GB of a zip entry without zip64
+static const unsigned long long XLSX_MAX_SHEET_BYTES = 0xF0000000ull;
+
+#pragma once
+class XlsxWriter
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function creates an Excel workbook (.xlsx) written row by row
+	*
+	* Input:
+	*		xlsx_file			wstring				workbook to create, an existing file is replaced
+	*
+	* Sheets are streamed into the zip archive while they are written, a row is gone once it is ended. Only the shared strings are kept
+	* until close, and only up to SHARED_STRINGS_BYTES of text, further texts are written into their cells (inline strings).
+	*
+	*************************************************************************************************************************************************************************/
+	XlsxWriter(const wstring&);
+
+	bool is_open() const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function starts the next sheet, the one before is ended
+	*
+	* Input:
+	*		name				wstring				name of the sheet, chars Excel doesn't take are replaced and " (2)" ... is added if it is taken
+	*		frozen_rows			int					rows kept in view when scrolling (header rows)
+	*
+	*************************************************************************************************************************************************************************/
+	void begin_sheet(const wstring&, int);
+	void end_sheet();
+
+
+	/*************************************************************************************************************************************************************************
+	* These functions add a cell to the current row, the row is started with the first cell
+	*
+	* Input:
+	*		text / length		wchar_t* / size_t	add_cell: written as number if it is one, as text otherwise, nothing for an empty cell
+	*		text				wstring				add_text: always written as text
+	*
+	*************************************************************************************************************************************************************************/
+	void add_cell(const wchar_t*, size_t);
+	void add_text(const wstring&);
+	void end_row();
+
+	// rows of the current sheet, a sheet takes at most XLSX_MAX_ROWS
+	int sheet_rows() const;
+	// true if the current sheet has XLSX_MAX_ROWS rows or XLSX_MAX_SHEET_BYTES of XML, the next row goes into a new sheet
+	bool sheet_full() const;
+	int sheet_count() const;
+
+
+	/*************************************************************************************************************************************************************************
+	* This function writes shared strings, workbook and relations and closes the archive
+	*
+	* Output:
+	*		res					bool				false if the workbook couldn't be written completely
+	*
+	*************************************************************************************************************************************************************************/
+	bool close();
+
+	// uncompressed and compressed size of the workbook, valid after close
+	unsigned long long xml_bytes() const;
+	unsigned long long compressed_bytes() const;
+
+private:
+	void begin_cell(const char*);
+	const string& column_name(int);
+
+	ZipStreamWriter zip;
+	vector<wstring> sheet_names;
+	bool in_sheet;
+	int row;
+	int column;
+	// XML of the current sheet so far
+	unsigned long long sheet_bytes;
+	// XML of the current row, handed to the archive when the row is ended
+	string row_xml;
+	// A, B, ... for the columns used so far
+	vector<string> column_names;
+	// text -> index of the shared string
+	unordered_map<wstring, unsigned int> shared_strings;
+	size_t shared_strings_bytes;
+	unsigned long long shared_string_cells;
+};
@@ -0,0 +1,425 @@
+#include "ZipStreamWriter.h"
+#include "ConversionLog.h"
+#include <algorithm>
+#include <ctime>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+// entry data deflated at once, the deflate thread gets it in blocks of this size
+static const size_t ZIP_BLOCK_BYTES = 64 * 1024;
+// blocks waiting for the deflate thread before the writer has to wait
+static const size_t ZIP_QUEUE_BLOCKS = 8;
+// largest size and offset without zip64
+static const unsigned long long ZIP_MAX_BYTES = 0xFFFFFFFFull;
+
+// matches reach back this far, into the blocks written before
+static const size_t DEFLATE_WINDOW = 32768;
+static const int DEFLATE_HASH_BITS = 15;
+// candidates compared per position, more compresses a little better and a lot slower
+static const int DEFLATE_MAX_CHAIN = 32;
+static const int DEFLATE_MIN_MATCH = 3;
+static const int DEFLATE_MAX_MATCH = 258;
+
+// length and distance codes of RFC 1951, base value and number of extra bits
+static const int LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const int LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const int DISTANCE_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289,
+	16385, 24577 };
+static const int DISTANCE_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+// CRC-32 of zip (polynomial 0xEDB88320)
+struct Crc32Table {
+	unsigned int values[256];
+
+	Crc32Table() {
+		for (unsigned int i = 0; i < 256; i++) {
+			unsigned int crc = i;
+			for (int bit = 0; bit < 8; bit++) {
+				crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+			}
+			this->values[i] = crc;
+		}
+	}
+};
+
+static unsigned int crc32_update(unsigned int crc, const char *data, size_t size) {
+	static const Crc32Table table;
+	for (size_t i = 0; i < size; i++) {
+		crc = table.values[(crc ^ (unsigned char)data[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return crc;
+}
+
+/*************************************************************************************************************************************************************************
+* Deflate (RFC 1951) with LZ77 matches from hash chains and the fixed Huffman codes, one block per call of compress
+*
+* Sheet XML repeats the same tags in every row, fixed codes already take most of it. The window continues over the blocks of an entry.
+*************************************************************************************************************************************************************************/
+class DeflateEncoder
+{
+
+public:
+	DeflateEncoder() : head(1 << DEFLATE_HASH_BITS), bit_buffer(0), bit_count(0) {}
+
+	void reset() {
+		this->window.clear();
+		this->bit_buffer = 0;
+		this->bit_count = 0;
+	}
+
+	// appends the compressed block to out, the last block of an entry is final and ends on a byte
+	void compress(const char *data, size_t size, bool final, string& out) {
+		size_t history = this->window.size();
+		this->window.append(data, size);
+		const unsigned char *text = (const unsigned char*)this->window.data();
+		size_t end = this->window.size();
+		fill(this->head.begin(), this->head.end(), -1);
+		this->chain.resize(end);
+		for (size_t pos = 0; pos + DEFLATE_MIN_MATCH <= history; pos++) {
+			insert(text, pos);
+		}
+
+		// BFINAL, BTYPE 01 (fixed codes)
+		put_bits(final ? 1 : 0, 1, out);
+		put_bits(1, 2, out);
+		size_t pos = history;
+		while (pos < end) {
+			int best_length = 0;
+			size_t best_distance = 0;
+			if (pos + DEFLATE_MIN_MATCH <= end) {
+				int max_length = (int)min((size_t)DEFLATE_MAX_MATCH, end - pos);
+				int candidate = this->head[hash(text + pos)];
+				for (int tries = 0; candidate >= 0 && tries < DEFLATE_MAX_CHAIN && pos - candidate <= DEFLATE_WINDOW; tries++) {
+					const unsigned char *match = text + candidate;
+					if (match[best_length] == text[pos + best_length]) {
+						int length = 0;
+						while (length < max_length && match[length] == text[pos + length]) {
+							length++;
+						}
+						if (length > best_length) {
+							best_length = length;
+							best_distance = pos - candidate;
+							if (length == max_length) {
+								break;
+							}
+						}
+					}
+					candidate = this->chain[candidate];
+				}
+			}
+			if (best_length >= DEFLATE_MIN_MATCH) {
+				put_match(best_length, (int)best_distance, out);
+				for (size_t i = pos; i < pos + best_length && i + DEFLATE_MIN_MATCH <= end; i++) {
+					insert(text, i);
+				}
+				pos += best_length;
+			}
+			else {
+				put_symbol(text[pos], out);
+				if (pos + DEFLATE_MIN_MATCH <= end) {
+					insert(text, pos);
+				}
+				pos++;
+			}
+		}
+		// end of block
+		put_symbol(256, out);
+		if (final) {
+			put_bits(0, (8 - this->bit_count % 8) % 8, out);
+		}
+		if (this->window.size() > DEFLATE_WINDOW) {
+			this->window.erase(0, this->window.size() - DEFLATE_WINDOW);
+		}
+	}
+
+private:
+	static int hash(const unsigned char *text) {
+		return ((text[0] << 10) ^ (text[1] << 5) ^ text[2]) & ((1 << DEFLATE_HASH_BITS) - 1);
+	}
+
+	void insert(const unsigned char *text, size_t pos) {
+		int& bucket = this->head[hash(text + pos)];
+		this->chain[pos] = bucket;
+		bucket = (int)pos;
+	}
+
+	// bits are packed starting with the least significant one
+	void put_bits(unsigned int bits, int count, string& out) {
+		this->bit_buffer |= bits << this->bit_count;
+		this->bit_count += count;
+		while (this->bit_count >= 8) {
+			out += (char)(this->bit_buffer & 0xFF);
+			this->bit_buffer >>= 8;
+			this->bit_count -= 8;
+		}
+	}
+
+	// Huffman codes are packed starting with the most significant bit
+	void put_code(unsigned int code, int length, string& out) {
+		unsigned int reversed = 0;
+		for (int i = 0; i < length; i++) {
+			reversed = (reversed << 1) | ((code >> i) & 1);
+		}
+		put_bits(reversed, length, out);
+	}
+
+	// literal/length symbol with the fixed code
+	void put_symbol(int symbol, string& out) {
+		if (symbol < 144) {
+			put_code(0x30 + symbol, 8, out);
+		}
+		else if (symbol < 256) {
+			put_code(0x190 + symbol - 144, 9, out);
+		}
+		else if (symbol < 280) {
+			put_code(symbol - 256, 7, out);
+		}
+		else {
+			put_code(0xC0 + symbol - 280, 8, out);
+		}
+	}
+
+	void put_match(int length, int distance, string& out) {
+		int length_code = (int)(upper_bound(LENGTH_BASE, LENGTH_BASE + 29, length) - LENGTH_BASE) - 1;
+		put_symbol(257 + length_code, out);
+		put_bits(length - LENGTH_BASE[length_code], LENGTH_EXTRA[length_code], out);
+		int distance_code = (int)(upper_bound(DISTANCE_BASE, DISTANCE_BASE + 30, distance) - DISTANCE_BASE) - 1;
+		put_code(distance_code, 5, out);
+		put_bits(distance - DISTANCE_BASE[distance_code], DISTANCE_EXTRA[distance_code], out);
+	}
+
+	// last DEFLATE_WINDOW bytes of the entry followed by the block being compressed
+	string window;
+	// latest position of every hash and the position before it with the same hash
+	vector<int> head;
+	vector<int> chain;
+	unsigned int bit_buffer;
+	int bit_count;
+};
+
+static void put_16(string& out, unsigned int value) {
+	out += (char)(value & 0xFF);
+	out += (char)((value >> 8) & 0xFF);
+}
+
+static void put_32(string& out, unsigned long long value) {
+	put_16(out, (unsigned int)(value & 0xFFFF));
+	put_16(out, (unsigned int)((value >> 16) & 0xFFFF));
+}
+
+// general purpose flags: sizes follow the data (bit 3), names are UTF-8 (bit 11)
+static const unsigned int ZIP_FLAGS = 0x0808;
+static const unsigned int ZIP_VERSION = 20;
+static const unsigned int ZIP_DEFLATED = 8;
+
+ZipStreamWriter::ZipStreamWriter(const wstring& zip_file) :
+	zip_out(zip_file, ios::binary | ios::trunc), blocks(ZIP_QUEUE_BLOCKS), failed(false), closed(false) {
+	time_t now = time(NULL);
+	tm local_time;
+#ifdef _WIN32
+	localtime_s(&local_time, &now);
+#else
+	localtime_r(&now, &local_time);
+#endif
+	this->dos_time = (unsigned short)((local_time.tm_hour << 11) | (local_time.tm_min << 5) | (local_time.tm_sec / 2));
+	this->dos_date = (unsigned short)(((local_time.tm_year - 80) << 9) | ((local_time.tm_mon + 1) << 5) | local_time.tm_mday);
+	if (!this->zip_out) {
+		LogLine() << L"Couldn't create " << zip_file;
+		this->failed = true;
+	}
+	this->deflate_thread = thread(&ZipStreamWriter::deflate_blocks, this);
+}
+
+ZipStreamWriter::~ZipStreamWriter() {
+	if (!this->closed) {
+		// not closed after an error, the archive is incomplete anyway
+		this->blocks.cancel();
+		this->deflate_thread.join();
+	}
+}
+
+bool ZipStreamWriter::is_open() const {
+	return !this->failed;
+}
+
+void ZipStreamWriter::begin_entry(const string& name) {
+	this->current_block = make_shared<ZipBlock>();
+	this->current_block->entry_name = name;
+	this->current_block->data.reserve(ZIP_BLOCK_BYTES);
+}
+
+void ZipStreamWriter::write(const char *data, size_t size) {
+	while (size > 0) {
+		size_t part = min(size, ZIP_BLOCK_BYTES - this->current_block->data.size());
+		this->current_block->data.append(data, part);
+		data += part;
+		size -= part;
+		if (this->current_block->data.size() >= ZIP_BLOCK_BYTES) {
+			push_block(false);
+		}
+	}
+}
+
+void ZipStreamWriter::write(const string& data) {
+	write(data.data(), data.size());
+}
+
+void ZipStreamWriter::end_entry() {
+	push_block(true);
+}
+
+void ZipStreamWriter::push_block(bool entry_end) {
+	this->current_block->entry_end = entry_end;
+	if (!this->blocks.push(this->current_block)) {
+		this->failed = true;
+	}
+	this->current_block.reset();
+	if (!entry_end) {
+		this->current_block = make_shared<ZipBlock>();
+		this->current_block->data.reserve(ZIP_BLOCK_BYTES);
+	}
+}
+
+void ZipStreamWriter::deflate_blocks() {
+	try {
+		DeflateEncoder encoder;
+		ZipEntry entry = { "", 0, 0, 0, 0 };
+		unsigned int crc = 0;
+		unsigned long long offset = 0;
+		string out;
+		auto write_out = [&]() {
+			this->zip_out.write(out.data(), out.size());
+			offset += out.size();
+			if (!this->zip_out || offset > ZIP_MAX_BYTES) {
+				if (offset > ZIP_MAX_BYTES) {
+					LogLine() << L"Zip archive exceeds 4 GB";
+				}
+				this->failed = true;
+				this->blocks.cancel();
+			}
+		};
+		shared_ptr<ZipBlock> block;
+		while (this->blocks.pop(block)) {
+			if (!block->entry_name.empty()) {
+				entry.name = block->entry_name;
+				entry.compressed_size = 0;
+				entry.size = 0;
+				entry.offset = offset;
+				crc = 0xFFFFFFFFu;
+				encoder.reset();
+				// local file header, CRC and sizes are in the data descriptor
+				out.clear();
+				put_32(out, 0x04034b50);
+				put_16(out, ZIP_VERSION);
+				put_16(out, ZIP_FLAGS);
+				put_16(out, ZIP_DEFLATED);
+				put_16(out, this->dos_time);
+				put_16(out, this->dos_date);
+				put_32(out, 0);
+				put_32(out, 0);
+				put_32(out, 0);
+				put_16(out, (unsigned int)entry.name.size());
+				put_16(out, 0);
+				out += entry.name;
+				write_out();
+			}
+			crc = crc32_update(crc, block->data.data(), block->data.size());
+			entry.size += block->data.size();
+			// the sizes in the data descriptor and the central directory have 32 bits as well
+			if (entry.size > ZIP_MAX_BYTES) {
+				LogLine() << L"Zip entry " << entry.name.c_str() << L" exceeds 4 GB";
+				this->failed = true;
+				this->blocks.cancel();
+				break;
+			}
+			out.clear();
+			encoder.compress(block->data.data(), block->data.size(), block->entry_end, out);
+			entry.compressed_size += out.size();
+			write_out();
+			if (block->entry_end) {
+				entry.crc = ~crc;
+				out.clear();
+				put_32(out, 0x08074b50);
+				put_32(out, entry.crc);
+				put_32(out, entry.compressed_size);
+				put_32(out, entry.size);
+				write_out();
+				this->entries.push_back(entry);
+			}
+		}
+	}
+	catch (...) {
+		this->failed = true;
+		this->blocks.cancel();
+	}
+}
+
+bool ZipStreamWriter::close() {
+	if (this->closed) {
+		return !this->failed;
+	}
+	this->closed = true;
+	this->blocks.close();
+	this->deflate_thread.join();
+	if (this->failed) {
+		this->zip_out.close();
+		return false;
+	}
+	// central directory
+	string out;
+	unsigned long long directory_offset = this->zip_out.tellp();
+	for (const ZipEntry& entry : this->entries) {
+		put_32(out, 0x02014b50);
+		put_16(out, ZIP_VERSION);
+		put_16(out, ZIP_VERSION);
+		put_16(out, ZIP_FLAGS);
+		put_16(out, ZIP_DEFLATED);
+		put_16(out, this->dos_time);
+		put_16(out, this->dos_date);
+		put_32(out, entry.crc);
+		put_32(out, entry.compressed_size);
+		put_32(out, entry.size);
+		put_16(out, (unsigned int)entry.name.size());
+		// extra field, comment, disk, internal and external attributes
+		put_16(out, 0);
+		put_16(out, 0);
+		put_16(out, 0);
+		put_16(out, 0);
+		put_32(out, 0);
+		put_32(out, entry.offset);
+		out += entry.name;
+	}
+	unsigned long long directory_size = out.size();
+	put_32(out, 0x06054b50);
+	put_16(out, 0);
+	put_16(out, 0);
+	put_16(out, (unsigned int)this->entries.size());
+	put_16(out, (unsigned int)this->entries.size());
+	put_32(out, directory_size);
+	put_32(out, directory_offset);
+	put_16(out, 0);
+	this->zip_out.write(out.data(), out.size());
+	this->zip_out.close();
+	return !this->zip_out.fail();
+}
+
+unsigned long long ZipStreamWriter::total_bytes() const {
+	unsigned long long bytes = 0;
+	for (const ZipEntry& entry : this->entries) {
+		bytes += entry.size;
+	}
+	return bytes;
+}
+
+unsigned long long ZipStreamWriter::total_compressed_bytes() const {
+	unsigned long long bytes = 0;
+	for (const ZipEntry& entry : this->entries) {
+		bytes += entry.compressed_size;
+	}
+	return bytes;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include "SpscQueue.h"
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+// entry of the central directory, collected while the entries are written
+struct ZipEntry {
+	string name;
+	unsigned int crc;
+	unsigned long long compressed_size;
+	unsigned long long size;
+	unsigned long long offset;
+};
+
+// part of an entry handed to the deflate thread, see ZipStreamWriter::write
+struct ZipBlock {
+	// name of the entry, only set on the block starting it
+	string entry_name;
+	string data;
+	// last block of the entry
+	bool entry_end;
+
+	ZipBlock() : entry_end(false) {}
+};
+
+#pragma once
+class ZipStreamWriter
+{
+
+public:
+	/*************************************************************************************************************************************************************************
+	* This function creates a zip archive whose entries are written as a stream
+	*
+	* Input:
+	*		zip_file			wstring				archive to create, an existing file is replaced
+	*
+	* Entry data is collected in blocks and deflated and written by a worker thread, the caller only waits if that thread falls
+	* ZIP_QUEUE_BLOCKS blocks behind. Sizes and CRC follow the data of an entry (data descriptor), so nothing is kept after a block
+	* is written. Entries and the archive are limited to 4 GB (no zip64).
+	*
+	*************************************************************************************************************************************************************************/
+	ZipStreamWriter(const wstring&);
+	~ZipStreamWriter();
+
+	bool is_open() const;
+
+	// starts the next entry, the one before has to be ended
+	void begin_entry(const string&);
+	void write(const char*, size_t);
+	void write(const string&);
+	void end_entry();
+
+
+	/*************************************************************************************************************************************************************************
+	* This function waits for the worker thread and writes the central directory
+	*
+	* Output:
+	*		res					bool				false if any part of the archive couldn't be written
+	*
+	*************************************************************************************************************************************************************************/
+	bool close();
+
+	// uncompressed and compressed bytes of all entries, valid after close
+	unsigned long long total_bytes() const;
+	unsigned long long total_compressed_bytes() const;
+
+private:
+	ZipStreamWriter(const ZipStreamWriter&);
+	ZipStreamWriter& operator=(const ZipStreamWriter&);
+
+	void push_block(bool);
+	void deflate_blocks();
+
+	ofstream zip_out;
+	// written by the worker thread until close joined it
+	vector<ZipEntry> entries;
+	SpscQueue<shared_ptr<ZipBlock>> blocks;
+	shared_ptr<ZipBlock> current_block;
+	thread deflate_thread;
+	atomic<bool> failed;
+	bool closed;
+	// DOS date and time of all entries
+	unsigned short dos_time;
+	unsigned short dos_date;
+};
@@ -0,0 +1,145 @@
+#include "UnitTest.h"
+#include "../ArrowFileWriter.h"
+#include <cstring>
+#include <experimental\filesystem>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+* ArrowFileWriter: file layout, footer blocks and delta dictionaries
+*
+*************************************************************************************************************************************************************************/
+
+namespace filesys = std::experimental::filesystem;
+
+static string read_file_bytes(const wstring& filename) {
+	ifstream in(filename, ios::binary);
+	return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+}
+
+template<class T> static T read_le(const string& bytes, size_t pos) {
+	T value;
+	memcpy(&value, bytes.data() + pos, sizeof(T));
+	return value;
+}
+
+// position of a flatbuffer table field, 0 if not present
+static size_t flat_field(const string& bytes, size_t table, int id) {
+	size_t vtable = table - read_le<int>(bytes, table);
+	unsigned short vtable_size = read_le<unsigned short>(bytes, vtable);
+	if (4 + 2 * (size_t)id >= vtable_size) {
+		return 0;
+	}
+	unsigned short offset = read_le<unsigned short>(bytes, vtable + 4 + 2 * id);
+	return (offset == 0) ? 0 : table + offset;
+}
+
+// footer of the file, offset of the footer flatbuffer in bytes
+static size_t arrow_footer(const string& bytes) {
+	int footer_length = read_le<int>(bytes, bytes.size() - 10);
+	return bytes.size() - 10 - footer_length;
+}
+
+// blocks of a footer vector (2: dictionaries, 3: record batches)
+static vector<ArrowBlock> footer_blocks(const string& bytes, int id) {
+	vector<ArrowBlock> blocks;
+	size_t footer = arrow_footer(bytes);
+	size_t root = footer + read_le<unsigned int>(bytes, footer);
+	size_t field = flat_field(bytes, root, id);
+	if (field == 0) {
+		return blocks;
+	}
+	size_t vector_pos = field + read_le<unsigned int>(bytes, field);
+	unsigned int count = read_le<unsigned int>(bytes, vector_pos);
+	for (unsigned int i = 0; i < count; i++) {
+		size_t pos = vector_pos + 4 + i * 24;
+		ArrowBlock block = { read_le<unsigned long long>(bytes, pos), read_le<int>(bytes, pos + 8), read_le<unsigned long long>(bytes, pos + 16) };
+		blocks.push_back(block);
+	}
+	return blocks;
+}
+
+static size_t count_substr(const string& bytes, const string& text) {
+	size_t count = 0;
+	for (size_t pos = bytes.find(text); pos != string::npos; pos = bytes.find(text, pos + 1)) {
+		count++;
+	}
+	return count;
+}
+
+UNIT_TEST(arrow_file_has_magic_footer_and_blocks_pointing_to_messages) {
+	wstring arrow_file = (filesys::temp_directory_path() / L"matTestTests_layout.arrow").wstring();
+	unsigned long long written_bytes;
+	{
+		ArrowFileWriter writer(arrow_file);
+		CHECK(writer.is_open());
+		int number = writer.add_column(L"test_number", ARROW_INT64);
+		int value = writer.add_column(L"value", ARROW_FLOAT64);
+		for (int batch = 0; batch < 3; batch++) {
+			for (int row = 0; row < 5; row++) {
+				writer.set_int(number, batch * 5 + row);
+				if (row != 2) {
+					writer.set_double(value, row * 0.5);
+				}
+				writer.end_row();
+			}
+			writer.write_batch();
+		}
+		CHECK(writer.close());
+		CHECK_EQUAL(15ULL, writer.row_count());
+		written_bytes = writer.file_bytes();
+	}
+	string bytes = read_file_bytes(arrow_file);
+	CHECK_EQUAL(written_bytes, (unsigned long long)bytes.size());
+	CHECK(bytes.compare(0, 8, string("ARROW1\0\0", 8)) == 0);
+	CHECK(bytes.compare(bytes.size() - 6, 6, "ARROW1") == 0);
+
+	// every block starts with the continuation marker and its metadata length, messages don't overlap
+	vector<ArrowBlock> batches = footer_blocks(bytes, 3);
+	CHECK_EQUAL((size_t)3, batches.size());
+	CHECK(footer_blocks(bytes, 2).empty());
+	size_t end_of_last = 8;
+	for (const ArrowBlock& block : batches) {
+		CHECK_EQUAL((size_t)0, (size_t)(block.offset % 8));
+		CHECK(block.offset >= end_of_last);
+		CHECK_EQUAL(-1, read_le<int>(bytes, (size_t)block.offset));
+		CHECK_EQUAL(block.metadata_length - 8, read_le<int>(bytes, (size_t)block.offset + 4));
+		end_of_last = (size_t)(block.offset + block.metadata_length + block.body_length);
+	}
+	// end of stream marker between the last batch and the footer
+	CHECK_EQUAL(-1, read_le<int>(bytes, end_of_last));
+	CHECK_EQUAL(0, read_le<int>(bytes, end_of_last + 4));
+	CHECK_EQUAL(end_of_last + 8, arrow_footer(bytes));
+	filesys::remove(arrow_file);
+}
+
+UNIT_TEST(arrow_dictionary_writes_each_string_once) {
+	wstring arrow_file = (filesys::temp_directory_path() / L"matTestTests_dictionary.arrow").wstring();
+	{
+		ArrowFileWriter writer(arrow_file);
+		int unit = writer.add_column(L"unit", ARROW_DICTIONARY);
+		for (const wchar_t* text : { L"mV", L"Volt", L"mV" }) {
+			writer.set_string(unit, text);
+			writer.end_row();
+		}
+		writer.write_batch();
+		for (const wchar_t* text : { L"mV", L"Ampere" }) {
+			writer.set_string(unit, text);
+			writer.end_row();
+		}
+		writer.write_batch();
+		// nothing new in the last batch, no dictionary batch for it
+		writer.set_string(unit, L"Volt");
+		writer.end_row();
+		CHECK(writer.close());
+	}
+	string bytes = read_file_bytes(arrow_file);
+	CHECK_EQUAL((size_t)1, count_substr(bytes, "mV"));
+	CHECK_EQUAL((size_t)1, count_substr(bytes, "Volt"));
+	CHECK_EQUAL((size_t)1, count_substr(bytes, "Ampere"));
+	CHECK_EQUAL((size_t)2, footer_blocks(bytes, 2).size());
+	CHECK_EQUAL((size_t)3, footer_blocks(bytes, 3).size());
+	filesys::remove(arrow_file);
+}
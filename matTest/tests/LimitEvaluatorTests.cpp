@@ -0,0 +1,104 @@
+#include "UnitTest.h"
+#include "../LimitEvaluator.h"
+#include <cmath>
+#include <limits>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+* LimitEvaluator: SSE2 compare against a scalar one, subset columns and summary objects
+*
+*************************************************************************************************************************************************************************/
+
+static const double NOT_SET = numeric_limits<double>::quiet_NaN();
+
+static LimitResult scalar_result(double value, double lower, double upper) {
+	if (std::isnan(value)) {
+		return LIMIT_INVALID;
+	}
+	bool pass = (std::isnan(lower) || value >= lower) && (std::isnan(upper) || value <= upper);
+	return pass ? LIMIT_PASS : LIMIT_FAIL;
+}
+
+UNIT_TEST(limit_evaluate_matches_scalar_compare) {
+	const double inf = numeric_limits<double>::infinity();
+	// limits themselves pass, odd count to reach the single value after the pairs
+	vector<double> values = { -1, 0, 0.5, 1, 1.0000001, NOT_SET, -inf, inf, 2, -0.0, NOT_SET };
+	const double limits[][2] = { { 0, 1 }, { NOT_SET, 1 }, { 0, NOT_SET }, { 1, 0 }, { 0.5, 0.5 } };
+	for (const double* limit : limits) {
+		for (size_t count : { values.size(), values.size() - 1, (size_t)1 }) {
+			vector<unsigned char> results(count);
+			LimitEvaluator::evaluate(values.data(), count, limit[0], limit[1], results.data());
+			for (size_t i = 0; i < count; i++) {
+				CHECK_EQUAL((int)scalar_result(values[i], limit[0], limit[1]), (int)results[i]);
+			}
+		}
+	}
+}
+
+UNIT_TEST(limit_column_skips_header_rows_and_text_is_invalid) {
+	SubsetTable table;
+	table.add_cell(L"header");
+	table.add_cell(L"voltage");
+	table.end_row(ROW_HEADER);
+	for (const wchar_t* cell : { L"0.5", L"1.5", L"NaN", L"abc" }) {
+		table.add_cell(L"1");
+		table.add_cell(cell);
+		table.end_row(ROW_VALUE);
+	}
+	table.add_cell(L"header");
+	table.end_row(ROW_HEADER);
+	// row without the column
+	table.add_cell(L"1");
+	table.end_row(ROW_VALUE);
+
+	LimitEvaluator evaluator;
+	evaluator.evaluate_column(table, 1, 1, 0, 1);
+	CHECK_EQUAL(LIMIT_NOT_CHECKED, evaluator.result(0, 1));
+	CHECK_EQUAL(LIMIT_PASS, evaluator.result(1, 1));
+	CHECK_EQUAL(LIMIT_FAIL, evaluator.result(2, 1));
+	CHECK_EQUAL(LIMIT_INVALID, evaluator.result(3, 1));
+	CHECK_EQUAL(LIMIT_INVALID, evaluator.result(4, 1));
+	CHECK_EQUAL(LIMIT_INVALID, evaluator.result(5, 1));
+	CHECK_EQUAL(LIMIT_INVALID, evaluator.result(6, 1));
+	CHECK_EQUAL(LIMIT_NOT_CHECKED, evaluator.result(7, 1));
+	// a column without limits isn't evaluated
+	evaluator.evaluate_column(table, 1, 0, NOT_SET, NOT_SET);
+	CHECK_EQUAL(LIMIT_NOT_CHECKED, evaluator.result(1, 0));
+}
+
+UNIT_TEST(limit_summary_counts_results_and_keeps_first_fail) {
+	LimitEvaluator evaluator;
+	evaluator.record(L"voltage", L"2001", LIMIT_PASS, L"tambient=25", L"1");
+	evaluator.record(L"voltage", L"2001", LIMIT_FAIL, L"tambient=125", L"2");
+	evaluator.record(L"voltage", L"2001", LIMIT_FAIL, L"tambient=-40", L"3");
+	evaluator.record(L"current", L"2002", LIMIT_INVALID, L"tambient=25", L"1");
+	evaluator.record(L"current", L"2002", LIMIT_NOT_CHECKED, L"tambient=25", L"2");
+	CHECK_EQUAL(2ULL, evaluator.failed_values());
+
+	vector<DataObject> objects;
+	shared_ptr<const MetaTemplate> summary_template = make_shared<MetaTemplate>();
+	evaluator.append_summary_objects(objects, summary_template, L"subset_1");
+	CHECK_EQUAL((size_t)2, objects.size());
+	// sorted by test name
+	CHECK(*objects[0].find_meta(META_PARAMETER_NAME) == L"current");
+	CHECK(*objects[1].find_meta(META_PARAMETER_NAME) == L"voltage");
+	CHECK(*objects[1].find_meta(META_TEST_NUMBER) == L"2001");
+	CHECK(*objects[1].find_meta(META_SUBSET_ID) == L"subset_1");
+
+	const vector<pair<wstring, wstring>>& current = objects[0].payload_fields();
+	const vector<pair<wstring, wstring>> expected_current = { { L"fail_count", L"0" }, { L"invalid_count", L"1" }, { L"pass_count", L"0" } };
+	CHECK(current == expected_current);
+	const vector<pair<wstring, wstring>>& voltage = objects[1].payload_fields();
+	const vector<pair<wstring, wstring>> expected_voltage = { { L"fail_count", L"2" }, { L"first_fail_conditions", L"tambient=125" },
+		{ L"first_fail_idx", L"2" }, { L"invalid_count", L"0" }, { L"pass_count", L"1" } };
+	CHECK(voltage == expected_voltage);
+
+	// results are cleared with the summary
+	CHECK_EQUAL(0ULL, evaluator.failed_values());
+	objects.clear();
+	evaluator.append_summary_objects(objects, summary_template, L"subset_2");
+	CHECK(objects.empty());
+}
@@ -0,0 +1,110 @@
+#include "UnitTest.h"
+#include "../ObjectSpillStore.h"
+#include <experimental\filesystem>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+* ObjectSpillStore: sorted runs on disk merged with the objects in memory give the same objects as the in memory map
+*
+*************************************************************************************************************************************************************************/
+
+namespace filesys = std::experimental::filesystem;
+
+static wstring spill_test_prefix(const wstring& name) {
+	return (filesys::temp_directory_path() / (L"matTestTests_" + name)).wstring();
+}
+
+static DataObject value_object(const shared_ptr<const MetaTemplate>& row_template, const wstring& idx, const wstring& value) {
+	DataObject object;
+	object.set_template(row_template);
+	object.set_meta(META_IDX, idx);
+	object.set_payload(L"ibat", value);
+	object.add_link(LINK_PNG, L"C:\\raw\\" + idx + L".png");
+	object.add_comment(L"comment " + idx);
+	return object;
+}
+
+UNIT_TEST(spill_store_without_budget_returns_objects_in_key_order) {
+	shared_ptr<const MetaTemplate> subset_template = MetaTemplate::derive(NULL);
+	ObjectSpillStore store(0, spill_test_prefix(L"no_budget"), subset_template);
+	store.put(L"c", value_object(subset_template, L"3", L"0.3"));
+	store.put(L"a", value_object(subset_template, L"1", L"0.1"));
+	store.put(L"b", value_object(subset_template, L"2", L"0.2"));
+	DataObject object;
+	vector<wstring> values;
+	while (store.next(object)) {
+		values.push_back(object.payload_fields()[0].second);
+	}
+	CHECK(values == (vector<wstring>{ L"0.1", L"0.2", L"0.3" }));
+	CHECK(!store.spilled());
+}
+
+UNIT_TEST(spill_store_merges_runs_and_keeps_last_object_of_a_key) {
+	shared_ptr<MetaTemplate> subset_template = MetaTemplate::derive(NULL);
+	subset_template->set_meta(META_SUBSET_ID, L"subset_1");
+	// a budget of one byte writes a run for every object
+	ObjectSpillStore store(1, spill_test_prefix(L"runs"), subset_template);
+	const int object_count = 50;
+	for (int i = 0; i < object_count; i++) {
+		shared_ptr<MetaTemplate> row_template = MetaTemplate::derive(subset_template);
+		row_template->set_meta(L"cond_tambient", to_wstring(i % 3));
+		// keys in reverse order, every tenth key stored again later
+		wstring key = L"key_" + to_wstring(1000 - i);
+		store.put(key, value_object(row_template, to_wstring(i), L"first"));
+		if (i % 10 == 0) {
+			store.put(L"key_" + to_wstring(1000 - i / 2), value_object(row_template, to_wstring(i), L"again"));
+		}
+	}
+	CHECK(store.spilled());
+	CHECK(store.run_count() > 1);
+
+	DataObject object;
+	wstring last_idx;
+	int count = 0;
+	int replaced = 0;
+	while (store.next(object)) {
+		count++;
+		// the subset template is attached again, the row template is written into the object
+		CHECK(object.meta_template().get() == subset_template.get());
+		CHECK(object.find_meta(META_SUBSET_ID) != NULL && *object.find_meta(META_SUBSET_ID) == L"subset_1");
+		CHECK_EQUAL(1u, object.links().size());
+		CHECK_EQUAL(1u, object.comments().size());
+		bool has_condition = false;
+		object.for_each_meta([&](const wchar_t* key, const wstring&) {
+			has_condition = has_condition || wstring(key) == L"cond_tambient";
+		});
+		CHECK(has_condition);
+		if (object.payload_fields()[0].second == L"again") {
+			replaced++;
+		}
+	}
+	CHECK_EQUAL(object_count, count);
+	CHECK_EQUAL(5, replaced);
+	// the runs are removed once all objects are returned
+	for (size_t run = 0; run < store.run_count(); run++) {
+		CHECK(!filesys::exists(spill_test_prefix(L"runs") + L"_" + to_wstring(run) + L".spill"));
+	}
+}
+
+UNIT_TEST(spill_store_returns_same_order_with_and_without_budget) {
+	shared_ptr<const MetaTemplate> subset_template = MetaTemplate::derive(NULL);
+	ObjectSpillStore in_memory(0, spill_test_prefix(L"memory"), subset_template);
+	ObjectSpillStore spilling(256, spill_test_prefix(L"spilling"), subset_template);
+	for (int i = 0; i < 200; i++) {
+		wstring key = to_wstring((i * 7919) % 211);
+		in_memory.put(key, value_object(subset_template, to_wstring(i), to_wstring(i)));
+		spilling.put(key, value_object(subset_template, to_wstring(i), to_wstring(i)));
+	}
+	CHECK(spilling.spilled());
+	DataObject expected;
+	DataObject actual;
+	while (in_memory.next(expected)) {
+		CHECK(spilling.next(actual));
+		CHECK(expected.payload_fields() == actual.payload_fields());
+		CHECK(*expected.find_meta(META_IDX) == *actual.find_meta(META_IDX));
+	}
+	CHECK(!spilling.next(actual));
+}
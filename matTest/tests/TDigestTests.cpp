@@ -0,0 +1,91 @@
+#include "UnitTest.h"
+#include "../TDigest.h"
+#include <cmath>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+* TDigest: quantiles against the exact ones, merging and the text format
+*
+*************************************************************************************************************************************************************************/
+
+static const int VALUE_COUNT = 100000;
+
+// 0 .. VALUE_COUNT - 1 in a fixed shuffled order, the exact quantile q is q * (VALUE_COUNT - 1)
+static double value_rank(double value) {
+	return value / (VALUE_COUNT - 1);
+}
+
+static vector<double> shuffled_values() {
+	vector<double> values;
+	unsigned int step = 7919;
+	for (int i = 0; i < VALUE_COUNT; i++) {
+		values.push_back((double)((i * step) % VALUE_COUNT));
+	}
+	return values;
+}
+
+UNIT_TEST(tdigest_quantiles_stay_close_to_exact_ranks) {
+	vector<double> values = shuffled_values();
+	TDigest digest;
+	digest.add(values.data(), values.size());
+	CHECK_CLOSE((double)VALUE_COUNT, digest.count(), 0);
+	CHECK_CLOSE(0, digest.quantile(0), 0);
+	CHECK_CLOSE(VALUE_COUNT - 1, digest.quantile(1), 0);
+	// P0.1 and P99.9 within 1e-4 of their rank, see TDIGEST_COMPRESSION
+	for (double q : { 0.001, 0.999 }) {
+		CHECK_CLOSE(q, value_rank(digest.quantile(q)), 1e-4);
+	}
+	for (double q : { 0.01, 0.1, 0.5, 0.9, 0.99 }) {
+		CHECK_CLOSE(q, value_rank(digest.quantile(q)), 1e-3);
+	}
+}
+
+UNIT_TEST(tdigest_merged_sketches_match_one_sketch) {
+	vector<double> values = shuffled_values();
+	TDigest all;
+	all.add(values.data(), values.size());
+	TDigest merged;
+	for (int part = 0; part < 4; part++) {
+		TDigest part_digest;
+		for (int i = part; i < VALUE_COUNT; i += 4) {
+			part_digest.add(values[i]);
+		}
+		merged.merge(part_digest);
+	}
+	CHECK_CLOSE(all.count(), merged.count(), 0);
+	CHECK_CLOSE(all.quantile(0), merged.quantile(0), 0);
+	CHECK_CLOSE(all.quantile(1), merged.quantile(1), 0);
+	for (double q : { 0.001, 0.5, 0.999 }) {
+		CHECK_CLOSE(value_rank(all.quantile(q)), value_rank(merged.quantile(q)), 1e-3);
+	}
+}
+
+UNIT_TEST(tdigest_text_reads_back_the_same_sketch) {
+	vector<double> values = shuffled_values();
+	TDigest digest;
+	digest.add(values.data(), values.size());
+	wstring text = digest.to_string();
+	TDigest parsed;
+	CHECK(TDigest::parse(text, parsed));
+	CHECK(parsed.to_string() == text);
+	// centroid means are written with 10 digits, min and max exactly
+	CHECK_CLOSE(digest.quantile(0), parsed.quantile(0), 0);
+	CHECK_CLOSE(digest.quantile(1), parsed.quantile(1), 0);
+	for (double q : { 0.001, 0.5, 0.999 }) {
+		CHECK_CLOSE(digest.quantile(q), parsed.quantile(q), 1e-9);
+	}
+	CHECK(!TDigest::parse(L"200;1;abc", parsed));
+}
+
+UNIT_TEST(tdigest_empty_sketch_has_no_quantiles) {
+	TDigest digest;
+	CHECK(std::isnan(digest.quantile(0.5)));
+	CHECK_CLOSE(0, digest.count(), 0);
+	digest.add(1.25);
+	CHECK_CLOSE(1.25, digest.quantile(0), 0);
+	CHECK_CLOSE(1.25, digest.quantile(0.5), 0);
+	CHECK_CLOSE(1.25, digest.quantile(1), 0);
+}
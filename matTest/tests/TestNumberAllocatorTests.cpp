@@ -0,0 +1,56 @@
+#include "UnitTest.h"
+#include "../TestNumberAllocator.h"
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+* TestNumberAllocator: numbering of new parameters with and without limits catalog
+*
+*************************************************************************************************************************************************************************/
+
+// counter of the first parameter and after each following one, like Converter numbers new parameters
+static vector<int> numbering(TestNumberAllocator& test_numbers, int parameter_count) {
+	vector<int> numbers;
+	numbers.push_back(test_numbers.skip_catalog());
+	for (int i = 1; i < parameter_count; i++) {
+		numbers.push_back(test_numbers.advance());
+	}
+	return numbers;
+}
+
+UNIT_TEST(test_numbers_skip_taken_numbers) {
+	TestNumberAllocator test_numbers;
+	CHECK_EQUAL(1, test_numbers.take());
+	test_numbers.reserve(3);
+	CHECK(test_numbers.is_used(1));
+	CHECK(!test_numbers.is_used(2));
+	CHECK(test_numbers.is_used(3));
+	CHECK(!test_numbers.is_used(-1));
+	CHECK_EQUAL(2, test_numbers.current());
+	CHECK_EQUAL(3, test_numbers.advance());
+	CHECK_EQUAL(5, test_numbers.advance());
+}
+
+UNIT_TEST(test_numbers_catalog_only_steps_over_its_numbers) {
+	TestNumberAllocator plain;
+	TestNumberAllocator with_catalog;
+	with_catalog.reserve_catalog(4);
+	with_catalog.reserve_catalog(5);
+	vector<int> plain_numbers = numbering(plain, 6);
+	vector<int> catalog_numbers = numbering(with_catalog, 6);
+	const vector<int> expected_plain = { 1, 2, 3, 4, 5, 6 };
+	CHECK(plain_numbers == expected_plain);
+	// the catalog numbers are stepped over, nothing else moves
+	const vector<int> expected_catalog = { 1, 2, 3, 6, 7, 8 };
+	CHECK(catalog_numbers == expected_catalog);
+}
+
+UNIT_TEST(test_numbers_first_parameter_skips_catalog) {
+	TestNumberAllocator test_numbers;
+	test_numbers.reserve_catalog(1);
+	test_numbers.reserve_catalog(2);
+	CHECK_EQUAL(3, test_numbers.skip_catalog());
+	CHECK(!test_numbers.is_used(1));
+}
@@ -0,0 +1,94 @@
+#include "UnitTest.h"
+#include "../UnitScaling.h"
+#include <cwchar>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+* UnitScaling: unit prefixes, exact decimal scaling of limits and the shared number parser and formatter
+*
+*************************************************************************************************************************************************************************/
+
+UNIT_TEST(unit_scaling_splits_prefix_of_known_units) {
+	UnitScaling unit_scaling;
+	CHECK(unit_scaling.get_unit_scale(L"mV") == make_tuple(3, wstring(L"V")));
+	CHECK(unit_scaling.get_unit_scale(L"[mA]") == make_tuple(3, wstring(L"A")));
+	CHECK(unit_scaling.get_unit_scale(L"kOhm") == make_tuple(-3, wstring(L"Ohm")));
+	CHECK(unit_scaling.get_unit_scale(L"mm") == make_tuple(3, wstring(L"m")));
+	CHECK(unit_scaling.get_unit_scale(L"V") == make_tuple(0, wstring(L"V")));
+}
+
+UNIT_TEST(unit_scaling_keeps_units_starting_with_prefix_symbol) {
+	UnitScaling unit_scaling;
+	CHECK(unit_scaling.get_unit_scale(L"m") == make_tuple(0, wstring(L"m")));
+	CHECK(unit_scaling.get_unit_scale(L"min") == make_tuple(0, wstring(L"min")));
+	CHECK(unit_scaling.get_unit_scale(L"ppm") == make_tuple(0, wstring(L"ppm")));
+	CHECK(unit_scaling.get_unit_scale(L"T") == make_tuple(0, wstring(L"T")));
+}
+
+UNIT_TEST(unit_scaling_scales_values_without_rounding) {
+	UnitScaling unit_scaling;
+	// 1.2 * 10^-3 is 0.0012000000000000001 in double
+	CHECK(unit_scaling.scale_value(3, L"1.2") == L"0.0012");
+	CHECK(unit_scaling.scale_value(-3, L"0.0012") == L"1.2");
+	CHECK(unit_scaling.scale_value(6, L"3300") == L"0.0033");
+	CHECK(unit_scaling.scale_value(3, L"-0.1") == L"-0.0001");
+	CHECK(unit_scaling.scale_value(0, L"12345678901234567") == L"12345678901234567");
+}
+
+UNIT_TEST(unit_scaling_formats_like_stream_output) {
+	UnitScaling unit_scaling;
+	CHECK(unit_scaling.scale_value(12, L"1.5") == L"1.5e-12");
+	CHECK(unit_scaling.scale_value(-9, L"2") == L"2e+09");
+	CHECK(unit_scaling.scale_value(3, L"0") == L"0");
+	CHECK(unit_scaling.scale_value(0, L"100000") == L"100000");
+}
+
+UNIT_TEST(unit_scaling_leaves_empty_and_nan_limits_empty) {
+	UnitScaling unit_scaling;
+	CHECK(unit_scaling.scale_value(3, L"") == L"");
+	CHECK(unit_scaling.scale_value(3, L"NaN") == L"");
+	vector<wstring> scaled = unit_scaling.scale_column(vector<wstring>{ L"1", L"", L"NaN", L"5" }, vector<int>{ 3, 3, 3 });
+	CHECK(scaled == (vector<wstring>{ L"0.001", L"", L"", L"5" }));
+}
+
+UNIT_TEST(unit_scaling_parses_decimal_comma) {
+	UnitScaling unit_scaling;
+	DecimalValue decimal = unit_scaling.parse_decimal(L"0,5");
+	CHECK(decimal.valid);
+	CHECK_EQUAL(5u, decimal.mantissa);
+	CHECK_EQUAL(-1, decimal.exponent);
+	CHECK(!unit_scaling.parse_decimal(L"5 mV").valid);
+}
+
+UNIT_TEST(parse_double_takes_only_whole_numbers) {
+	double value = 0;
+	CHECK(UnitScaling::parse_double(wstring(L"-1.25e-3"), &value));
+	CHECK_EQUAL(-1.25e-3, value);
+	CHECK(!UnitScaling::parse_double(wstring(L""), &value));
+	CHECK(!UnitScaling::parse_double(wstring(L"1.5V"), &value));
+	CHECK(UnitScaling::parse_double(wstring(L"NaN"), &value));
+	CHECK(std::isnan(value));
+}
+
+UNIT_TEST(parse_double_reads_cells_which_are_not_terminated) {
+	const wchar_t* row = L"12.5,7";
+	double value = 0;
+	CHECK(UnitScaling::parse_double(row, 4, &value));
+	CHECK_EQUAL(12.5, value);
+	// longer than the buffer on the stack
+	wstring long_number = wstring(80, L'0') + L"42";
+	CHECK(UnitScaling::parse_double(long_number.c_str(), long_number.size(), &value));
+	CHECK_EQUAL(42.0, value);
+}
+
+UNIT_TEST(format_double_is_shortest_round_trip) {
+	CHECK(UnitScaling::format_double(0.1) == L"0.1");
+	CHECK(UnitScaling::format_double(1e-12) == L"1e-12");
+	for (double value : { 1.0 / 3, 2.0 / 3, 0.1 + 0.2, 1e300 / 7, -5e-324 }) {
+		CHECK_EQUAL(value, wcstod(UnitScaling::format_double(value).c_str(), NULL));
+	}
+	CHECK(UnitScaling::format_double(0.1 + 0.2) == L"0.30000000000000004");
+}
@@ -0,0 +1,40 @@
+#include "UnitTest.h"
+#include <iostream>
+#include <exception>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+*************************************************************************************************************************************************************************/
+
+vector<UnitTestCase>& unit_tests() {
+	// created on first use, tests of other files register during static initialisation
+	static vector<UnitTestCase> tests;
+	return tests;
+}
+
+// matTestTests [name]: runs all tests or the ones whose name contains name, exit code is the number of failed tests
+int main(int argc, char *argv[])
+{
+	string filter = argc > 1 ? argv[1] : "";
+	int run_count = 0;
+	int failed_count = 0;
+	for (const UnitTestCase& test_case : unit_tests()) {
+		if (string(test_case.name).find(filter) == string::npos) {
+			continue;
+		}
+		run_count++;
+		try {
+			test_case.run();
+			cout << "ok      " << test_case.name << endl;
+		}
+		catch (const exception& e) {
+			failed_count++;
+			cout << "FAILED  " << test_case.name << ": " << e.what() << endl;
+		}
+	}
+	cout << run_count - failed_count << " of " << run_count << " tests passed" << endl;
+	return failed_count;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <stdexcept>
+#include <cmath>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+* Minimal test registry of matTestTests: every UNIT_TEST registers itself, the runner in UnitTest.cpp runs all of them
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+struct UnitTestCase {
+	const char* name;
+	void (*run)();
+};
+
+// all tests of the executable in order of registration
+vector<UnitTestCase>& unit_tests();
+
+struct UnitTestRegistration {
+	UnitTestRegistration(const char* name, void (*run)()) {
+		UnitTestCase test_case = { name, run };
+		unit_tests().push_back(test_case);
+	}
+};
+
+// a failed check ends its test, the runner reports file, line and the check
+inline void unit_test_fail(const char* file, int line, const string& message) {
+	ostringstream failure;
+	failure << file << "(" << line << "): " << message;
+	throw runtime_error(failure.str());
+}
+
+#define UNIT_TEST(name) \
+	static void name(); \
+	static UnitTestRegistration name##_registration(#name, name); \
+	static void name()
+
+#define CHECK(condition) \
+	do { if (!(condition)) unit_test_fail(__FILE__, __LINE__, #condition); } while (0)
+
+#define CHECK_EQUAL(expected, actual) \
+	do { if (!((expected) == (actual))) unit_test_fail(__FILE__, __LINE__, "CHECK_EQUAL(" #expected ", " #actual ")"); } while (0)
+
+// relative tolerance, for results of floating point sums
+#define CHECK_CLOSE(expected, actual, tolerance) \
+	do { if (!(fabs((expected) - (actual)) <= (tolerance) * (fabs(expected) > 1 ? fabs(expected) : 1))) unit_test_fail(__FILE__, __LINE__, "CHECK_CLOSE(" #expected ", " #actual ")"); } while (0)
@@ -0,0 +1,85 @@
+#include "UnitTest.h"
+#include "ZipTestReader.h"
+#include "../XlsxWriter.h"
+#include <cwchar>
+#include <experimental\filesystem>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+* XlsxWriter: parts of the workbook, number and text cells, sheet names
+*
+*************************************************************************************************************************************************************************/
+
+namespace filesys = std::experimental::filesystem;
+
+static void add_cells(XlsxWriter& workbook, const vector<wstring>& cells) {
+	for (const wstring& cell : cells) {
+		workbook.add_cell(cell.c_str(), cell.size());
+	}
+	workbook.end_row();
+}
+
+static const string& workbook_part(const vector<pair<string, string>>& parts, const string& name) {
+	for (const pair<string, string>& part : parts) {
+		if (part.first == name) {
+			return part.second;
+		}
+	}
+	throw runtime_error("workbook has no part " + name);
+}
+
+UNIT_TEST(xlsx_writes_numbers_as_numbers_and_everything_else_as_text) {
+	wstring xlsx_file = (filesys::temp_directory_path() / L"matTestTests_cells.xlsx").wstring();
+	{
+		XlsxWriter workbook(xlsx_file);
+		CHECK(workbook.is_open());
+		workbook.begin_sheet(L"subset", 1);
+		add_cells(workbook, { L"1.5", L"NaN", L"abc", L"1e5", L"-0.25", L"0x10", L" 5", L"inf", L"" });
+		CHECK(workbook.close());
+	}
+	vector<pair<string, string>> parts = read_zip_entries(xlsx_file);
+	const string& sheet = workbook_part(parts, "xl/worksheets/sheet1.xml");
+	CHECK(sheet.find("<c r=\"A1\"><v>1.5</v></c>") != string::npos);
+	CHECK(sheet.find("<c r=\"D1\"><v>1e5</v></c>") != string::npos);
+	CHECK(sheet.find("<c r=\"E1\"><v>-0.25</v></c>") != string::npos);
+	// NaN, inf, hex and numbers with blanks are texts, Excel would take them differently
+	for (const char* text_cell : { "B1", "C1", "F1", "G1", "H1" }) {
+		CHECK(sheet.find("<c r=\"" + string(text_cell) + "\" t=\"s\">") != string::npos);
+	}
+	// empty cells are left out
+	CHECK(sheet.find("I1") == string::npos);
+	const string& shared_strings = workbook_part(parts, "xl/sharedStrings.xml");
+	CHECK(shared_strings.find("<t xml:space=\"preserve\">NaN</t>") != string::npos);
+	CHECK(shared_strings.find("<t xml:space=\"preserve\"> 5</t>") != string::npos);
+	workbook_part(parts, "[Content_Types].xml");
+	workbook_part(parts, "_rels/.rels");
+	workbook_part(parts, "xl/_rels/workbook.xml.rels");
+	workbook_part(parts, "xl/styles.xml");
+	filesys::remove(xlsx_file);
+}
+
+UNIT_TEST(xlsx_replaces_chars_and_makes_sheet_names_unique) {
+	wstring xlsx_file = (filesys::temp_directory_path() / L"matTestTests_sheets.xlsx").wstring();
+	{
+		XlsxWriter workbook(xlsx_file);
+		workbook.begin_sheet(L"sub:1", 1);
+		workbook.add_text(L"shared");
+		workbook.end_row();
+		workbook.begin_sheet(L"sub:1", 1);
+		workbook.add_text(L"shared");
+		workbook.end_row();
+		CHECK_EQUAL(2, workbook.sheet_count());
+		CHECK(workbook.close());
+	}
+	vector<pair<string, string>> parts = read_zip_entries(xlsx_file);
+	const string& workbook_xml = workbook_part(parts, "xl/workbook.xml");
+	CHECK(workbook_xml.find("<sheet name=\"sub_1\" sheetId=\"1\" r:id=\"rId1\"/>") != string::npos);
+	CHECK(workbook_xml.find("<sheet name=\"sub_1 (2)\" sheetId=\"2\" r:id=\"rId2\"/>") != string::npos);
+	// the text is stored once and used in both sheets
+	CHECK(workbook_part(parts, "xl/sharedStrings.xml").find("count=\"2\" uniqueCount=\"1\"") != string::npos);
+	CHECK(workbook_part(parts, "xl/worksheets/sheet2.xml").find("<c r=\"A1\" t=\"s\"><v>0</v></c>") != string::npos);
+	filesys::remove(xlsx_file);
+}
@@ -0,0 +1,115 @@
+#include "UnitTest.h"
+#include "ZipTestReader.h"
+#include "../ZipStreamWriter.h"
+#include <experimental\filesystem>
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+* ZipStreamWriter: archive layout and deflate output, read back with the reference reader of ZipTestReader.h
+*
+*************************************************************************************************************************************************************************/
+
+namespace filesys = std::experimental::filesystem;
+
+static wstring zip_test_file(const wstring& name) {
+	return (filesys::temp_directory_path() / (L"matTestTests_" + name + L".zip")).wstring();
+}
+
+// rows like the sheet XML of a workbook, repeated tags with changing numbers
+static string sheet_like_xml(int rows) {
+	string xml;
+	for (int row = 1; row <= rows; row++) {
+		xml += "<row r=\"" + to_string(row) + "\"><c r=\"A" + to_string(row) + "\"><v>" + to_string(row * 0.001) + "</v></c><c r=\"B" + to_string(row) +
+			"\" t=\"s\"><v>" + to_string(row % 17) + "</v></c></row>";
+	}
+	return xml;
+}
+
+// bytes without repetitions, every byte value occurs (literals with 8 and 9 bit codes)
+static string noise(size_t size) {
+	string data(size, '\0');
+	unsigned int state = 12345;
+	for (size_t i = 0; i < size; i++) {
+		state = state * 1103515245 + 12345;
+		data[i] = (char)(state >> 16);
+	}
+	return data;
+}
+
+UNIT_TEST(zip_entries_read_back_unchanged) {
+	wstring zip_file = zip_test_file(L"entries");
+	string xml = sheet_like_xml(20000);
+	string binary = noise(100000);
+	{
+		ZipStreamWriter zip(zip_file);
+		CHECK(zip.is_open());
+		zip.begin_entry("xl/worksheets/sheet1.xml");
+		// written in pieces of different sizes, blocks don't follow the writes
+		for (size_t pos = 0; pos < xml.size(); pos += 777) {
+			zip.write(xml.substr(pos, 777));
+		}
+		zip.end_entry();
+		zip.begin_entry("empty.xml");
+		zip.end_entry();
+		zip.begin_entry("binary.bin");
+		zip.write(binary.data(), binary.size());
+		zip.end_entry();
+		CHECK(zip.close());
+		CHECK_EQUAL((unsigned long long)(xml.size() + binary.size()), zip.total_bytes());
+		// the sheet XML takes only a small part of its size
+		CHECK(zip.total_compressed_bytes() < xml.size() / 4 + binary.size() * 2);
+	}
+	vector<pair<string, string>> entries = read_zip_entries(zip_file);
+	CHECK_EQUAL(3u, entries.size());
+	CHECK(entries[0].first == "xl/worksheets/sheet1.xml");
+	CHECK(entries[0].second == xml);
+	CHECK(entries[1].first == "empty.xml");
+	CHECK(entries[1].second.empty());
+	CHECK(entries[2].first == "binary.bin");
+	CHECK(entries[2].second == binary);
+	filesys::remove(zip_file);
+}
+
+UNIT_TEST(zip_deflate_matches_across_blocks_and_at_window_end) {
+	wstring zip_file = zip_test_file(L"window");
+	// a random part repeated at the largest distance of the window and at once, the longest matches and overlapping copies
+	string part = noise(32768 - 300);
+	string data = part + string(300, 'x') + part + string(5000, 'a') + noise(70000) + part.substr(0, 4000) + string(1, 'z');
+	{
+		ZipStreamWriter zip(zip_file);
+		zip.begin_entry("window.bin");
+		zip.write(data);
+		zip.end_entry();
+		CHECK(zip.close());
+		// the repeated part is found
+		CHECK(zip.total_compressed_bytes() < data.size());
+	}
+	vector<pair<string, string>> entries = read_zip_entries(zip_file);
+	CHECK_EQUAL(1u, entries.size());
+	CHECK(entries[0].second == data);
+	filesys::remove(zip_file);
+}
+
+UNIT_TEST(zip_second_entry_doesnt_refer_to_first) {
+	wstring zip_file = zip_test_file(L"reset");
+	string xml = sheet_like_xml(100);
+	{
+		ZipStreamWriter zip(zip_file);
+		zip.begin_entry("first.xml");
+		zip.write(xml);
+		zip.end_entry();
+		// the same text again must be encoded without matches into the first entry
+		zip.begin_entry("second.xml");
+		zip.write(xml);
+		zip.end_entry();
+		CHECK(zip.close());
+	}
+	vector<pair<string, string>> entries = read_zip_entries(zip_file);
+	CHECK_EQUAL(2u, entries.size());
+	CHECK(entries[0].second == xml);
+	CHECK(entries[1].second == xml);
+	filesys::remove(zip_file);
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+
+/*************************************************************************************************************************************************************************
+* maintainer Xing Jin (IFAG ATV PS PD MUC CVSV)
+*
+* date		19.10.2026
+*
+* Reference reader for the archives of ZipStreamWriter: central directory, local headers, data descriptors, CRC and an inflater for
+* stored and fixed code blocks (the only ones the writer produces). Kept apart from the writer so a mistake isn't made twice.
+*
+*************************************************************************************************************************************************************************/
+
+using namespace std;
+
+class InflateReader
+{
+
+public:
+	InflateReader(const string& data) : data(data), pos(0), bit_buffer(0), bit_count(0) {}
+
+	string inflate() {
+		string out;
+		bool final = false;
+		while (!final) {
+			final = read_bits(1) == 1;
+			unsigned int type = read_bits(2);
+			if (type == 0) {
+				// stored block starts on a byte
+				this->bit_buffer = 0;
+				this->bit_count = 0;
+				unsigned int length = read_byte() | (read_byte() << 8);
+				unsigned int check = read_byte() | (read_byte() << 8);
+				if ((length ^ 0xFFFF) != check) {
+					throw runtime_error("stored block length doesn't match its complement");
+				}
+				for (unsigned int i = 0; i < length; i++) {
+					out += (char)read_byte();
+				}
+			}
+			else if (type == 1) {
+				inflate_fixed(out);
+			}
+			else {
+				throw runtime_error("block type not written by ZipStreamWriter");
+			}
+		}
+		return out;
+	}
+
+private:
+	unsigned int read_byte() {
+		if (this->pos >= this->data.size()) {
+			throw runtime_error("deflate data ends early");
+		}
+		return (unsigned char)this->data[this->pos++];
+	}
+
+	unsigned int read_bits(int count) {
+		while (this->bit_count < count) {
+			this->bit_buffer |= read_byte() << this->bit_count;
+			this->bit_count += 8;
+		}
+		unsigned int bits = this->bit_buffer & ((1u << count) - 1);
+		this->bit_buffer >>= count;
+		this->bit_count -= count;
+		return bits;
+	}
+
+	// Huffman codes start with the most significant bit
+	unsigned int read_code(int length) {
+		unsigned int code = 0;
+		for (int i = 0; i < length; i++) {
+			code = (code << 1) | read_bits(1);
+		}
+		return code;
+	}
+
+	int read_fixed_symbol() {
+		unsigned int code = read_code(7);
+		if (code <= 23) {
+			return 256 + code;
+		}
+		code = (code << 1) | read_bits(1);
+		if (code >= 0x30 && code <= 0xBF) {
+			return code - 0x30;
+		}
+		if (code >= 0xC0 && code <= 0xC7) {
+			return 280 + code - 0xC0;
+		}
+		code = (code << 1) | read_bits(1);
+		if (code >= 0x190 && code <= 0x1FF) {
+			return 144 + code - 0x190;
+		}
+		throw runtime_error("invalid fixed code");
+	}
+
+	void inflate_fixed(string& out) {
+		static const int length_base[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+		static const int length_extra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+		static const int distance_base[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+			8193, 12289, 16385, 24577 };
+		static const int distance_extra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+		while (true) {
+			int symbol = read_fixed_symbol();
+			if (symbol < 256) {
+				out += (char)symbol;
+				continue;
+			}
+			if (symbol == 256) {
+				return;
+			}
+			if (symbol > 285) {
+				throw runtime_error("invalid length symbol");
+			}
+			int length = length_base[symbol - 257] + read_bits(length_extra[symbol - 257]);
+			unsigned int distance_code = read_code(5);
+			if (distance_code >= 30) {
+				throw runtime_error("invalid distance code");
+			}
+			size_t distance = distance_base[distance_code] + read_bits(distance_extra[distance_code]);
+			if (distance > out.size() || distance > 32768) {
+				throw runtime_error("distance beyond the window");
+			}
+			// copies byte by byte, a match may overlap itself
+			size_t from = out.size() - distance;
+			for (int i = 0; i < length; i++) {
+				out += out[from + i];
+			}
+		}
+	}
+
+	const string& data;
+	size_t pos;
+	unsigned int bit_buffer;
+	int bit_count;
+};
+
+inline unsigned int zip_test_crc32(const string& data) {
+	unsigned int crc = 0xFFFFFFFFu;
+	for (unsigned char c : data) {
+		crc ^= c;
+		for (int bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+		}
+	}
+	return ~crc;
+}
+
+inline unsigned int zip_test_16(const string& data, size_t pos) {
+	if (pos + 2 > data.size()) {
+		throw runtime_error("archive ends early");
+	}
+	return (unsigned char)data[pos] | ((unsigned char)data[pos + 1] << 8);
+}
+
+inline unsigned int zip_test_32(const string& data, size_t pos) {
+	return zip_test_16(data, pos) | (zip_test_16(data, pos + 2) << 16);
+}
+
+/*************************************************************************************************************************************************************************
+* This function reads all entries of an archive and checks its structure, it throws runtime_error for anything that doesn't fit
+*
+* Input:
+*		zip_file			wstring				archive written by ZipStreamWriter
+* Output:
+*		entries				vector<pair>		name and inflated data of each entry in order of the central directory
+*
+*************************************************************************************************************************************************************************/
+inline vector<pair<string, string>> read_zip_entries(const wstring& zip_file) {
+	ifstream zip_in(zip_file, ios::binary);
+	string archive((istreambuf_iterator<char>(zip_in)), istreambuf_iterator<char>());
+	// no archive comment, the end record is the last 22 bytes
+	if (archive.size() < 22 || zip_test_32(archive, archive.size() - 22) != 0x06054b50) {
+		throw runtime_error("no end of central directory record");
+	}
+	size_t end_record = archive.size() - 22;
+	unsigned int entry_count = zip_test_16(archive, end_record + 10);
+	size_t directory_size = zip_test_32(archive, end_record + 12);
+	size_t directory = zip_test_32(archive, end_record + 16);
+	if (directory + directory_size != end_record) {
+		throw runtime_error("central directory doesn't end at the end record");
+	}
+	vector<pair<string, string>> entries;
+	size_t pos = directory;
+	for (unsigned int i = 0; i < entry_count; i++) {
+		if (zip_test_32(archive, pos) != 0x02014b50) {
+			throw runtime_error("bad central directory entry");
+		}
+		unsigned int method = zip_test_16(archive, pos + 10);
+		unsigned int crc = zip_test_32(archive, pos + 16);
+		size_t compressed_size = zip_test_32(archive, pos + 20);
+		size_t size = zip_test_32(archive, pos + 24);
+		size_t name_length = zip_test_16(archive, pos + 28);
+		size_t extra_length = zip_test_16(archive, pos + 30);
+		size_t comment_length = zip_test_16(archive, pos + 32);
+		size_t offset = zip_test_32(archive, pos + 42);
+		string name = archive.substr(pos + 46, name_length);
+		pos += 46 + name_length + extra_length + comment_length;
+
+		if (method != 8 || zip_test_32(archive, offset) != 0x04034b50 || archive.substr(offset + 30, zip_test_16(archive, offset + 26)) != name) {
+			throw runtime_error("bad local header of " + name);
+		}
+		size_t data_start = offset + 30 + zip_test_16(archive, offset + 26) + zip_test_16(archive, offset + 28);
+		string data = InflateReader(archive.substr(data_start, compressed_size)).inflate();
+		size_t descriptor = data_start + compressed_size;
+		if (data.size() != size || zip_test_crc32(data) != crc || zip_test_32(archive, descriptor) != 0x08074b50 ||
+			zip_test_32(archive, descriptor + 4) != crc || zip_test_32(archive, descriptor + 8) != compressed_size || zip_test_32(archive, descriptor + 12) != size) {
+			throw runtime_error("size or CRC of " + name + " doesn't match");
+		}
+		entries.push_back(make_pair(name, data));
+	}
+	return entries;
+}